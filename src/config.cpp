@@ -1,52 +1,188 @@
-
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
+#include "config.h"
+#include "ingress.h"
 #include "logging/logging.h"
 
 using namespace creatures;
 
 extern boolean gDisplayOn;
+extern boolean gClockSeconds;
+extern boolean gClock24Hour;
+extern int32_t gPageInterval;
+extern int32_t gIngressPolicy[INGRESS_CLASS_COUNT];
+extern int32_t gIngressDeadline[INGRESS_CLASS_COUNT];
+
+extern void apply_ingress_policies();
 
 static Logger l;
 
+// In BackpressurePolicy order
+static const char *const policyNames[BACKPRESSURE_POLICY_COUNT] = {
+    "drop_oldest",
+    "drop_newest",
+    "coalesce",
+    "block",
+};
+
+#define POLICY_FIELD(key, ingressClass) \
+    {key, config_choice, 0, BACKPRESSURE_POLICY_COUNT - 1, &gIngressPolicy[ingressClass], apply_ingress_policies, policyNames}
+#define DEADLINE_FIELD(key, ingressClass) \
+    {key, config_int, 0, 1000, &gIngressDeadline[ingressClass], apply_ingress_policies, NULL}
+
+static const ConfigField configSchema[] = {
+    {"display", config_switch, 0, 1, &gDisplayOn, NULL},
+    {"clock_seconds", config_switch, 0, 1, &gClockSeconds, NULL},
+    {"clock_24_hour", config_switch, 0, 1, &gClock24Hour, NULL},
+    {"page_interval", config_int, 0, 3600, &gPageInterval, NULL},
+
+    // How each kind of message is shed when the display falls behind
+    POLICY_FIELD("config_policy", ingress_config),
+    POLICY_FIELD("flamethrower_policy", ingress_flamethrower),
+    POLICY_FIELD("motion_policy", ingress_motion),
+    POLICY_FIELD("temperature_policy", ingress_temperature),
+    POLICY_FIELD("clock_policy", ingress_clock),
+    DEADLINE_FIELD("config_deadline", ingress_config),
+    DEADLINE_FIELD("flamethrower_deadline", ingress_flamethrower),
+    DEADLINE_FIELD("motion_deadline", ingress_motion),
+    DEADLINE_FIELD("temperature_deadline", ingress_temperature),
+    DEADLINE_FIELD("clock_deadline", ingress_clock),
+};
+
+#define CONFIG_FIELD_COUNT (int)(sizeof(configSchema) / sizeof(ConfigField))
+
+/**
+ * @brief Work out what a field's value is in the incoming config
+ *
+ * @param value where to put it
+ * @return false if it's the wrong type or out of range
+ */
+static boolean parseField(const ConfigField *field, JsonVariantConst incoming, int32_t *value)
+{
+    switch (field->type)
+    {
+    case config_switch:
+        if (incoming.is<bool>())
+        {
+            *value = incoming.as<bool>();
+            return true;
+        }
+        if (incoming.is<const char *>())
+        {
+            *value = strcmp(incoming.as<const char *>(), "on") == 0;
+            return true;
+        }
+        return false;
+
+    case config_int:
+        if (!incoming.is<long>())
+            return false;
+        *value = incoming.as<long>();
+        return *value >= field->min && *value <= field->max;
+
+    case config_choice:
+        if (!incoming.is<const char *>())
+            return false;
+        for (int32_t i = field->min; i <= field->max; i++)
+        {
+            if (strcmp(incoming.as<const char *>(), field->choices[i]) == 0)
+            {
+                *value = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    return false;
+}
+
+static int32_t currentValue(const ConfigField *field)
+{
+    if (field->type == config_switch)
+        return *(boolean *)field->target;
+    return *(int32_t *)field->target;
+}
+
+static void setValue(const ConfigField *field, int32_t value)
+{
+    if (field->type == config_switch)
+        *(boolean *)field->target = value;
+    else
+        *(int32_t *)field->target = value;
+}
+
 /**
  * @brief Update the configuration of the device from MQTT
  *
  * The config isn't persisted anywhere on the MCU. It's config it's kept in a retained MQTT topic
  * which will be read when it boots.
  *
- * @param incomingJson a String with JSON from MQTT
+ * The payload is parsed in place (ArduinoJson's zero-copy mode, so it gets
+ * modified) through a filter built from the schema, so keys we don't know
+ * about never take up room. Only the fields that actually changed are
+ * applied, which makes the retained config showing up again a no-op.
+ *
+ * @param payload the JSON from MQTT
  */
-void updateConfig(String incomingJson)
+void updateConfig(char *payload)
 {
-    l.debug("Incoming config message: %s", incomingJson.c_str());
+    l.debug("Incoming config message: %s", payload);
+
+    // Let's put these on the stack so they go poof when we leave. Keys are
+    // linked from configSchema, not copied, and the payload is deserialized
+    // in place, so each document only needs a slot per row.
+    StaticJsonDocument<JSON_OBJECT_SIZE(CONFIG_FIELD_COUNT)> filter;
+    for (int i = 0; i < CONFIG_FIELD_COUNT; i++)
+        filter[configSchema[i].key] = true;
 
-    // Let's put this on the stack so it goes poof when we leave
-    StaticJsonDocument<512> json;
+    // A row missing from the filter would never be applied
+    if (filter.overflowed())
+    {
+        l.error("the config filter is too small for %d fields, ignoring this config", CONFIG_FIELD_COUNT);
+        return;
+    }
 
-    DeserializationError error = deserializeJson(json, incomingJson);
+    StaticJsonDocument<JSON_OBJECT_SIZE(CONFIG_FIELD_COUNT)> json;
+    DeserializationError error = deserializeJson(json, payload, DeserializationOption::Filter(filter));
 
     if (error)
     {
         l.error("Unable to deserialize config from MQTT: %s", error.c_str());
+        return;
     }
-    else
+
+    l.debug("decode was good!");
+
+    JsonObjectConst config = json.as<JsonObjectConst>();
+
+    int changed = 0;
+    for (int i = 0; i < CONFIG_FIELD_COUNT; i++)
     {
-        l.debug("decode was good!");
+        const ConfigField *field = &configSchema[i];
 
-        String display = json["display"];
-        l.debug("'display' was %s", display.c_str());
+        JsonVariantConst incoming = config[field->key];
+        if (incoming.isNull())
+            continue;
 
-        if (display.equals("on"))
-        {
-            gDisplayOn = true;
-            l.info("Turned on the display");
-        }
-        else
+        int32_t value;
+        if (!parseField(field, incoming, &value))
         {
-            gDisplayOn = false;
-            l.info("Turned OFF the display");
+            l.warning("ignoring a bad value for config '%s'", field->key);
+            continue;
         }
+
+        if (value == currentValue(field))
+            continue;
+
+        setValue(field, value);
+        changed++;
+        l.info("config '%s' is now %d", field->key, value);
+
+        if (field->onChange != NULL)
+            field->onChange();
     }
-}
\ No newline at end of file
+
+    l.debug("config applied, %d fields changed", changed);
+}
@@ -1,4 +1,3 @@
-
 #pragma once
 
 #include <Arduino.h>
@@ -9,4 +8,26 @@
 
 #include "creature.h"
 
-void updateConfig(String incomingJson);
+enum ConfigType
+{
+    config_switch, // "on"/"off" or true/false, into a boolean
+    config_int,    // A number between min and max, into an int32_t
+    config_choice  // One of the names in choices, its index into an int32_t
+};
+
+/*
+    One tunable in the config topic. The table of these in config.cpp is
+    the whole schema: adding a tunable is adding a row.
+*/
+struct ConfigField
+{
+    const char *key;
+    ConfigType type;
+    int32_t min;
+    int32_t max;
+    void *target;
+    void (*onChange)(); // Optional, called after target changes
+    const char *const *choices; // For config_choice, min and max are the first and last index
+};
+
+void updateConfig(char *payload);
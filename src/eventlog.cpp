@@ -0,0 +1,60 @@
+#include <Arduino.h>
+
+#include "eventlog.h"
+
+namespace creatures
+{
+
+    EventLog::EventLog()
+    {
+        memset(events, '\0', sizeof(events));
+        head = 0;
+        size = 0;
+    }
+
+    /**
+     * @brief Add an event, forgetting the oldest one if we're full
+     *
+     * @return const LoggedEvent* the copy we kept
+     */
+    const LoggedEvent *EventLog::add(const char *timestamp, const char *text)
+    {
+        LoggedEvent *event = &events[head];
+
+        memset(event, '\0', sizeof(LoggedEvent));
+        strncpy(event->timestamp, timestamp, EVENT_TIMESTAMP_LENGTH);
+        strncpy(event->text, text, EVENT_TEXT_LENGTH);
+
+        head = (head + 1) % EVENT_LOG_LENGTH;
+        if (size < EVENT_LOG_LENGTH)
+            size++;
+
+        return event;
+    }
+
+    /**
+     * @brief Look up an event by how old it is
+     *
+     * @param age 0 is the newest
+     * @return const LoggedEvent* or NULL if we don't have one that old
+     */
+    const LoggedEvent *EventLog::recent(uint8_t age)
+    {
+        if (age >= size)
+            return NULL;
+
+        return &events[(head + EVENT_LOG_LENGTH - 1 - age) % EVENT_LOG_LENGTH];
+    }
+
+    uint8_t EventLog::count()
+    {
+        return size;
+    }
+
+    void EventLog::clear()
+    {
+        memset(events, '\0', sizeof(events));
+        head = 0;
+        size = 0;
+    }
+}
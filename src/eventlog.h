@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+// How many events we remember. Needs to be at least as many as we show.
+#define EVENT_LOG_LENGTH 16
+#define EVENT_TEXT_LENGTH 30
+#define EVENT_TIMESTAMP_LENGTH 8
+
+// One thing that happened in the house
+struct LoggedEvent
+{
+    char timestamp[EVENT_TIMESTAMP_LENGTH + 1];
+    char text[EVENT_TEXT_LENGTH + 1];
+};
+
+namespace creatures
+{
+
+    /**
+     * @brief A ring buffer of the most recent house events
+     *
+     * The screen only draws one new line per event, so this is what lets it
+     * rebuild the whole log after the screen has been wiped.
+     */
+    class EventLog
+    {
+
+    public:
+        EventLog();
+
+        const LoggedEvent *add(const char *timestamp, const char *text);
+        const LoggedEvent *recent(uint8_t age);
+        uint8_t count();
+        void clear();
+
+    private:
+        LoggedEvent events[EVENT_LOG_LENGTH];
+        uint8_t head; // Where the next event goes
+        uint8_t size;
+    };
+}
@@ -0,0 +1,13 @@
+#include <Arduino.h>
+
+#include "fonts.h"
+
+// tools/subset-fonts.py makes these before each build, with only the glyphs
+// we draw. Without it we get the whole fonts. Either way the extern above
+// is what keeps them from being private to this file.
+#ifdef SUBSET_FONTS
+#include "subset-fonts.h"
+#else
+#include <Fonts/FreeSans12pt7b.h>
+#include <Fonts/FreeSans18pt7b.h>
+#endif
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+// The fonts the dashboard draws with. They're defined once, in fonts.cpp.
+// The GFX font headers make everything const, which in C++ means every
+// file that included them got its own copy in flash.
+extern const GFXfont FreeSans12pt7b;
+extern const GFXfont FreeSans18pt7b;
@@ -0,0 +1,123 @@
+#include <Arduino.h>
+
+#include "glyphcanvas.h"
+
+namespace creatures
+{
+
+    GlyphCanvas::GlyphCanvas(uint16_t w, uint16_t h) : GFXcanvas1(w, h)
+    {
+        fastGlyphs = true;
+    }
+
+    /**
+     * @brief Turn the byte copy off, to time or check it against the stock way
+     */
+    void GlyphCanvas::setFastGlyphs(boolean enabled)
+    {
+        fastGlyphs = enabled;
+    }
+
+    /**
+     * @brief Draw a character the way GFXcanvas1 would, only faster
+     *
+     * Wrapping and the cursor work the same as Adafruit_GFX::write().
+     */
+    size_t GlyphCanvas::write(uint8_t c)
+    {
+        if (!fastGlyphs || gfxFont == NULL || textsize_x != 1 || textsize_y != 1 || rotation != 0)
+            return GFXcanvas1::write(c);
+
+        uint8_t first = pgm_read_byte(&gfxFont->first);
+        if (c < first || c > (uint8_t)pgm_read_byte(&gfxFont->last))
+            return GFXcanvas1::write(c);
+
+        GFXglyph *glyph = ((GFXglyph *)pgm_read_ptr(&gfxFont->glyph)) + (c - first);
+        uint8_t w = pgm_read_byte(&glyph->width);
+        uint8_t h = pgm_read_byte(&glyph->height);
+        if (w == 0 || h == 0)
+            return GFXcanvas1::write(c);
+
+        int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+        int16_t yo = (int8_t)pgm_read_byte(&glyph->yOffset);
+        if (wrap && cursor_x + xo + w > _width)
+        {
+            cursor_x = 0;
+            cursor_y += (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+        }
+
+        // Hanging off the left edge doesn't shift nicely, let GFX clip it
+        if (cursor_x + xo < 0)
+        {
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, 1, 1);
+        }
+        else
+        {
+            const uint8_t *bitmap = (const uint8_t *)pgm_read_ptr(&gfxFont->bitmap);
+            copyGlyph(bitmap + pgm_read_word(&glyph->bitmapOffset), cursor_x + xo, cursor_y + yo, w, h);
+        }
+
+        cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance);
+        return 1;
+    }
+
+    /**
+     * @brief OR a glyph into the buffer a byte at a time
+     *
+     * GFX fonts pack glyph rows bit after bit, so row n starts n * w bits
+     * in, and each row is (w + 7) / 8 bytes once it's lined up again.
+     */
+    void GlyphCanvas::copyGlyph(const uint8_t *bitmap, int16_t x, int16_t y, uint8_t w, uint8_t h)
+    {
+        uint8_t *buffer = getBuffer();
+        int16_t stride = (WIDTH + 7) / 8;
+        uint8_t rowBytes = (w + 7) / 8;
+        uint8_t shift = x & 7;
+        int16_t column = x >> 3;
+
+        // Pixels past the right edge are padding, and stay clear
+        uint8_t lastMask = 0xFF << ((8 - (WIDTH & 7)) & 7);
+
+        for (uint8_t row = 0; row < h; row++)
+        {
+            int16_t py = y + row;
+            if (py < 0 || py >= HEIGHT)
+                continue;
+
+            uint8_t *out = buffer + py * stride;
+            uint16_t bit = row * w;
+            for (uint8_t i = 0; i < rowBytes; i++, bit += 8)
+            {
+                // The last byte of a row has fewer than 8 of its pixels.
+                // The next byte is only read if they run into it, so this
+                // never reads past the glyph.
+                uint8_t pixels = w - i * 8 < 8 ? w - i * 8 : 8;
+                const uint8_t *from = bitmap + (bit >> 3);
+                uint8_t offset = bit & 7;
+                uint8_t bits = pgm_read_byte(from) << offset;
+                if (offset + pixels > 8)
+                    bits |= pgm_read_byte(from + 1) >> (8 - offset);
+                bits &= 0xFF << (8 - pixels);
+                if (bits == 0)
+                    continue;
+
+                // A glyph byte straddles two buffer bytes unless x is aligned
+                for (uint8_t half = 0; half < (shift ? 2 : 1); half++)
+                {
+                    int16_t b = column + i + half;
+                    if (b >= stride)
+                        break;
+
+                    uint8_t mask = half == 0 ? bits >> shift : bits << (8 - shift);
+                    if (b == stride - 1)
+                        mask &= lastMask;
+
+                    if (textcolor)
+                        out[b] |= mask;
+                    else
+                        out[b] &= ~mask;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+namespace creatures
+{
+
+    /**
+     * @brief A 1 bit canvas that draws glyphs a byte at a time
+     *
+     * The stock GFX text path sets each lit pixel of a glyph with its own
+     * drawPixel() call. Here each row of the glyph is lined up into bytes
+     * and ORed straight into the buffer instead, shifted to wherever the
+     * cursor is. Text that's scaled or rotated goes the stock way.
+     */
+    class GlyphCanvas : public GFXcanvas1
+    {
+
+    public:
+        GlyphCanvas(uint16_t w, uint16_t h);
+
+        size_t write(uint8_t c) override;
+        void setFastGlyphs(boolean enabled);
+
+    private:
+        void copyGlyph(const uint8_t *bitmap, int16_t x, int16_t y, uint8_t w, uint8_t h);
+
+        boolean fastGlyphs;
+    };
+}
@@ -0,0 +1,299 @@
+#include <Arduino.h>
+
+#include "history.h"
+
+namespace creatures
+{
+
+    static Logger l = Logger();
+
+    // Fixed-point scale for each series. Temperatures and wind keep a tenth,
+    // power is already in whole watts.
+    static const float seriesScale[HISTORY_SERIES_COUNT] = {
+        10.0f, // outside_temperature_series
+        10.0f, // outside_wind_speed_series
+        1.0f,  // home_power_use_series
+        10.0f, // half_bathroom_temperature_series
+        10.0f, // bunnys_room_temperature_series
+        10.0f, // office_temperature_series
+        10.0f, // family_room_temperature_series
+        10.0f, // workshop_temperature_series
+        10.0f, // guest_room_temperature_series
+        10.0f, // kitchen_temperature_series
+    };
+
+    static int16_t encode(HistorySeries series, float value)
+    {
+        float scaled = roundf(value * seriesScale[series]);
+        if (scaled > INT16_MAX)
+            return INT16_MAX;
+        if (scaled < INT16_MIN)
+            return INT16_MIN;
+        return (int16_t)scaled;
+    }
+
+    static float decode(HistorySeries series, int32_t value)
+    {
+        return (float)value / seriesScale[series];
+    }
+
+    SensorHistory::SensorHistory()
+    {
+        series = NULL;
+        lock = NULL;
+    }
+
+    boolean SensorHistory::init()
+    {
+        // Big enough that it belongs in PSRAM, not the internal heap
+        series = (Series *)ps_calloc(HISTORY_SERIES_COUNT, sizeof(Series));
+        if (series == NULL)
+        {
+            l.error("unable to allocate %d bytes for the sensor history", footprint());
+            return false;
+        }
+
+        lock = xSemaphoreCreateMutex();
+
+        l.info("sensor history ready: %d series, %d samples each, %d bytes",
+               HISTORY_SERIES_COUNT, HISTORY_SAMPLES, footprint());
+        return true;
+    }
+
+    size_t SensorHistory::footprint()
+    {
+        return HISTORY_SERIES_COUNT * sizeof(Series);
+    }
+
+    /**
+     * @brief Remember the latest value for a series
+     *
+     * Nothing is added to the history until the next call to commitSample()
+     */
+    void SensorHistory::record(HistorySeries series, float value)
+    {
+        if (this->series == NULL)
+            return;
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        Series *s = &this->series[series];
+        s->pending = encode(series, value);
+        s->havePending = true;
+        xSemaphoreGive(lock);
+    }
+
+    /**
+     * @brief Commit the latest value of every series to the history
+     *
+     * Called once per HISTORY_SAMPLE_INTERVAL_MS. Series we haven't heard
+     * from yet are skipped, the rest hold their last value.
+     */
+    void SensorHistory::commitSample()
+    {
+        if (series == NULL)
+            return;
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        for (int i = 0; i < HISTORY_SERIES_COUNT; i++)
+        {
+            if (series[i].havePending)
+                push(&series[i], series[i].pending);
+        }
+        xSemaphoreGive(lock);
+    }
+
+    void SensorHistory::push(Series *s, int16_t value)
+    {
+        uint8_t at = s->sequence % HISTORY_BLOCK_SAMPLES;
+        if (at == 0)
+        {
+            s->openSum = 0;
+            s->openMin = value;
+            s->openMax = value;
+        }
+
+        s->open[at] = value;
+        s->openSum += value;
+        if (value < s->openMin)
+            s->openMin = value;
+        if (value > s->openMax)
+            s->openMax = value;
+
+        s->sequence++;
+        if (at == HISTORY_BLOCK_SAMPLES - 1)
+            closeBlock(s);
+    }
+
+    /**
+     * @brief Pack the hour that just finished into the ring
+     *
+     * The oldest hour makes room for it once the ring is full. Each delta
+     * is taken from where the one before it decoded to, not from what was
+     * recorded, so rounding never adds up: every sample decodes to within
+     * half a step of what it was. The smallest step that fits is used,
+     * which for a normal hour is exact.
+     */
+    void SensorHistory::closeBlock(Series *s)
+    {
+        if (s->blockCount == HISTORY_BLOCKS)
+        {
+            s->oldestBlock = (s->oldestBlock + 1) % HISTORY_BLOCKS;
+            s->blockCount--;
+        }
+
+        Block *block = &s->blocks[(s->oldestBlock + s->blockCount) % HISTORY_BLOCKS];
+        s->blockCount++;
+
+        block->sum = s->openSum;
+        block->first = s->open[0];
+        block->min = s->openMin;
+        block->max = s->openMax;
+
+        for (uint8_t shift = 0; shift < 16; shift++)
+        {
+            int32_t step = 1 << shift;
+            int32_t previous = s->open[0];
+            boolean fits = true;
+
+            for (uint8_t i = 1; i < HISTORY_BLOCK_SAMPLES && fits; i++)
+            {
+                int32_t change = s->open[i] - previous;
+                int32_t delta = change >= 0 ? (change + step / 2) / step : -((-change + step / 2) / step);
+                fits = delta >= INT8_MIN && delta <= INT8_MAX;
+
+                block->deltas[i - 1] = delta;
+                previous += delta * step;
+            }
+
+            if (fits)
+            {
+                block->shift = shift;
+                return;
+            }
+        }
+    }
+
+    void SensorHistory::decodeBlock(const Block *block, int16_t *samples)
+    {
+        int32_t value = block->first;
+        int32_t step = 1 << block->shift;
+
+        samples[0] = block->first;
+        for (uint8_t i = 1; i < HISTORY_BLOCK_SAMPLES; i++)
+        {
+            value += block->deltas[i - 1] * step;
+            samples[i] = value > INT16_MAX ? INT16_MAX : value < INT16_MIN ? INT16_MIN : value;
+        }
+    }
+
+    boolean SensorHistory::latest(HistorySeries series, float *value)
+    {
+        if (this->series == NULL)
+            return false;
+
+        boolean found = false;
+        xSemaphoreTake(lock, portMAX_DELAY);
+        Series *s = &this->series[series];
+        if (s->havePending)
+        {
+            *value = decode(series, s->pending);
+            found = true;
+        }
+        xSemaphoreGive(lock);
+        return found;
+    }
+
+    /**
+     * @brief The min, max, and mean over the window
+     *
+     * From each hour's own aggregates, so it costs the same however full
+     * the history is.
+     */
+    HistoryStats SensorHistory::stats(HistorySeries series)
+    {
+        HistoryStats stats = {0, 0.0f, 0.0f, 0.0f};
+        if (this->series == NULL)
+            return stats;
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        Series *s = &this->series[series];
+
+        uint8_t openCount = s->sequence % HISTORY_BLOCK_SAMPLES;
+        int16_t low = s->openMin;
+        int16_t high = s->openMax;
+        int32_t sum = openCount > 0 ? s->openSum : 0;
+        if (openCount == 0 && s->blockCount > 0)
+        {
+            low = s->blocks[s->oldestBlock].min;
+            high = s->blocks[s->oldestBlock].max;
+        }
+
+        for (uint8_t i = 0; i < s->blockCount; i++)
+        {
+            const Block *block = &s->blocks[(s->oldestBlock + i) % HISTORY_BLOCKS];
+            if (block->min < low)
+                low = block->min;
+            if (block->max > high)
+                high = block->max;
+            sum += block->sum;
+        }
+
+        stats.count = s->blockCount * HISTORY_BLOCK_SAMPLES + openCount;
+        if (stats.count > 0)
+        {
+            stats.min = decode(series, low);
+            stats.max = decode(series, high);
+            stats.mean = decode(series, sum) / stats.count;
+        }
+        xSemaphoreGive(lock);
+        return stats;
+    }
+
+    /**
+     * @brief Copy out the most recent samples, oldest first
+     *
+     * Samples from a finished hour come back within half a step of what was
+     * recorded (see closeBlock()), which is exact unless that hour moved
+     * more than a byte's worth in a minute.
+     *
+     * @param values where to put them
+     * @param maxValues how many we want at most
+     * @return uint16_t how many were copied
+     */
+    uint16_t SensorHistory::copyRecent(HistorySeries series, float *values, uint16_t maxValues)
+    {
+        if (this->series == NULL)
+            return 0;
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        Series *s = &this->series[series];
+
+        uint8_t openCount = s->sequence % HISTORY_BLOCK_SAMPLES;
+        uint16_t available = s->blockCount * HISTORY_BLOCK_SAMPLES + openCount;
+        uint16_t count = available < maxValues ? available : maxValues;
+        uint16_t skip = available - count;
+        uint16_t copied = 0;
+
+        int16_t hour[HISTORY_BLOCK_SAMPLES];
+        for (uint8_t i = 0; i < s->blockCount; i++)
+        {
+            // Hours that are entirely too old aren't worth decoding
+            if (skip >= HISTORY_BLOCK_SAMPLES)
+            {
+                skip -= HISTORY_BLOCK_SAMPLES;
+                continue;
+            }
+
+            decodeBlock(&s->blocks[(s->oldestBlock + i) % HISTORY_BLOCKS], hour);
+            for (uint8_t j = skip; j < HISTORY_BLOCK_SAMPLES; j++)
+                values[copied++] = decode(series, hour[j]);
+            skip = 0;
+        }
+
+        for (uint8_t j = skip; j < openCount; j++)
+            values[copied++] = decode(series, s->open[j]);
+
+        xSemaphoreGive(lock);
+        return copied;
+    }
+}
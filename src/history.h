@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Arduino.h>
+
+extern "C"
+{
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+}
+
+#include "logging/logging.h"
+
+// 24 hours of history at one minute resolution, kept an hour at a time
+#define HISTORY_BLOCK_SAMPLES 60
+#define HISTORY_BLOCKS 24
+#define HISTORY_SAMPLES (HISTORY_BLOCKS * HISTORY_BLOCK_SAMPLES)
+#define HISTORY_SAMPLE_INTERVAL_MS 60000
+
+/*
+    Every series we keep history for. Values are fixed-point with a
+    per-series scale (see history.cpp). Each finished hour is stored as
+    its first sample and a byte for each change after that, along with its
+    own min, max and sum, about 1.2 bytes a sample. The hour in progress is
+    kept as it came in until it's done. That's 1,868 bytes a series, under
+    19 KB of PSRAM for all of these and 28 KB for 15.
+*/
+enum HistorySeries
+{
+    outside_temperature_series,
+    outside_wind_speed_series,
+    home_power_use_series,
+    half_bathroom_temperature_series,
+    bunnys_room_temperature_series,
+    office_temperature_series,
+    family_room_temperature_series,
+    workshop_temperature_series,
+    guest_room_temperature_series,
+    kitchen_temperature_series,
+
+    HISTORY_SERIES_COUNT
+};
+
+// Aggregates over the samples in the window: the hour in progress and the
+// HISTORY_BLOCKS whole hours before it
+struct HistoryStats
+{
+    uint16_t count;
+    float min;
+    float max;
+    float mean;
+};
+
+namespace creatures
+{
+
+    /**
+     * @brief A fixed-footprint ring buffer of sensor samples in PSRAM
+     *
+     * The latest value of each series is held until the next sample tick, at
+     * which point it's committed to the ring (sample-and-hold). Each hour
+     * keeps its own min, max and sum, so asking for a daily high/low or the
+     * mean is a look at 25 hours, never a rescan of the samples.
+     */
+    class SensorHistory
+    {
+
+    public:
+        SensorHistory();
+        boolean init();
+
+        void record(HistorySeries series, float value);
+        void commitSample();
+
+        boolean latest(HistorySeries series, float *value);
+        HistoryStats stats(HistorySeries series);
+        uint16_t copyRecent(HistorySeries series, float *values, uint16_t maxValues);
+
+        size_t footprint();
+
+    private:
+        // A finished hour. Each sample is the one before it plus a delta
+        // times 2^shift; shift is only more than 0 for an hour that moved
+        // too fast for a byte a minute.
+        struct Block
+        {
+            int32_t sum;
+            int16_t first;
+            int16_t min;
+            int16_t max;
+            uint8_t shift;
+            int8_t deltas[HISTORY_BLOCK_SAMPLES - 1];
+        };
+
+        struct Series
+        {
+            Block blocks[HISTORY_BLOCKS];
+            int16_t open[HISTORY_BLOCK_SAMPLES]; // The hour in progress
+            uint32_t sequence;                   // Total samples ever committed
+            int32_t openSum;
+            int16_t openMin;
+            int16_t openMax;
+            uint8_t oldestBlock;
+            uint8_t blockCount;
+            int16_t pending; // Latest value, waiting for the next tick
+            boolean havePending;
+        };
+
+        void push(Series *s, int16_t value);
+        void closeBlock(Series *s);
+        void decodeBlock(const Block *block, int16_t *samples);
+
+        Series *series;
+        SemaphoreHandle_t lock;
+    };
+}
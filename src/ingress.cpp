@@ -0,0 +1,311 @@
+#include <Arduino.h>
+
+#include "ingress.h"
+
+namespace creatures
+{
+
+    static Logger l = Logger();
+
+    static const char *classNames[INGRESS_CLASS_COUNT] = {
+        "config",
+        "flamethrower",
+        "motion",
+        "temperature",
+        "clock",
+    };
+
+    // Blocked senders check for room this often, so more than one can wait
+    #define INGRESS_BLOCK_POLL_MS 10
+
+    IngressQueue::IngressQueue()
+    {
+        slots = NULL;
+        items = NULL;
+        length = 0;
+        count = 0;
+        highWater = 0;
+        itemSize = 0;
+
+        for (uint8_t i = 0; i < INGRESS_CLASS_COUNT; i++)
+        {
+            policies[i] = policy_drop_newest;
+            deadlines[i] = 0;
+        }
+        memset(stats, '\0', sizeof(stats));
+
+        lock = NULL;
+        itemAdded = NULL;
+        itemRemoved = NULL;
+    }
+
+    boolean IngressQueue::init(uint8_t length, size_t itemSize)
+    {
+        this->length = length;
+        this->itemSize = itemSize;
+
+        slots = (Slot *)calloc(length, sizeof(Slot));
+        items = (uint8_t *)calloc(length, itemSize);
+        lock = xSemaphoreCreateMutex();
+        itemAdded = xSemaphoreCreateBinary();
+        itemRemoved = xSemaphoreCreateBinary();
+
+        if (slots == NULL || items == NULL || lock == NULL || itemAdded == NULL || itemRemoved == NULL)
+        {
+            l.error("unable to make an ingress queue of %d items", length);
+            return false;
+        }
+
+        l.debug("ingress queue made, %d items of %d bytes", length, itemSize);
+        return true;
+    }
+
+    /**
+     * @brief Set how a class of message is handled under pressure
+     *
+     * @param deadlineMs how long policy_block waits for room
+     */
+    void IngressQueue::setPolicy(IngressClass ingressClass, BackpressurePolicy policy, uint32_t deadlineMs)
+    {
+        if (lock != NULL)
+            xSemaphoreTake(lock, portMAX_DELAY);
+
+        policies[ingressClass] = policy;
+        deadlines[ingressClass] = deadlineMs;
+
+        if (lock != NULL)
+            xSemaphoreGive(lock);
+
+        l.debug("ingress policy for %s is now %d, deadline %lums", classNames[ingressClass], policy, deadlineMs);
+    }
+
+    /**
+     * @brief Send a message, applying its class's policy if we're full
+     *
+     * Safe to call from any task, but not from an ISR.
+     *
+     * @param key what makes two messages of a class the same thing, for
+     *  policy_coalesce
+     * @param mayWait false if the caller mustn't block, like a timer
+     *  callback. policy_block then drops the message straight away.
+     * @return false if the message was dropped
+     */
+    boolean IngressQueue::send(IngressClass ingressClass, uint32_t key, const void *item, boolean mayWait)
+    {
+        IngressStats *s = &stats[ingressClass];
+        unsigned long started = micros();
+        boolean stalled = false;
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+
+        uint32_t droppedBefore = s->dropped;
+        BackpressurePolicy policy = policies[ingressClass];
+        if (policy == policy_coalesce)
+        {
+            int index = findKey(ingressClass, key);
+            if (index >= 0)
+            {
+                // Keep its place in line, it's just newer now
+                memcpy(items + index * itemSize, item, itemSize);
+                s->coalesced++;
+                xSemaphoreGive(lock);
+                return true;
+            }
+        }
+
+        boolean accepted = true;
+        while (count >= length)
+        {
+            if (policy == policy_drop_oldest)
+            {
+                int index = findClass(ingressClass);
+                if (index >= 0)
+                {
+                    removeAt(index);
+                    s->dropped++;
+                    break;
+                }
+            }
+
+            if (policy == policy_block && mayWait)
+            {
+                unsigned long waited = (micros() - started) / 1000;
+                if (waited < deadlines[ingressClass])
+                {
+                    stalled = true;
+                    uint32_t remaining = deadlines[ingressClass] - waited;
+
+                    xSemaphoreGive(lock);
+                    xSemaphoreTake(itemRemoved, pdMS_TO_TICKS(min(remaining, (uint32_t)INGRESS_BLOCK_POLL_MS)));
+                    xSemaphoreTake(lock, portMAX_DELAY);
+                    continue;
+                }
+            }
+
+            // Nothing of ours to make room with, or out of time
+            s->dropped++;
+            accepted = false;
+            break;
+        }
+
+        if (accepted)
+        {
+            append(ingressClass, key, item);
+            s->accepted++;
+        }
+
+        if (stalled)
+        {
+            unsigned long stall = micros() - started;
+            s->stalls++;
+            s->stallMicros += stall;
+            if (stall > s->worstStallMicros)
+                s->worstStallMicros = stall;
+        }
+
+        uint32_t dropped = s->dropped;
+        boolean droppedOne = dropped != droppedBefore;
+        xSemaphoreGive(lock);
+
+        if (accepted)
+            xSemaphoreGive(itemAdded);
+
+        // Don't make things worse by logging every single one
+        if (droppedOne && (dropped == 1 || dropped % 100 == 0))
+            l.warning("dropped %lu %s messages so far", dropped, classNames[ingressClass]);
+
+        return accepted;
+    }
+
+    /**
+     * @brief Take the oldest message
+     *
+     * @return false if nothing showed up before wait was up
+     */
+    boolean IngressQueue::receive(void *item, TickType_t wait)
+    {
+        TickType_t started = xTaskGetTickCount();
+
+        for (;;)
+        {
+            xSemaphoreTake(lock, portMAX_DELAY);
+            if (count > 0)
+            {
+                IngressStats *s = &stats[slots[0].ingressClass];
+                unsigned long latency = micros() - slots[0].sentAt;
+                if (latency > s->worstLatencyMicros)
+                    s->worstLatencyMicros = latency;
+
+                memcpy(item, items, itemSize);
+                removeAt(0);
+
+                xSemaphoreGive(lock);
+                xSemaphoreGive(itemRemoved);
+                return true;
+            }
+            xSemaphoreGive(lock);
+
+            TickType_t elapsed = xTaskGetTickCount() - started;
+            if (elapsed >= wait || xSemaphoreTake(itemAdded, wait - elapsed) != pdTRUE)
+                return false;
+        }
+    }
+
+    uint8_t IngressQueue::waiting()
+    {
+        return count;
+    }
+
+    uint8_t IngressQueue::peak()
+    {
+        return highWater;
+    }
+
+    /**
+     * @brief Given every time something is sent
+     *
+     * For waiting on this queue along with others in a FreeRTOS queue set.
+     * Take it once the set hands it back, then receive() with no wait.
+     */
+    SemaphoreHandle_t IngressQueue::arrivals()
+    {
+        return itemAdded;
+    }
+
+    const IngressStats *IngressQueue::statsFor(IngressClass ingressClass)
+    {
+        return &stats[ingressClass];
+    }
+
+    /**
+     * @brief Write a one line summary of what each class has been through,
+     *  and how full the queue has been
+     *
+     * @return int what snprintf() says
+     */
+    int IngressQueue::describeStats(char *buffer, size_t size)
+    {
+        int used = 0;
+        buffer[0] = '\0';
+
+        for (uint8_t i = 0; i < INGRESS_CLASS_COUNT && used < (int)size; i++)
+        {
+            IngressStats *s = &stats[i];
+            used += snprintf(buffer + used,
+                             size - used,
+                             "%s%s ok %lu drop %lu merge %lu stall %lums latency %luus",
+                             used > 0 ? ", " : "",
+                             classNames[i],
+                             (unsigned long)s->accepted,
+                             (unsigned long)s->dropped,
+                             (unsigned long)s->coalesced,
+                             (unsigned long)(s->stallMicros / 1000),
+                             s->worstLatencyMicros);
+        }
+
+        if (used < (int)size)
+            used += snprintf(buffer + used, size - used, ", queue peak %d of %d", highWater, length);
+
+        return used;
+    }
+
+    void IngressQueue::append(IngressClass ingressClass, uint32_t key, const void *item)
+    {
+        slots[count].ingressClass = ingressClass;
+        slots[count].key = key;
+        slots[count].sentAt = micros();
+        memcpy(items + count * itemSize, item, itemSize);
+        count++;
+        if (count > highWater)
+            highWater = count;
+    }
+
+    // The queue is tiny, so closing the gap is cheaper than a ring
+    void IngressQueue::removeAt(uint8_t index)
+    {
+        uint8_t after = count - index - 1;
+        memmove(&slots[index], &slots[index + 1], after * sizeof(Slot));
+        memmove(items + index * itemSize, items + (index + 1) * itemSize, after * itemSize);
+        count--;
+    }
+
+    int IngressQueue::findClass(IngressClass ingressClass)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (slots[i].ingressClass == ingressClass)
+                return i;
+        }
+        return -1;
+    }
+
+    int IngressQueue::findKey(IngressClass ingressClass, uint32_t key)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (slots[i].ingressClass == ingressClass && slots[i].key == key)
+                return i;
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Arduino.h>
+
+extern "C"
+{
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+}
+
+#include "logging/logging.h"
+
+// The kinds of traffic headed for the display. Each one gets its own
+// backpressure policy and its own counters.
+enum IngressClass
+{
+    ingress_config, // Page flips and redraws asked for by config or cmd
+    ingress_flamethrower,
+    ingress_motion,
+    ingress_temperature,
+    ingress_clock,
+
+    INGRESS_CLASS_COUNT
+};
+
+// What to do with a message when the queue is full
+enum BackpressurePolicy
+{
+    policy_drop_oldest, // Make room by dropping the oldest message of the same class
+    policy_drop_newest, // Drop the message that's being sent
+    policy_coalesce,    // Replace a waiting message with the same key, even if there's room
+    policy_block,       // Wait for room, up to the class's deadline, then drop it (at once if the sender can't wait)
+
+    BACKPRESSURE_POLICY_COUNT
+};
+
+// What the load test holds the display to, on the device (src/loadtest.cpp)
+// and on the host (test/ingress-load-test.cpp): no clock tick or config
+// message dropped, and nothing waiting longer than this to be drawn. The
+// host test holds INGRESS_LOAD_HEADROOM times the device's rate to it too.
+#define INGRESS_LOAD_LATENCY_US 250000
+#define INGRESS_LOAD_HEADROOM 3
+
+struct IngressStats
+{
+    uint32_t accepted;
+    uint32_t dropped;
+    uint32_t coalesced;
+    uint32_t stalls;
+    uint64_t stallMicros;
+    unsigned long worstStallMicros;
+    unsigned long worstLatencyMicros; // From being sent to being taken
+};
+
+namespace creatures
+{
+
+    /**
+     * @brief A FreeRTOS-style queue that sheds load on purpose
+     *
+     * A plain queue can only drop whatever's being sent once it's full, and
+     * doesn't say so unless the sender checks. This one knows what class
+     * each message is, applies that class's policy when there's pressure,
+     * and counts everything it drops and every tick a sender spends waiting.
+     */
+    class IngressQueue
+    {
+
+    public:
+        IngressQueue();
+
+        boolean init(uint8_t length, size_t itemSize);
+        void setPolicy(IngressClass ingressClass, BackpressurePolicy policy, uint32_t deadlineMs);
+
+        boolean send(IngressClass ingressClass, uint32_t key, const void *item, boolean mayWait = true);
+        boolean receive(void *item, TickType_t wait);
+
+        uint8_t waiting();
+        uint8_t peak();
+        SemaphoreHandle_t arrivals();
+        const IngressStats *statsFor(IngressClass ingressClass);
+        int describeStats(char *buffer, size_t size);
+
+    private:
+        struct Slot
+        {
+            IngressClass ingressClass;
+            uint32_t key;
+            unsigned long sentAt;
+        };
+
+        void append(IngressClass ingressClass, uint32_t key, const void *item);
+        void removeAt(uint8_t index);
+        int findClass(IngressClass ingressClass);
+        int findKey(IngressClass ingressClass, uint32_t key);
+
+        // Oldest first
+        Slot *slots;
+        uint8_t *items;
+        uint8_t length;
+        uint8_t count;
+        uint8_t highWater; // Most that have ever been waiting
+        size_t itemSize;
+
+        BackpressurePolicy policies[INGRESS_CLASS_COUNT];
+        uint32_t deadlines[INGRESS_CLASS_COUNT];
+        IngressStats stats[INGRESS_CLASS_COUNT];
+
+        SemaphoreHandle_t lock;
+        SemaphoreHandle_t itemAdded;
+        SemaphoreHandle_t itemRemoved;
+    };
+}
@@ -0,0 +1,161 @@
+#ifdef INGRESS_LOAD_TEST
+
+#include <Arduino.h>
+
+extern "C"
+{
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+}
+
+#include "main.h"
+
+#include "logging/logging.h"
+#include "mqtt/mqtt.h"
+#include "home/data-feed.h"
+
+/*
+    Synthetic load for the display queue
+
+    Build with INGRESS_LOAD_TEST to have a task push made up messages into
+    MQTT's incoming queue, so they take the same path real ones do. The
+    default rate is about ten times what the house sends on a busy evening.
+    Every LOAD_REPORT_MS the drops, stalls and latencies for each class get
+    logged, along with the display queue's peak and what MQTT's own queue
+    turned away, and then whether the run is inside the limits in
+    ingress.h: MQTT's queue never full, no clock tick or config message
+    dropped, and nothing waiting in the display queue longer than
+    INGRESS_LOAD_LATENCY_US. Once it fails it stays failed.
+
+    test/ingress-load-test runs the same mix on the host against the
+    stand-in panel. There the display keeps up to about 75 messages a
+    second and everything is on the screen within 35ms at 60 a second.
+    At 200 a second the display queue never gets past 5 deep, because
+    the reader only posts a batch per pass. The backlog builds in MQTT's
+    queue instead, while the clock, which doesn't come through MQTT, is
+    still drawn within 70ms.
+*/
+
+#ifndef INGRESS_LOAD_RATE
+#define INGRESS_LOAD_RATE 20 // Messages per second
+#endif
+
+#define LOAD_REPORT_MS 10000
+
+using namespace creatures;
+
+extern MQTT *mqtt;
+extern IngressQueue displayQueue;
+extern UBaseType_t gIncomingHighWater;
+
+static Logger l;
+
+// Why the run is outside the limits, or NULL if it isn't
+static const char *overLimit(uint32_t refused)
+{
+    if (refused > 0)
+        return "MQTT's queue was full";
+    if (displayQueue.statsFor(ingress_clock)->dropped > 0)
+        return "clock ticks were dropped";
+    if (displayQueue.statsFor(ingress_config)->dropped > 0)
+        return "config messages were dropped";
+    for (int i = 0; i < INGRESS_CLASS_COUNT; i++)
+    {
+        if (displayQueue.statsFor((IngressClass)i)->worstLatencyMicros > INGRESS_LOAD_LATENCY_US)
+            return "a message waited too long to be drawn";
+    }
+    return NULL;
+}
+
+struct LoadMessage
+{
+    const char *topic;
+    const char *payload;
+};
+
+// A bit of everything, roughly in the mix the house sends
+static const LoadMessage loadMessages[] = {
+    {OUTSIDE_TEMPERATURE_TOPIC, "54.3"},
+    {HOME_POWER_USE_WATTS, "1432"},
+    {OFFICE_MOTION_TOPIC, MQTT_ON},
+    {KITCHEN_TEMPERATURE_TOPIC, "70.1"},
+    {HOME_POWER_USE_WATTS, "1520"},
+    {OUTSIDE_WIND_SPEED_TOPIC, "12.0"},
+    {OFFICE_MOTION_TOPIC, MQTT_OFF},
+    {FAMILY_ROOM_TEMPERATURE_TOPIC, "68.4"},
+    {HOME_POWER_USE_WATTS, "1498"},
+    {OFFICE_FLAMETHROWER_TOPIC, "true"},
+    {WORKSHOP_MOTION_TOPIC, MQTT_ON},
+    {BUNNYS_ROOM_TEMPERATURE_TOPIC, "66.9"},
+    {OFFICE_FLAMETHROWER_TOPIC, "false"},
+    {WORKSHOP_MOTION_TOPIC, MQTT_OFF},
+};
+
+#define LOAD_MESSAGE_COUNT (sizeof(loadMessages) / sizeof(LoadMessage))
+
+portTASK_FUNCTION(ingressLoadTask, pvParameters)
+{
+    QueueHandle_t incomingQueue = mqtt->getIncomingMessageQueue();
+    const TickType_t interval = max((TickType_t)1, (TickType_t)pdMS_TO_TICKS(1000 / INGRESS_LOAD_RATE));
+
+    uint32_t sent = 0;
+    uint32_t refused = 0;
+    const char *failure = NULL;
+    unsigned long lastReport = millis();
+    TickType_t lastWake = xTaskGetTickCount();
+
+    l.info("load test: sending %d messages a second", INGRESS_LOAD_RATE);
+
+    for (;;)
+    {
+        const LoadMessage *load = &loadMessages[sent % LOAD_MESSAGE_COUNT];
+
+        struct MqttMessage message;
+        memset(&message, '\0', sizeof(message));
+        strncpy(message.topic, load->topic, sizeof(message.topic) - 1);
+        strncpy(message.topicGlobalNamespace, load->topic, sizeof(message.topicGlobalNamespace) - 1);
+        strncpy(message.payload, load->payload, sizeof(message.payload) - 1);
+
+        if (xQueueSendToBack(incomingQueue, &message, 0) != pdPASS)
+            refused++;
+        sent++;
+
+        if (millis() - lastReport >= LOAD_REPORT_MS)
+        {
+            char stats[448];
+            displayQueue.describeStats(stats, sizeof(stats));
+
+            l.info("load test: %lu sent, %lu refused by MQTT's queue, its peak was %d",
+                   sent,
+                   refused,
+                   gIncomingHighWater);
+            l.info("load test: %s", stats);
+            l.info("load test: the clock is %luus behind at worst",
+                   displayQueue.statsFor(ingress_clock)->worstLatencyMicros);
+
+            if (failure == NULL)
+                failure = overLimit(refused);
+            if (failure == NULL)
+                l.info("load test: PASS so far at %d a second", INGRESS_LOAD_RATE);
+            else
+                l.error("load test: FAIL at %d a second, %s", INGRESS_LOAD_RATE, failure);
+
+            lastReport = millis();
+        }
+
+        vTaskDelayUntil(&lastWake, interval);
+    }
+}
+
+void start_ingress_load_test()
+{
+    TaskHandle_t loadTaskHandle;
+    xTaskCreate(ingressLoadTask,
+                "ingressLoadTask",
+                4096,
+                NULL,
+                1,
+                &loadTaskHandle);
+}
+
+#endif
@@ -27,19 +27,67 @@ extern "C"
 #include "mdns/magicbroker.h"
 #include "home/data-feed.h"
 
+#include "history.h"
+#include "snapshot.h"
 #include "ota.h"
+#include "mirror.h"
 #include "screen.h"
+#include "stages.h"
 
 using namespace creatures;
 
 TimerHandle_t mqttReconnectTimer;
 TimerHandle_t wifiReconnectTimer;
+TimerHandle_t historyTimer;
 
-// Queue for updates to the display
-QueueHandle_t displayQueue;
+#ifdef PANEL_POWER_TEST
+#ifndef PANEL_POWER_TEST_MS
+#define PANEL_POWER_TEST_MS 60000
+#endif
+TimerHandle_t powerTestTimer;
+#endif
+
+// Queue for updates to the display. Each class of message sheds load its
+// own way when it fills up.
+IngressQueue displayQueue;
+
+UBaseType_t gIncomingHighWater = 0; // Most messages MQTT has had waiting for us
 
-TaskHandle_t displayUpdateTaskHandler;
-TaskHandle_t localTimeTaskHandler;
+// The reader, clock and display all run as stages on one task. This is
+// what each one keeps between resumes, since they don't have stacks of
+// their own to keep it on.
+struct ReaderState
+{
+    QueueHandle_t incomingQueue;
+    UBaseType_t waiting;
+    uint8_t taken;
+
+    // What pipelineTask has taken off MQTT for the reader. It's only ever
+    // received from when the queue set hands the queue back.
+    struct MqttMessage inbox[PIPELINE_READER_BATCH];
+    uint8_t inboxHead;
+    uint8_t inboxCount;
+};
+
+struct DisplayState
+{
+    struct DisplayMessage message;
+    unsigned long lastPageFlip;
+    uint8_t drawn;
+};
+
+static uint32_t stageMicros();
+
+StageExecutor pipeline(stageMicros);
+static Stage readerStage;
+static Stage clockStage;
+static Stage displayStage;
+static ReaderState readerState;
+static DisplayState displayState;
+
+// Given whenever MQTT or the display queue has something for the stages
+QueueSetHandle_t pipelineWakeups;
+TaskHandle_t pipelineTaskHandle;
 
 uint8_t startup_counter = 0;
 
@@ -56,11 +104,29 @@ uint8_t startup_counter = 0;
 
 */
 boolean gDisplayOn = true;
+boolean gClockSeconds = true;
+boolean gClock24Hour = false;
+int32_t gPageInterval = 0; // Seconds between page flips, 0 to stay put
+
+// What each IngressClass does when the display can't keep up, and how long
+// policy_block waits
+int32_t gIngressPolicy[INGRESS_CLASS_COUNT] = {
+    policy_coalesce,    // config, a newer page flip replaces an older one
+    policy_coalesce,    // flamethrower, there's only one line for it
+    policy_drop_oldest, // motion, the newest events are the ones on screen
+    policy_coalesce,    // temperature, one per sensor is plenty
+    policy_coalesce,    // clock, only the latest time matters
+};
+int32_t gIngressDeadline[INGRESS_CLASS_COUNT] = {100, 100, 100, 100, 100};
 
 // Keep a link to our logger
 static Logger l;
 
 TouchDisplay display;
+SensorHistory history;
+
+// Names for the pages, for the cmd topic and status messages
+const char *pageNames[PAGE_COUNT] = {"overview", "rooms", "power"};
 
 CreatureMDNS* creatureMDNS;
 Time* creatureTime;
@@ -92,8 +158,28 @@ void setup()
             ;
     }
 
+    // Where we keep trends for the sensors we watch
+    display.showSystemMessage("Making history");
+    history.init();
+    historyTimer = xTimerCreate("historyTimer",
+                                pdMS_TO_TICKS(HISTORY_SAMPLE_INTERVAL_MS),
+                                pdTRUE,
+                                (void *)0,
+                                reinterpret_cast<TimerCallbackFunction_t>(commitHistory));
+    xTimerStart(historyTimer, 0);
+
+#ifdef PANEL_POWER_TEST
+    powerTestTimer = xTimerCreate("powerTestTimer",
+                                  pdMS_TO_TICKS(PANEL_POWER_TEST_MS),
+                                  pdTRUE,
+                                  (void *)0,
+                                  reinterpret_cast<TimerCallbackFunction_t>(togglePanelForPowerTest));
+    xTimerStart(powerTestTimer, 0);
+#endif
+
     // Create the message queue
-    displayQueue = xQueueCreate(DISPLAY_QUEUE_LENGTH, sizeof(struct DisplayMessage));
+    displayQueue.init(DISPLAY_QUEUE_LENGTH, sizeof(struct DisplayMessage));
+    apply_ingress_policies();
     l.debug("displayQueue made");
 
     // Register ourselves in mDNS
@@ -116,6 +202,20 @@ void setup()
     // Connect to MQTT
     display.showSystemMessage("Starting MQTT");
     mqtt = new MQTT(String(CREATURE_NAME));
+
+    // Members have to be empty when they join a set, so this happens before
+    // anything can arrive. There's room for everything MQTT can hold and the
+    // display queue's signal.
+    QueueHandle_t incomingQueue = mqtt->getIncomingMessageQueue();
+    pipelineWakeups = xQueueCreateSet(uxQueueSpacesAvailable(incomingQueue) + 1);
+    if (xQueueAddToSet(incomingQueue, pipelineWakeups) != pdPASS ||
+        xQueueAddToSet(displayQueue.arrivals(), pipelineWakeups) != pdPASS)
+    {
+        display.showError("Unable to watch\nthe message queues");
+        while (1)
+            ;
+    }
+
     mqtt->connect(magicBroker.ipAddress, magicBroker.port);
     mqtt->subscribe(String("cmd"), 0);
     mqtt->subscribe(String("config"), 0);
@@ -133,28 +233,19 @@ void setup()
     mqtt->subscribeGlobalNamespace(FAMILY_ROOM_FLAMETHROWER_TOPIC, 0);
     mqtt->subscribeGlobalNamespace(OFFICE_FLAMETHROWER_TOPIC, 0);
 
+    mqtt->subscribeGlobalNamespace(DISPLAY_SNAPSHOT_TOPIC, 0);
+
     // mqttReconnectTimer = xTimerCreate("mqttTimer", pdMS_TO_TICKS(2000), pdFALSE, (void *)0, reinterpret_cast<TimerCallbackFunction_t>(connectToMqtt));
     // wifiReconnectTimer = xTimerCreate("wifiTimer", pdMS_TO_TICKS(2000), pdFALSE, (void *)0, reinterpret_cast<TimerCallbackFunction_t>(connectToWiFi));
     // l.debug("created the timers");
     // show_startup("timers made");
 
-    xTaskCreate(updateDisplayTask,
-                "updateDisplayTask",
-                10240,
-                NULL,
-                2,
-                &displayUpdateTaskHandler);
-
-    xTaskCreate(printLocalTimeTask,
-                "printLocalTimeTask",
-                4096,
-                NULL,
-                1,
-                &localTimeTaskHandler);
-
     // Enable OTA
-    // setup_ota(String(CREATURE_NAME));
-    // start_ota();
+    setup_ota(String(CREATURE_NAME));
+    start_ota();
+
+    // Let people see the screen without walking over to it
+    start_mirror();
 
     // Tell MQTT we're alive
     mqtt->publish(String("status"), String("I'm alive!!"), 0, false);
@@ -162,16 +253,15 @@ void setup()
 
     digitalWrite(LED_BUILTIN, LOW);
     display.wipeScreen();
+    display.redrawEventLog();
 
-    // Start the task to read the queue
-    l.debug("starting the message reader task");
-    TaskHandle_t messageReaderTaskHandle;
-    xTaskCreate(messageQueueReaderTask,
-                "messageQueueReaderTask",
-                10240,
-                NULL,
-                1,
-                &messageReaderTaskHandle);
+    // Start reading MQTT, drawing, and ticking the clock
+    l.debug("starting the pipeline");
+    start_pipeline();
+
+#ifdef INGRESS_LOAD_TEST
+    start_ingress_load_test();
+#endif
 }
 
 // Stolen from StackOverflow
@@ -189,20 +279,226 @@ char *ultoa(unsigned long val, char *s)
     return p;
 }
 
-// Print the temperature we just got from an event. Note that there's
-// a bug here if the length of the string is too big, it'll crash.
-void print_temperature(const char *room, const char *temperature)
+// Runs from historyTimer so history keeps going while the display (and
+// the clock) are asleep. It's on the timer task, so it mustn't block:
+// post_display_message() won't wait for room from here.
+void commitHistory(TimerHandle_t timer)
+{
+    history.commitSample();
+
+    // Let the display stage redraw the power page
+    struct DisplayMessage message;
+    message.type = power_history_message;
+    post_display_message(ingress_config, power_history_message, &message);
+}
+
+#ifdef PANEL_POWER_TEST
+// Turn the panel off and on again, so the supply current can be read both
+// ways. The display stage does the work, this only changes what it's
+// following.
+void togglePanelForPowerTest(TimerHandle_t timer)
+{
+    gDisplayOn = !gDisplayOn;
+    l.info("power test: the panel is %s for the next %ds, read the meter",
+           gDisplayOn ? "on" : "off",
+           PANEL_POWER_TEST_MS / 1000);
+}
+#endif
+
+// Draw the power page from the history
+void refresh_power_history()
+{
+    static float *samples = NULL;
+    if (samples == NULL)
+        samples = (float *)ps_malloc(HISTORY_SAMPLES * sizeof(float));
+    if (samples == NULL)
+        return;
+
+    uint16_t count = history.copyRecent(home_power_use_series, samples, HISTORY_SAMPLES);
+    display.printPowerHistory(samples, count, history.stats(home_power_use_series));
+}
+
+/**
+ * @brief Show how far along an OTA update is
+ *
+ * Called from the OTA task, which can't draw while the pipeline is, so the
+ * display stage does it. Only the latest progress is worth drawing.
+ *
+ * @param percent 0-100, or OTA_PROGRESS_FAILED
+ */
+void show_ota_progress(uint8_t percent)
+{
+    struct DisplayMessage message;
+    message.type = ota_progress_message;
+    message.percent = percent;
+    post_display_message(ingress_config, ota_progress_message, &message);
+}
+
+// Same idea, for a system message from another task
+void show_system_message(const char *text)
+{
+    struct DisplayMessage message;
+    message.type = system_message;
+    strncpy(message.text, text, LCD_WIDTH);
+    message.text[LCD_WIDTH] = '\0';
+    post_display_message(ingress_config, system_message, &message);
+}
+
+// Ask the display stage to flip to a page
+void request_page(DashboardPage page)
+{
+    struct DisplayMessage message;
+    message.type = page_message;
+    message.page = page;
+    post_display_message(ingress_config, page_message, &message);
+}
+
+/**
+ * @brief Hand a message to the display stage
+ *
+ * What happens if it's backed up is up to the class's policy. Drops are
+ * counted by the queue, so there's nothing for the caller to do about them.
+ *
+ * Nothing waits for room from the timer task, where it would hold up every
+ * other timer, or from the pipeline task, which is the one that makes the
+ * room. Under policy_block those drop right away.
+ *
+ * @param key which messages policy_coalesce treats as the same thing
+ */
+boolean post_display_message(IngressClass ingressClass, uint32_t key, struct DisplayMessage *message)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    boolean mayWait = self != pipelineTaskHandle && self != xTimerGetTimerDaemonTaskHandle();
+
+    return displayQueue.send(ingressClass, key, message, mayWait);
+}
+
+// Push the ingress policies from the config into the display queue
+void apply_ingress_policies()
+{
+    for (int i = 0; i < INGRESS_CLASS_COUNT; i++)
+        displayQueue.setPolicy((IngressClass)i, (BackpressurePolicy)gIngressPolicy[i], gIngressDeadline[i]);
+}
+
+/**
+ * @brief Handle something sent to our cmd topic
+ *
+ * "page next" or "page <name>" flips the dashboard, "render stats"
+ * publishes how long each widget has been taking to draw, "ingress stats"
+ * what the display queue has dropped or waited on, "pipeline stats"
+ * how the stages are doing and how much of their stack they've left, and
+ * "power stats" how long the panel has been off and what that saved.
+ */
+void handle_command(const char *command)
+{
+    l.info("got a command: %s", command);
+
+    if (strcmp(command, "page next") == 0)
+    {
+        request_page((DashboardPage)((display.currentPage() + 1) % PAGE_COUNT));
+        return;
+    }
+
+    if (strcmp(command, "ingress stats") == 0)
+    {
+        char stats[448];
+        int used = displayQueue.describeStats(stats, sizeof(stats));
+        if (used < (int)sizeof(stats))
+            snprintf(stats + used, sizeof(stats) - used, ", mqtt queue peak %d", gIncomingHighWater);
+        mqtt->publish(String("status"), String(stats), 0, false);
+        return;
+    }
+
+    if (strcmp(command, "pipeline stats") == 0)
+    {
+        char stats[256];
+        int used = pipeline.describeStats(stats, sizeof(stats));
+        if (used < (int)sizeof(stats))
+            snprintf(stats + used,
+                     sizeof(stats) - used,
+                     ", stack %d of %d left",
+                     uxTaskGetStackHighWaterMark(pipelineTaskHandle),
+                     PIPELINE_STACK_SIZE);
+        mqtt->publish(String("status"), String(stats), 0, false);
+        return;
+    }
+
+    if (strcmp(command, "power stats") == 0)
+    {
+        char stats[160];
+        display.describePowerStats(stats, sizeof(stats));
+        mqtt->publish(String("status"), String(stats), 0, false);
+        return;
+    }
+
+    if (strcmp(command, "render stats") == 0)
+    {
+        char stats[384];
+        display.describeRenderStats(stats, sizeof(stats));
+        mqtt->publish(String("status"), String(stats), 0, false);
+        return;
+    }
+
+    if (strncmp(command, "page ", 5) == 0)
+    {
+        for (int page = 0; page < PAGE_COUNT; page++)
+        {
+            if (strcmp(command + 5, pageNames[page]) == 0)
+            {
+                request_page((DashboardPage)page);
+                return;
+            }
+        }
+    }
+
+    l.warning("unknown command: %s", command);
+}
+
+// Note when something happened so the event log can show it
+void stamp_message(struct DisplayMessage *message)
+{
+    String now = creatureTime->getCurrentTime("%I:%M %p");
+
+    memset(message->timestamp, '\0', EVENT_TIMESTAMP_LENGTH + 1);
+    strncpy(message->timestamp, now.c_str(), EVENT_TIMESTAMP_LENGTH);
+}
+
+// Print the temperature we just got from an event. It goes in the event
+// log and on the room's row of the rooms page.
+void print_temperature(HistorySeries series, const char *room, const char *temperature)
 {
     l.debug("printing temperature, room: %s", room);
-    char buffer[LCD_WIDTH + 1];
 
     struct DisplayMessage message;
     message.type = temperature_message;
+    message.series = series;
+    message.room = room;
+    message.value = atof(temperature);
+    stamp_message(&message);
 
-    memset(buffer, '\0', LCD_WIDTH + 1);
-    sprintf(message.text, "%s: %sF", room, temperature);
+    memset(message.text, '\0', LCD_WIDTH + 1);
+    snprintf(message.text, LCD_WIDTH + 1, "%s: %sF", room, temperature);
+
+    post_display_message(ingress_temperature, series, &message);
+}
 
-    xQueueSendToBackFromISR(displayQueue, &message, NULL);
+// A new temperature for a room goes in the history and on the display
+void update_room(HistorySeries series, const char *room, const char *temperature)
+{
+    history.record(series, atof(temperature));
+    print_temperature(series, room, temperature);
+}
+
+// One of the outside widgets has a new value
+void print_reading(HistorySeries series, float value)
+{
+    history.record(series, value);
+
+    struct DisplayMessage message;
+    message.type = reading_message;
+    message.series = series;
+    message.value = value;
+    post_display_message(ingress_temperature, series, &message);
 }
 
 void print_flamethrower(const char *room, boolean on)
@@ -220,18 +516,19 @@ void print_flamethrower(const char *room, boolean on)
     memset(buffer, '\0', LCD_WIDTH + 1);
     sprintf(message.text, "%s %s", room, action);
 
-    xQueueSendToBackFromISR(displayQueue, &message, NULL);
+    post_display_message(ingress_flamethrower, 0, &message);
 }
 
 void show_home_message(const char *message)
 {
     struct DisplayMessage home_message;
     home_message.type = home_event_message;
+    stamp_message(&home_message);
 
     memset(home_message.text, '\0', LCD_WIDTH + 1);
     memcpy(home_message.text, message, LCD_WIDTH);
 
-    xQueueSendToBackFromISR(displayQueue, &home_message, NULL);
+    post_display_message(ingress_motion, 0, &home_message);
 }
 
 // Process a tricky event path to know how to update the display... this
@@ -296,46 +593,46 @@ void display_message(const char *topic, const char *message)
     }
     else if (strncmp(HALF_BATHROOM_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Half Bathroom", message);
+        update_room(half_bathroom_temperature_series, "Half Bathroom", message);
     }
     else if (strncmp(BUNNYS_ROOM_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Bunny's Room", message);
+        update_room(bunnys_room_temperature_series, "Bunny's Room", message);
     }
     else if (strncmp(OFFICE_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Office", message);
+        update_room(office_temperature_series, "Office", message);
     }
     else if (strncmp(FAMILY_ROOM_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Family Room", message);
+        update_room(family_room_temperature_series, "Family Room", message);
     }
     else if (strncmp(WORKSHOP_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Workshop", message);
+        update_room(workshop_temperature_series, "Workshop", message);
     }
     else if (strncmp(GUEST_ROOM_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Guest Room", message);
+        update_room(guest_room_temperature_series, "Guest Room", message);
     }
     else if (strncmp(KITCHEN_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        print_temperature("Kitchen", message);
+        update_room(kitchen_temperature_series, "Kitchen", message);
     }
 
     else if (strncmp(OUTSIDE_TEMPERATURE_TOPIC, topic, topic_length) == 0)
     {
-        display.printTemperature(atof(message));
+        print_reading(outside_temperature_series, atof(message));
     }
 
     else if (strncmp(OUTSIDE_WIND_SPEED_TOPIC, topic, topic_length) == 0)
     {
-        display.printWindspeed(atof(message));
+        print_reading(outside_wind_speed_series, atof(message));
     }
 
     else if (strncmp(HOME_POWER_USE_WATTS, topic, topic_length) == 0)
     {
-        display.printPowerUsed(atof(message));
+        print_reading(home_power_use_series, atof(message));
     }
 
     else if (strncmp(FAMILY_ROOM_FLAMETHROWER_TOPIC, topic, topic_length) == 0)
@@ -367,98 +664,380 @@ void display_message(const char *topic, const char *message)
     }
 }
 
-portTASK_FUNCTION(updateDisplayTask, pvParameters)
+// Where each number in a snapshot ends up, indexed by SnapshotField
+struct SnapshotTarget
+{
+    HistorySeries series;
+    const char *room; // NULL for the outside widgets
+};
+
+static const SnapshotTarget snapshotTargets[] = {
+    {},                                                   // snapshot_version
+    {outside_temperature_series, NULL},                   // snapshot_outside_temperature
+    {outside_wind_speed_series, NULL},                    // snapshot_outside_wind_speed
+    {home_power_use_series, NULL},                        // snapshot_home_power_use
+    {half_bathroom_temperature_series, "Half Bathroom"},  // snapshot_half_bathroom_temperature
+    {bunnys_room_temperature_series, "Bunny's Room"},     // snapshot_bunnys_room_temperature
+    {office_temperature_series, "Office"},                // snapshot_office_temperature
+    {family_room_temperature_series, "Family Room"},      // snapshot_family_room_temperature
+    {workshop_temperature_series, "Workshop"},            // snapshot_workshop_temperature
+    {guest_room_temperature_series, "Guest Room"},        // snapshot_guest_room_temperature
+    {kitchen_temperature_series, "Kitchen"},              // snapshot_kitchen_temperature
+};
+
+static void apply_snapshot_number(uint8_t field, float value)
 {
+    const SnapshotTarget *target = &snapshotTargets[field];
 
-    struct DisplayMessage message;
+    // Snapshots repeat everything, only draw what actually changed
+    float previous;
+    if (history.latest(target->series, &previous) && fabsf(previous - value) < 0.05f)
+        return;
 
-    for (;;)
+    if (target->room != NULL)
     {
-        if (displayQueue != NULL)
+        char temperature[8];
+        snprintf(temperature, sizeof(temperature), "%.1f", value);
+        update_room(target->series, target->room, temperature);
+        return;
+    }
+
+    print_reading(target->series, value);
+}
+
+/**
+ * @brief Apply a binary snapshot straight out of the MQTT payload
+ *
+ * One pass over the buffer to check it, then another where each field goes
+ * to its widget as soon as it's decoded. See snapshot.h for the layout.
+ *
+ * @param payload the unstuffed payload
+ * @param length how long the snapshot is, not how big the buffer is
+ */
+void apply_snapshot(const uint8_t *payload, size_t length)
+{
+    // Flamethrowers don't have history to compare against
+    static int8_t flamethrowers[2] = {-1, -1};
+
+    // Nothing from one that's been cut short gets applied
+    SnapshotReader reader(payload, length);
+    if (!reader.complete() || !reader.begin())
+    {
+        l.warning("ignoring a %d byte snapshot we don't understand", length);
+        return;
+    }
+
+    float number;
+    bool flag;
+    for (uint8_t field = snapshot_outside_temperature; field < SNAPSHOT_FIELD_COUNT; field++)
+    {
+        SnapshotValueType type = reader.next(&number, &flag);
+
+        if (type == snapshot_end)
+            break;
+        if (type == snapshot_nil)
+            continue;
+
+        if (type == snapshot_number && field < snapshot_family_room_flamethrower)
         {
-            if (xQueueReceive(displayQueue, &message, (TickType_t)10) == pdPASS)
+            apply_snapshot_number(field, number);
+        }
+        else if (type == snapshot_bool && field >= snapshot_family_room_flamethrower)
+        {
+            int8_t *last = &flamethrowers[field - snapshot_family_room_flamethrower];
+            if (*last != flag)
             {
-
-                // TODO: Handle gDisplay being off
-
-                if (message.text != NULL)
-                {
-                    l.verbose("got a message: %s", message.text);
-                    switch (message.type)
-                    {
-                    case home_event_message:
-                        display.printHouseMessage(message.text);
-                        break;
-                    case flamethrower_message:
-                        display.printFlamethrowerMessage(message.text);
-                        break;
-                    case clock_display_message:
-                        display.printTime(message.text);
-                        break;
-                    case temperature_message:
-                        display.printHouseMessage(message.text);
-                        break;
-                    }
-                }
-                else
-                {
-                    l.warning("NULL message pulled from the displayQueue");
-                }
+                *last = flag;
+                print_flamethrower(field == snapshot_office_flamethrower ? "Office" : "Family Room", flag);
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
+        else
+        {
+            l.warning("snapshot field %d has the wrong type", field);
+        }
+    }
+
+    l.verbose("applied a snapshot of %d fields in %d bytes", reader.fieldCount(), reader.consumed());
+}
+
+// Put an outside reading on its widget
+void show_reading(HistorySeries series, float value)
+{
+    switch (series)
+    {
+    case outside_temperature_series:
+        display.printTemperature(value);
+        break;
+    case outside_wind_speed_series:
+        display.printWindspeed(value);
+        break;
+    case home_power_use_series:
+        display.printPowerUsed(value);
+        break;
+    default:
+        l.warning("no widget for series %d", series);
+        break;
     }
 }
 
-// Create a task to add the local time to the queue to print
-portTASK_FUNCTION(printLocalTimeTask, pvParameters)
+// Flip to a page and tell MQTT how long it took
+void show_page(DashboardPage page)
+{
+    unsigned long took = display.showPage(page);
+
+    char status[48];
+    snprintf(status, sizeof(status), "page %s up in %luus", pageNames[page], took);
+    mqtt->publish(String("status"), String(status), 0, false);
+}
+
+// Resume the display stage where it left off
+static StageState displayStep(Stage *stage)
 {
+    DisplayState *s = (DisplayState *)stage->context;
+
+    STAGE_BEGIN(stage);
+    s->lastPageFlip = millis();
+
     for (;;)
     {
-        l.verbose("tick");
+        // Follow the config's lead on whether the display should be on. The
+        // clock stage sees it's asleep and stops ticking. Everything else
+        // keeps flowing so the widgets stay current. Waking is started here
+        // and finished on a later pass, once the panel has come up on a
+        // task of its own; until then this comes round every 100ms.
+        if (gDisplayOn)
+        {
+            if (display.wake())
+                refresh_power_history();
+        }
+        else
+        {
+            display.sleep();
+        }
 
-        String currentTime = creatureTime->getCurrentTime("%I:%M:%S %p");
+        // Rotate through the pages if we've been asked to
+        if (gPageInterval > 0 && millis() - s->lastPageFlip >= (unsigned long)gPageInterval * 1000)
+        {
+            show_page((DashboardPage)((display.currentPage() + 1) % PAGE_COUNT));
+            s->lastPageFlip = millis();
+        }
 
-        struct DisplayMessage message;
-        message.type = clock_display_message;
-        memcpy(message.text, currentTime.c_str(), currentTime.length());
+        // Draw what's waiting. Only a queue's worth at a time, so a flood
+        // can't keep the other stages from having a turn.
+        s->drawn = 0;
+        while (s->drawn < DISPLAY_QUEUE_LENGTH && displayQueue.receive(&s->message, 0))
+        {
+            s->drawn++;
+            draw_display_message(&s->message);
+            if (s->message.type == page_message)
+                s->lastPageFlip = millis();
+        }
 
-        l.verbose("Current time: %s", message.text);
+        if (s->drawn == DISPLAY_QUEUE_LENGTH)
+            STAGE_YIELD(stage);
+        else
+            STAGE_AWAIT_FOR(stage, displayQueue.waiting() > 0, 100);
+    }
 
-        // Drop this message into the queue, giving up after 500ms if there's no
-        // space in the queue
-        xQueueSendToBack(displayQueue, &message, pdMS_TO_TICKS(500));
+    STAGE_END(stage);
+}
 
-        // Wait before repeating
-        vTaskDelay(TickType_t pdMS_TO_TICKS(1000));
+// Put one message from the display queue on the screen
+void draw_display_message(struct DisplayMessage *message)
+{
+    l.verbose("got a message: %s", message->text);
+    switch (message->type)
+    {
+    case home_event_message:
+        display.addHouseEvent(message->timestamp, message->text);
+        break;
+    case flamethrower_message:
+        display.printFlamethrowerMessage(message->text);
+        break;
+    case clock_display_message:
+        display.printTime(message->text);
+        break;
+    case temperature_message:
+        display.addHouseEvent(message->timestamp, message->text);
+        display.printRoomTemperature((HistorySeries)message->series,
+                                     message->room,
+                                     message->value,
+                                     history.stats((HistorySeries)message->series));
+        break;
+    case reading_message:
+        show_reading((HistorySeries)message->series, message->value);
+        break;
+    case power_history_message:
+        refresh_power_history();
+        break;
+    case page_message:
+        show_page(message->page);
+        break;
+    case ota_progress_message:
+        display.showOtaProgress(message->percent);
+        break;
+    case system_message:
+        display.showSystemMessage(message->text);
+        break;
     }
 }
 
-// Read from the queue and print it to the screen for now
-portTASK_FUNCTION(messageQueueReaderTask, pvParameters)
+// Add the local time to the display queue once a second
+static StageState clockStep(Stage *stage)
 {
+    STAGE_BEGIN(stage);
 
-    QueueHandle_t incomingQueue = mqtt->getIncomingMessageQueue();
     for (;;)
     {
-        struct MqttMessage message;
-        if (xQueueReceive(incomingQueue, &message, (TickType_t)5000) == pdPASS)
+        if (!display.isAsleep())
         {
-            l.debug("Incoming message! local topic: %s, global topic: %s, payload: %s",
-                    message.topic,
-                    message.topicGlobalNamespace,
-                    message.payload);
+            l.verbose("tick");
+
+            const char *format = gClock24Hour ? (gClockSeconds ? "%H:%M:%S" : "%H:%M")
+                                              : (gClockSeconds ? "%I:%M:%S %p" : "%I:%M %p");
+            String currentTime = creatureTime->getCurrentTime(format);
 
-            // Is this a config message?
-            if (strncmp("config", message.topic, strlen(message.topic)) == 0)
+            struct DisplayMessage message;
+            message.type = clock_display_message;
+            memset(message.text, '\0', LCD_WIDTH + 1);
+            memcpy(message.text, currentTime.c_str(), currentTime.length());
+
+            l.verbose("Current time: %s", message.text);
+
+            // A newer time replaces one that hasn't been drawn yet, and the
+            // display stage draws it in this same pass
+            post_display_message(ingress_clock, 0, &message);
+        }
+
+        STAGE_SLEEP(stage, 1000);
+    }
+
+    STAGE_END(stage);
+}
+
+// Sort out where the messages pipelineTask took off MQTT go, a few per turn
+static StageState readerStep(Stage *stage)
+{
+    ReaderState *s = (ReaderState *)stage->context;
+    struct MqttMessage *message = &s->inbox[s->inboxHead];
+
+    STAGE_BEGIN(stage);
+
+    for (;;)
+    {
+        // Keep track of how far behind we get
+        s->waiting = uxQueueMessagesWaiting(s->incomingQueue) + s->inboxCount;
+        if (s->waiting > gIncomingHighWater)
+            gIncomingHighWater = s->waiting;
+
+        STAGE_AWAIT(stage, s->inboxCount > 0);
+        message = &s->inbox[s->inboxHead];
+
+        // Not the payload, snapshots are binary
+        l.debug("Incoming message! local topic: %s, global topic: %s",
+                message->topic,
+                message->topicGlobalNamespace);
+
+        // Is this a config message?
+        if (strncmp("config", message->topic, strlen(message->topic)) == 0)
+        {
+            l.info("Got a config message from MQTT: %s", message->payload);
+            updateConfig(message->payload);
+        }
+        else if (strncmp("cmd", message->topic, strlen(message->topic)) == 0)
+        {
+            handle_command(message->payload);
+        }
+        else if (strcmp(DISPLAY_SNAPSHOT_TOPIC, message->topic) == 0)
+        {
+            // Stuffed so there's no 0x00 in it, which makes the string
+            // length the length that was published
+            size_t stuffed = strnlen(message->payload, sizeof(message->payload));
+            size_t length = snapshotUnstuff((uint8_t *)message->payload, stuffed);
+            apply_snapshot((const uint8_t *)message->payload, length);
+        }
+        else
+        {
+            display_message(message->topic, message->payload);
+        }
+
+        s->inboxHead = (s->inboxHead + 1) % PIPELINE_READER_BATCH;
+        s->inboxCount--;
+
+        // Let what that posted get drawn before MQTT gets too far ahead
+        if (++s->taken == PIPELINE_READER_BATCH)
+        {
+            s->taken = 0;
+            STAGE_YIELD(stage);
+        }
+    }
+
+    STAGE_END(stage);
+}
+
+static uint32_t stageMicros()
+{
+    return micros();
+}
+
+/**
+ * @brief Start the stages on their one task
+ *
+ * The reader goes first so anything it posts is drawn in the same pass,
+ * without a trip through the scheduler.
+ */
+void start_pipeline()
+{
+    readerState.incomingQueue = mqtt->getIncomingMessageQueue();
+
+    pipeline.add(&readerStage, "reader", readerStep, &readerState);
+    pipeline.add(&clockStage, "clock", clockStep, NULL);
+    pipeline.add(&displayStage, "display", displayStep, &displayState);
+
+    xTaskCreate(pipelineTask,
+                "pipelineTask",
+                PIPELINE_STACK_SIZE,
+                NULL,
+                2,
+                &pipelineTaskHandle);
+}
+
+/**
+ * @brief Run the stages, and sleep until one of them has something to do
+ *
+ * Every handle the queue set gives back is for exactly one item, so each
+ * is received from once, and nothing is received from a member the set
+ * didn't give back. A message from MQTT goes in the reader's inbox. Once
+ * the inbox is full the rest stay queued, their wakeups with them, until
+ * the reader has made room; the reader has work then, so there's no wait.
+ */
+portTASK_FUNCTION(pipelineTask, pvParameters)
+{
+    ReaderState *reader = &readerState;
+
+    for (;;)
+    {
+        uint32_t wait = pipeline.runOnce(millis());
+        if (reader->inboxCount == PIPELINE_READER_BATCH)
+            continue;
+
+        TickType_t ticks = wait == STAGE_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(wait);
+        QueueSetMemberHandle_t woken = xQueueSelectFromSet(pipelineWakeups, ticks);
+        while (woken != NULL)
+        {
+            if (woken == displayQueue.arrivals())
             {
-                l.info("Got a config message from MQTT: %s", message.payload);
-                updateConfig(String(message.payload));
+                xSemaphoreTake(displayQueue.arrivals(), 0);
             }
-            else
+            else if (woken == reader->incomingQueue)
             {
-                display_message(message.topic, message.payload);
+                uint8_t tail = (reader->inboxHead + reader->inboxCount) % PIPELINE_READER_BATCH;
+                if (xQueueReceive(reader->incomingQueue, &reader->inbox[tail], 0) == pdPASS)
+                    reader->inboxCount++;
+                if (reader->inboxCount == PIPELINE_READER_BATCH)
+                    break;
             }
+            woken = xQueueSelectFromSet(pipelineWakeups, 0);
         }
     }
 }
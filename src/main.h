@@ -16,15 +16,33 @@ extern "C"
 
 #include <AsyncMqttClient.h>
 
+#include "eventlog.h"
+#include "history.h"
+#include "ingress.h"
+#include "screen.h"
+
 #define LCD_WIDTH 30
-#define DISPLAY_QUEUE_LENGTH 5
+#define DISPLAY_QUEUE_LENGTH 16
+
+// The one task the reader, clock and display stages share. It has to be as
+// deep as the deepest of them, which is drawing.
+#define PIPELINE_STACK_SIZE 10240
+
+// How many MQTT messages the reader handles before the others get a turn,
+// and how many pipelineTask takes off MQTT for it at a time
+#define PIPELINE_READER_BATCH 4
 
 
 enum MessageType {
   clock_display_message,
   flamethrower_message,
   home_event_message,
-  temperature_message
+  temperature_message,
+  reading_message,
+  power_history_message,
+  page_message,
+  ota_progress_message,
+  system_message
 };
 
 
@@ -32,7 +50,13 @@ enum MessageType {
 struct DisplayMessage
 {
   MessageType type;
+  char timestamp[EVENT_TIMESTAMP_LENGTH + 1];
   char text[LCD_WIDTH + 1];
+  uint8_t page;
+  uint8_t percent;  // OTA progress, or OTA_PROGRESS_FAILED
+  uint8_t series;   // A HistorySeries, for temperatures and readings
+  float value;
+  const char *room;
 } __attribute__((packed));
 
 
@@ -42,13 +66,38 @@ char *ultoa(unsigned long val, char *s);
 void updateHouseStatus();
 void print_flamethrower(const char *room, boolean on);
 
-void print_temperature(const char *room, const char *temperature);
+void print_temperature(HistorySeries series, const char *room, const char *temperature);
+void update_room(HistorySeries series, const char *room, const char *temperature);
+void print_reading(HistorySeries series, float value);
+void show_reading(HistorySeries series, float value);
+
+boolean post_display_message(IngressClass ingressClass, uint32_t key, struct DisplayMessage *message);
+void apply_ingress_policies();
+
+#ifdef INGRESS_LOAD_TEST
+void start_ingress_load_test();
+#endif
+
+void refresh_power_history();
+void show_ota_progress(uint8_t percent);
+void show_system_message(const char *text);
+void request_page(DashboardPage page);
+void show_page(DashboardPage page);
+void handle_command(const char *command);
+
+void apply_snapshot(const uint8_t *payload, size_t length);
 
 void handle_mqtt_message(char *topic, char *payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total);
 
 void printFlamethrowerMessage(char* message);
+void commitHistory(TimerHandle_t timer);
+#ifdef PANEL_POWER_TEST
+void togglePanelForPowerTest(TimerHandle_t timer);
+#endif
+
+
+void start_pipeline();
+void draw_display_message(struct DisplayMessage *message);
 
 
-portTASK_FUNCTION_PROTO(printLocalTimeTask, pvParameters);
-portTASK_FUNCTION_PROTO(messageQueueReaderTask, pvParameters);
-portTASK_FUNCTION_PROTO(updateDisplayTask, pvParameters);
+portTASK_FUNCTION_PROTO(pipelineTask, pvParameters);
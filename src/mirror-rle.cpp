@@ -0,0 +1,211 @@
+#include <string.h>
+
+#include "mirror-rle.h"
+
+namespace creatures
+{
+
+    RleEncoder::RleEncoder(RleByteWriter writer, void *context, uint8_t *buffer, size_t bufferSize)
+    {
+        this->writer = writer;
+        this->context = context;
+        this->buffer = buffer;
+        this->bufferSize = bufferSize;
+        used = 0;
+        total = 0;
+        ok = true;
+
+        literalCount = 0;
+        runPixel = 0;
+        runCount = 0;
+    }
+
+    /**
+     * @brief Encode some more pixels
+     *
+     * Pixels carry on from the last call, so a region can be handed over a
+     * row at a time.
+     *
+     * @return false if the writer failed
+     */
+    bool RleEncoder::add(const uint16_t *pixels, size_t count)
+    {
+        for (size_t i = 0; i < count && ok; i++)
+        {
+            uint16_t pixel = pixels[i];
+
+            if (runCount > 0 && pixel == runPixel)
+            {
+                if (++runCount == RLE_MAX_RUN)
+                    emitRun();
+                continue;
+            }
+
+            // A single pixel isn't worth a run, it goes with the literals
+            if (runCount == 1)
+            {
+                literal[literalCount++] = runPixel;
+                if (literalCount == RLE_MAX_LITERAL)
+                    emitLiteral();
+            }
+            else if (runCount > 1)
+            {
+                emitRun();
+            }
+
+            runPixel = pixel;
+            runCount = 1;
+        }
+
+        return ok;
+    }
+
+    /**
+     * @brief Write out anything that's pending
+     */
+    bool RleEncoder::finish()
+    {
+        if (runCount == 1)
+        {
+            literal[literalCount++] = runPixel;
+            runCount = 0;
+        }
+        else if (runCount > 1)
+        {
+            emitRun();
+        }
+
+        if (literalCount > 0)
+            emitLiteral();
+
+        return flush() && ok;
+    }
+
+    uint32_t RleEncoder::encodedBytes()
+    {
+        return total + used;
+    }
+
+    // Literals come before the run that ended them
+    bool RleEncoder::emitRun()
+    {
+        if (literalCount > 0)
+            emitLiteral();
+
+        uint8_t packet[3] = {(uint8_t)(RLE_RUN_FLAG | (runCount - 2)),
+                             (uint8_t)(runPixel & 0xFF),
+                             (uint8_t)(runPixel >> 8)};
+        runCount = 0;
+        return put(packet, 3);
+    }
+
+    bool RleEncoder::emitLiteral()
+    {
+        uint8_t control = literalCount - 1;
+        put(&control, 1);
+
+        for (uint8_t i = 0; i < literalCount; i++)
+        {
+            uint8_t pixel[2] = {(uint8_t)(literal[i] & 0xFF), (uint8_t)(literal[i] >> 8)};
+            put(pixel, 2);
+        }
+
+        literalCount = 0;
+        return ok;
+    }
+
+    bool RleEncoder::put(const uint8_t *data, size_t length)
+    {
+        for (size_t i = 0; i < length && ok; i++)
+        {
+            if (used == bufferSize)
+                flush();
+            buffer[used++] = data[i];
+        }
+        return ok;
+    }
+
+    bool RleEncoder::flush()
+    {
+        if (used > 0 && ok)
+        {
+            ok = writer(context, buffer, used);
+            total += used;
+            used = 0;
+        }
+        return ok;
+    }
+
+    RleDecoder::RleDecoder(RlePixelWriter writer, void *context)
+    {
+        this->writer = writer;
+        this->context = context;
+        state = rle_control;
+        remaining = 0;
+        partialCount = 0;
+        decoded = 0;
+    }
+
+    /**
+     * @brief Decode the next piece of the stream
+     *
+     * @return false if the writer failed
+     */
+    bool RleDecoder::feed(const uint8_t *data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            uint8_t byte = data[i];
+
+            switch (state)
+            {
+            case rle_control:
+                if (byte & RLE_RUN_FLAG)
+                {
+                    remaining = (byte & ~RLE_RUN_FLAG) + 2;
+                    state = rle_run;
+                }
+                else
+                {
+                    remaining = byte + 1;
+                    state = rle_literal;
+                }
+                partialCount = 0;
+                break;
+
+            case rle_literal:
+            case rle_run:
+            {
+                partial[partialCount++] = byte;
+                if (partialCount < 2)
+                    break;
+                partialCount = 0;
+
+                uint16_t pixel = partial[0] | (partial[1] << 8);
+                size_t count = state == rle_run ? remaining : 1;
+                if (!writer(context, pixel, count))
+                {
+                    state = rle_failed;
+                    return false;
+                }
+                decoded += count;
+                remaining -= count;
+
+                if (remaining == 0)
+                    state = rle_control;
+                break;
+            }
+
+            case rle_failed:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint32_t RleDecoder::decodedPixels()
+    {
+        return decoded;
+    }
+}
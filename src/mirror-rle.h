@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+    Run length coding for RGB565 pixels
+
+    Plain C++ (no Arduino.h) so the viewer in tools/ decodes with the same
+    code the display encodes with.
+
+    The stream is a series of packets, each starting with a control byte:
+
+        0x00-0x7F  literal: control + 1 pixels follow, 2 bytes each
+        0x80-0xFF  run: the next pixel, repeated control - 0x80 + 2 times
+
+    The dashboard is mostly flat background, so most of a frame turns into
+    3 byte runs of 129 pixels.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RLE_MAX_LITERAL 128
+#define RLE_MAX_RUN 129
+#define RLE_RUN_FLAG 0x80
+
+namespace creatures
+{
+
+    // Take the next bytes of encoded output
+    typedef bool (*RleByteWriter)(void *context, const uint8_t *data, size_t length);
+
+    // Take count copies of a decoded pixel
+    typedef bool (*RlePixelWriter)(void *context, uint16_t pixel, size_t count);
+
+    /**
+     * @brief Encodes pixels as they're handed over
+     *
+     * Output goes through a caller supplied buffer, and is handed to the
+     * writer each time the buffer fills.
+     */
+    class RleEncoder
+    {
+
+    public:
+        RleEncoder(RleByteWriter writer, void *context, uint8_t *buffer, size_t bufferSize);
+
+        bool add(const uint16_t *pixels, size_t count);
+        bool finish();
+
+        uint32_t encodedBytes();
+
+    private:
+        bool emitRun();
+        bool emitLiteral();
+        bool put(const uint8_t *data, size_t length);
+        bool flush();
+
+        RleByteWriter writer;
+        void *context;
+        uint8_t *buffer;
+        size_t bufferSize;
+        size_t used;
+        uint32_t total;
+        bool ok;
+
+        uint16_t literal[RLE_MAX_LITERAL];
+        uint8_t literalCount;
+        uint16_t runPixel;
+        uint8_t runCount;
+    };
+
+    enum RleDecoderState
+    {
+        rle_control,
+        rle_literal,
+        rle_run,
+        rle_failed
+    };
+
+    /**
+     * @brief Decodes a stream that arrives in arbitrary sized pieces
+     */
+    class RleDecoder
+    {
+
+    public:
+        RleDecoder(RlePixelWriter writer, void *context);
+
+        bool feed(const uint8_t *data, size_t length);
+        uint32_t decodedPixels();
+
+    private:
+        RlePixelWriter writer;
+        void *context;
+
+        RleDecoderState state;
+        uint8_t remaining; // Pixels left in this packet
+        uint8_t partial[2];
+        uint8_t partialCount;
+        uint32_t decoded;
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/*
+    The wire format for screenshots and the live mirror. Plain C++ so
+    tools/mirror-view can share it.
+
+    A viewer connects to MIRROR_PORT and sends one command byte:
+
+        'S'  send the screen once, then hang up
+        'M'  send the screen, then keep sending whatever changes
+
+    The display answers with regions. Each is a MirrorRegion header followed
+    by the region's pixels, row by row, run length encoded (see
+    mirror-rle.h) and split into chunks. A chunk is a u16 length and that
+    many bytes. A zero length chunk ends the region. Nothing ever needs a
+    whole frame in memory on either end.
+
+    Pixels are RGB565 and everything is little endian.
+*/
+
+#include <stdint.h>
+
+#define MIRROR_PORT 3234
+#define MIRROR_MAGIC "CSCR"
+#define MIRROR_CHUNK_SIZE 1024
+
+#define MIRROR_COMMAND_SCREENSHOT 'S'
+#define MIRROR_COMMAND_MIRROR 'M'
+
+// The region is the whole screen, forget anything from before
+#define MIRROR_FULL_FRAME 0x01
+
+struct MirrorRegion
+{
+    char magic[4];
+    uint8_t page;  // DashboardPage that's showing
+    uint8_t flags;
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+} __attribute__((packed));
@@ -0,0 +1,200 @@
+#include <Arduino.h>
+#include <WiFi.h>
+
+extern "C"
+{
+#include "freertos/FreeRTOS.h"
+}
+
+#include "mirror.h"
+#include "mirror-rle.h"
+#include "screen.h"
+#include "logging/logging.h"
+
+using namespace creatures;
+
+extern TouchDisplay display;
+
+static creatures::Logger l;
+
+static WiFiServer *mirrorServer;
+
+// Encoded pixels wait here until there's a chunk's worth
+static uint8_t chunk[MIRROR_CHUNK_SIZE];
+
+void start_mirror()
+{
+    mirrorServer = new WiFiServer(MIRROR_PORT);
+    mirrorServer->begin();
+
+    TaskHandle_t creatureMirrorTaskHandle;
+    xTaskCreate(creatureMirrorTask,
+                "creatureMirrorTask",
+                4096,
+                NULL,
+                1,
+                &creatureMirrorTaskHandle);
+
+    l.info("screen mirror ready on port %d", MIRROR_PORT);
+}
+
+// Send one chunk, length first
+static bool writeChunk(void *context, const uint8_t *data, size_t length)
+{
+    WiFiClient *client = (WiFiClient *)context;
+
+    uint8_t header[2] = {(uint8_t)(length & 0xFF), (uint8_t)(length >> 8)};
+    return client->write(header, 2) == 2 && client->write(data, length) == length;
+}
+
+/**
+ * @brief Encode part of a page and send it
+ *
+ * Goes a row at a time straight out of the page cache, so the only
+ * buffer is one chunk.
+ *
+ * @return uint32_t bytes of encoded pixels sent, 0 if it failed
+ */
+static uint32_t sendRegion(WiFiClient *client, DashboardPage page, DirtyRect region, uint8_t flags)
+{
+    const uint16_t *pixels = display.pageBuffer(page);
+    if (pixels == NULL)
+        return 0;
+
+    MirrorRegion header;
+    memcpy(header.magic, MIRROR_MAGIC, 4);
+    header.page = page;
+    header.flags = flags;
+    header.x = region.x;
+    header.y = region.y;
+    header.width = region.w;
+    header.height = region.h;
+    if (client->write((const uint8_t *)&header, sizeof(header)) != sizeof(header))
+        return 0;
+
+    RleEncoder encoder(writeChunk, client, chunk, MIRROR_CHUNK_SIZE);
+    for (int16_t row = 0; row < region.h; row++)
+    {
+        if (!encoder.add(pixels + (region.y + row) * SCREEN_WIDTH + region.x, region.w))
+            return 0;
+    }
+    if (!encoder.finish())
+        return 0;
+
+    // A zero length chunk ends the region
+    uint8_t end[2] = {0, 0};
+    if (client->write(end, 2) != 2)
+        return 0;
+
+    return encoder.encodedBytes();
+}
+
+static uint32_t sendScreen(WiFiClient *client, DashboardPage page)
+{
+    DirtyRect everything = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+    uint32_t sent = sendRegion(client, page, everything, MIRROR_FULL_FRAME);
+
+    l.debug("sent page %d in %lu bytes, %lu%% of the raw %d",
+            page,
+            (unsigned long)sent,
+            (unsigned long)(sent * 100 / (SCREEN_WIDTH * SCREEN_HEIGHT * 2)),
+            SCREEN_WIDTH * SCREEN_HEIGHT * 2);
+    return sent;
+}
+
+/**
+ * @brief Keep a viewer up to date until it goes away
+ */
+static void mirror(WiFiClient *client)
+{
+    DirtyRect rects[MIRROR_DIRTY_RECTS];
+    DashboardPage page;
+
+    // Start from a clean slate, the whole screen is about to go out
+    display.takeDirtyRects(rects, MIRROR_DIRTY_RECTS, &page);
+    DashboardPage lastPage = page;
+    if (sendScreen(client, page) == 0)
+        return;
+
+    uint32_t updates = 0;
+    uint64_t sent = 0;
+
+    while (client->connected())
+    {
+        vTaskDelay(pdMS_TO_TICKS(MIRROR_INTERVAL_MS));
+
+        uint8_t count = display.takeDirtyRects(rects, MIRROR_DIRTY_RECTS, &page);
+        if (page != lastPage)
+        {
+            lastPage = page;
+            uint32_t bytes = sendScreen(client, page);
+            if (bytes == 0)
+                break;
+            sent += bytes;
+            continue;
+        }
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint32_t bytes = sendRegion(client, page, rects[i], 0);
+            if (bytes == 0)
+            {
+                client->stop();
+                break;
+            }
+            sent += bytes;
+            updates++;
+        }
+    }
+
+    l.info("mirror viewer left after %lu updates, %lu bytes", (unsigned long)updates, (unsigned long)sent);
+}
+
+/**
+ * @brief A task that waits for a viewer to connect
+ *
+ * Runs at a low priority. The pages are read while the pipeline may
+ * be drawing on them, so a region can catch a widget half drawn. Every
+ * draw notes its region dirty after it's finished, though, so that region
+ * is taken and sent again on the next pass.
+ */
+portTASK_FUNCTION(creatureMirrorTask, pvParameters)
+{
+    for (;;)
+    {
+        WiFiClient client = mirrorServer->available();
+        if (!client)
+        {
+            vTaskDelay(pdMS_TO_TICKS(500));
+            continue;
+        }
+
+        l.info("mirror connection from %s", client.remoteIP().toString().c_str());
+        client.setNoDelay(true);
+
+        // Give them a moment to say what they want
+        unsigned long started = millis();
+        while (client.connected() && client.available() == 0 && millis() - started < 2000)
+            vTaskDelay(pdMS_TO_TICKS(10));
+
+        int command = client.read();
+        if (display.pageBuffer(display.currentPage()) == NULL)
+        {
+            l.warning("the page that's up isn't cached, there's nothing to send");
+        }
+        else if (command == MIRROR_COMMAND_SCREENSHOT)
+        {
+            sendScreen(&client, display.currentPage());
+        }
+        else if (command == MIRROR_COMMAND_MIRROR)
+        {
+            mirror(&client);
+        }
+        else
+        {
+            l.warning("unknown mirror command: %d", command);
+        }
+
+        client.stop();
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Arduino.h>
+
+extern "C"
+{
+#include "freertos/FreeRTOS.h"
+}
+
+#include "mirror-stream.h"
+
+// How often the live mirror looks for changes
+#define MIRROR_INTERVAL_MS 200
+
+void start_mirror();
+
+/**
+ * @brief A task that sends the screen to whoever asks for it
+ */
+portTASK_FUNCTION_PROTO(creatureMirrorTask, pvParameters);
@@ -0,0 +1,234 @@
+#include <string.h>
+
+#include "ota-delta.h"
+
+namespace creatures
+{
+
+    static uint32_t readLittleEndian(const uint8_t *bytes)
+    {
+        return (uint32_t)bytes[0] |
+               ((uint32_t)bytes[1] << 8) |
+               ((uint32_t)bytes[2] << 16) |
+               ((uint32_t)bytes[3] << 24);
+    }
+
+    uint32_t deltaHash(uint32_t hash, const uint8_t *data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+            hash = (hash ^ data[i]) * 16777619u;
+        return hash;
+    }
+
+    DeltaPatcher::DeltaPatcher(DeltaSourceReader reader, DeltaTargetWriter writer, void *context)
+    {
+        this->reader = reader;
+        this->writer = writer;
+        this->context = context;
+
+        state = delta_header;
+        lastError = NULL;
+        fieldUsed = 0;
+        checkSource = false;
+        expectedSize = 0;
+        expectedHash = 0;
+        source = 0;
+        sourceDigest = 0;
+        target = 0;
+        produced = 0;
+        addRemaining = 0;
+    }
+
+    /**
+     * @brief Only accept a patch made against this source
+     *
+     * Call before the first feed(). The header is checked as soon as it's
+     * all arrived, so a patch for other firmware fails before anything is
+     * written.
+     */
+    void DeltaPatcher::expectSource(uint32_t size, uint32_t hash)
+    {
+        checkSource = true;
+        expectedSize = size;
+        expectedHash = hash;
+    }
+
+    /**
+     * @brief Feed the next piece of the patch
+     *
+     * Pieces can be any size and split anywhere, including in the middle of
+     * an operation.
+     *
+     * @return false if the patch is bad or the source/target callbacks failed
+     */
+    bool DeltaPatcher::feed(const uint8_t *data, size_t length)
+    {
+        while (length > 0)
+        {
+            switch (state)
+            {
+            case delta_header:
+                if (!gather(&data, &length, OTA_DELTA_HEADER_SIZE))
+                    return true;
+                if (memcmp(field, OTA_DELTA_MAGIC, 4) != 0)
+                    return fail("not a delta patch");
+                source = readLittleEndian(field + 4);
+                target = readLittleEndian(field + 8);
+                sourceDigest = readLittleEndian(field + 12);
+                if (checkSource && (source != expectedSize || sourceDigest != expectedHash))
+                    return fail("patch was made against different firmware");
+                state = delta_opcode;
+                finishIfComplete();
+                break;
+
+            case delta_opcode:
+                if (*data == OTA_DELTA_COPY)
+                    state = delta_copy_arguments;
+                else if (*data == OTA_DELTA_ADD)
+                    state = delta_add_length;
+                else
+                    return fail("unknown operation");
+                data++;
+                length--;
+                break;
+
+            case delta_copy_arguments:
+                if (!gather(&data, &length, 8))
+                    return true;
+                if (!copy(readLittleEndian(field), readLittleEndian(field + 4)))
+                    return false;
+                state = delta_opcode;
+                finishIfComplete();
+                break;
+
+            case delta_add_length:
+                if (!gather(&data, &length, 4))
+                    return true;
+                addRemaining = readLittleEndian(field);
+                if (addRemaining > target - produced)
+                    return fail("add runs past the end of the target");
+                state = addRemaining > 0 ? delta_add_data : delta_opcode;
+                break;
+
+            case delta_add_data:
+            {
+                size_t chunk = length < addRemaining ? length : addRemaining;
+                if (!emit(data, chunk))
+                    return false;
+                data += chunk;
+                length -= chunk;
+                addRemaining -= chunk;
+                if (addRemaining == 0)
+                {
+                    state = delta_opcode;
+                    finishIfComplete();
+                }
+                break;
+            }
+
+            case delta_done:
+                return fail("data after the end of the patch");
+
+            case delta_failed:
+                return false;
+            }
+        }
+
+        return state != delta_failed;
+    }
+
+    // Collect a fixed size field, which might be split across calls to feed()
+    bool DeltaPatcher::gather(const uint8_t **data, size_t *length, uint8_t wanted)
+    {
+        size_t chunk = wanted - fieldUsed;
+        if (chunk > *length)
+            chunk = *length;
+
+        memcpy(field + fieldUsed, *data, chunk);
+        fieldUsed += chunk;
+        *data += chunk;
+        *length -= chunk;
+
+        if (fieldUsed < wanted)
+            return false;
+
+        fieldUsed = 0;
+        return true;
+    }
+
+    bool DeltaPatcher::copy(uint32_t offset, uint32_t length)
+    {
+        if (offset > source || length > source - offset)
+            return fail("copy reads past the end of the source");
+        if (length > target - produced)
+            return fail("copy runs past the end of the target");
+
+        while (length > 0)
+        {
+            size_t chunk = length < OTA_DELTA_COPY_BUFFER ? length : OTA_DELTA_COPY_BUFFER;
+            if (!reader(context, offset, copyBuffer, chunk))
+                return fail("unable to read the source");
+            if (!emit(copyBuffer, chunk))
+                return false;
+            offset += chunk;
+            length -= chunk;
+        }
+        return true;
+    }
+
+    bool DeltaPatcher::emit(const uint8_t *data, size_t length)
+    {
+        if (!writer(context, data, length))
+            return fail("unable to write the target");
+        produced += length;
+        return true;
+    }
+
+    bool DeltaPatcher::fail(const char *why)
+    {
+        state = delta_failed;
+        lastError = why;
+        return false;
+    }
+
+    void DeltaPatcher::finishIfComplete()
+    {
+        if (produced == target)
+            state = delta_done;
+    }
+
+    bool DeltaPatcher::finished()
+    {
+        return state == delta_done;
+    }
+
+    bool DeltaPatcher::failed()
+    {
+        return state == delta_failed;
+    }
+
+    const char *DeltaPatcher::error()
+    {
+        return lastError;
+    }
+
+    uint32_t DeltaPatcher::sourceSize()
+    {
+        return source;
+    }
+
+    uint32_t DeltaPatcher::sourceHash()
+    {
+        return sourceDigest;
+    }
+
+    uint32_t DeltaPatcher::targetSize()
+    {
+        return target;
+    }
+
+    uint32_t DeltaPatcher::written()
+    {
+        return produced;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+/*
+    Binary delta patches against the running firmware
+
+    This file is plain C++ on purpose (no Arduino.h) so the exact same
+    applier that runs on the device can be built on the host by the tools
+    that generate the patches.
+
+    A patch is a 16 byte header followed by a stream of operations:
+
+        header:  "CDLT" | source size (u32) | target size (u32) | source hash (u32)
+        copy:    'C' | source offset (u32) | length (u32)
+        add:     'A' | length (u32) | length bytes of new data
+
+    All integers are little endian. Operations write the target in order,
+    so the applier never needs more than one small buffer.
+
+    The source hash is deltaHash() over the source size bytes of firmware
+    the patch was made against. A patch applied to anything else would
+    build garbage, so when the applier is told what it's patching with
+    expectSource() it turns away a header that doesn't match before
+    writing anything.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OTA_DELTA_MAGIC "CDLT"
+#define OTA_DELTA_HEADER_SIZE 16
+#define OTA_DELTA_COPY 'C'
+#define OTA_DELTA_ADD 'A'
+#define OTA_DELTA_COPY_BUFFER 1024
+#define OTA_DELTA_HASH_START 2166136261u
+
+namespace creatures
+{
+
+    // Read bytes from the firmware the patch was made against
+    typedef bool (*DeltaSourceReader)(void *context, uint32_t offset, uint8_t *buffer, size_t length);
+
+    // Write the next bytes of the new firmware
+    typedef bool (*DeltaTargetWriter)(void *context, const uint8_t *data, size_t length);
+
+    // FNV-1a, start with OTA_DELTA_HASH_START and feed it the source in pieces
+    uint32_t deltaHash(uint32_t hash, const uint8_t *data, size_t length);
+
+    enum DeltaPatcherState
+    {
+        delta_header,
+        delta_opcode,
+        delta_copy_arguments,
+        delta_add_length,
+        delta_add_data,
+        delta_done,
+        delta_failed
+    };
+
+    /**
+     * @brief Applies a delta patch that arrives in arbitrary sized pieces
+     */
+    class DeltaPatcher
+    {
+
+    public:
+        DeltaPatcher(DeltaSourceReader reader, DeltaTargetWriter writer, void *context);
+
+        void expectSource(uint32_t size, uint32_t hash);
+        bool feed(const uint8_t *data, size_t length);
+
+        bool finished();
+        bool failed();
+        const char *error();
+
+        uint32_t sourceSize();
+        uint32_t sourceHash();
+        uint32_t targetSize();
+        uint32_t written();
+
+    private:
+        bool gather(const uint8_t **data, size_t *length, uint8_t wanted);
+        bool copy(uint32_t offset, uint32_t length);
+        bool emit(const uint8_t *data, size_t length);
+        bool fail(const char *why);
+        void finishIfComplete();
+
+        DeltaSourceReader reader;
+        DeltaTargetWriter writer;
+        void *context;
+
+        DeltaPatcherState state;
+        const char *lastError;
+
+        uint8_t field[OTA_DELTA_HEADER_SIZE]; // Fixed size fields can be split across feeds
+        uint8_t fieldUsed;
+
+        bool checkSource;
+        uint32_t expectedSize;
+        uint32_t expectedHash;
+
+        uint32_t source;
+        uint32_t sourceDigest;
+        uint32_t target;
+        uint32_t produced;
+        uint32_t addRemaining;
+
+        uint8_t copyBuffer[OTA_DELTA_COPY_BUFFER];
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+/*
+    The wire format for streaming OTA. Plain C++ so tools/ota-push can
+    share it.
+
+    tools/ota-push connects to OTA_PORT and sends an OtaHeader followed by
+    payloadSize bytes of image. The image is either the raw firmware, the
+    firmware zlib compressed, or a zlib compressed delta patch against the
+    firmware that's running now (see ota-delta.h). It's unpacked straight
+    into the inactive partition OTA_CHUNK_SIZE bytes at a time, yielding
+    between chunks so the display keeps up.
+
+    Nobody gets to write the partition without the shared secret (OTA_SECRET,
+    from the environment on both ends). As soon as a connection comes in the
+    display sends OTA_NONCE_SIZE random bytes, and the header has to carry
+    HMAC-SHA256(secret, nonce | header with auth zeroed). The header has the
+    MD5 of the unpacked firmware in it, so a payload that's been tampered
+    with fails Update.end() and never gets booted. A fresh nonce each time
+    means a header that's been overheard can't be sent again.
+
+    A delta also says which firmware it was made against, and the display
+    checks that against the running partition before it starts.
+*/
+
+#include <stdint.h>
+
+#define OTA_PORT 3233
+#define OTA_CHUNK_SIZE 4096
+#define OTA_MAGIC "COTA"
+#define OTA_NONCE_SIZE 16
+#define OTA_AUTH_SIZE 32
+
+enum OtaFormat
+{
+    ota_format_raw = 0,
+    ota_format_deflate = 1,
+    ota_format_delta = 2
+};
+
+struct OtaHeader
+{
+    char magic[4];
+    uint8_t format;
+    uint8_t reserved[3];
+    uint32_t payloadSize; // Bytes that follow the header on the wire
+    uint32_t imageSize;   // Bytes of firmware once it's been unpacked
+    char md5[32];         // Of the unpacked firmware, in hex
+    uint32_t sourceSize;  // For a delta, the firmware it was made against
+    uint32_t sourceHash;  // deltaHash() of those sourceSize bytes
+    uint8_t auth[OTA_AUTH_SIZE];
+} __attribute__((packed));
@@ -1,10 +1,8 @@
-
-
 /**
  * @file ota.c
  * @author Bunny (bunny@bunnynet.org)
  * @brief Provides a way to update over the air
- * @version 0.1
+ * @version 0.2
  * @date 2022-02-12
  *
  * @copyright Copyright (c) 2022
@@ -12,31 +10,76 @@
  */
 
 #include <Arduino.h>
-#include <ArduinoOTA.h>
+#include <Update.h>
+#include <WiFi.h>
 
 extern "C"
 {
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_system.h"
+#include "mbedtls/md.h"
+
+// The inflater lives in ROM, no need to link another copy
+#if CONFIG_IDF_TARGET_ESP32S2
+#include "esp32s2/rom/miniz.h"
+#else
+#include "rom/miniz.h"
+#endif
 }
 
 #include "ota.h"
+#include "ota-delta.h"
+#include "screen.h"
 #include "logging/logging.h"
 
+using namespace creatures;
+
+// From the environment at build time, see platformio.ini. Without one
+// every update is turned away.
+#ifndef OTA_SECRET
+#define OTA_SECRET ""
+#endif
+
+// The display belongs to the pipeline task, these hand it what to draw
+extern void show_ota_progress(uint8_t percent);
+extern void show_system_message(const char *text);
+
 static creatures::Logger l;
 
+static String otaHostname;
+static WiFiServer *otaServer;
+
+// Everything needed while an update is in flight
+struct OtaSession
+{
+    OtaHeader header;
+    uint32_t received;
+    uint8_t lastPercent;
+
+    tinfl_decompressor *inflator;
+    uint8_t *dictionary; // tinfl needs the last 32k of output to hand
+    size_t dictionaryOffset;
+
+    DeltaPatcher *patcher;
+    const esp_partition_t *running;
+};
+
 void setup_ota(String hostname)
 {
     ESP_LOGV(OTA_TAG, "Prepping for OTA setup");
 
-    ArduinoOTA.setHostname(hostname.c_str());
+    otaHostname = hostname;
 
-    l.info("OTA configured for %s.local", hostname);
+    l.info("OTA configured for %s.local", hostname.c_str());
 }
 
 void start_ota()
 {
-    ArduinoOTA.begin();
+    otaServer = new WiFiServer(OTA_PORT);
+    otaServer->begin();
 
     TaskHandle_t creatureOTATaskHandle;
     xTaskCreate(creatureOTATask,
@@ -46,23 +89,320 @@ void start_ota()
                 1,
                 &creatureOTATaskHandle);
 
-    l.info("OTA ready");
+    if (strlen(OTA_SECRET) == 0)
+        l.warning("no OTA_SECRET was built in, updates will be turned away");
+
+    l.info("OTA ready on %s.local:%d", otaHostname.c_str(), OTA_PORT);
+}
+
+static bool readFully(WiFiClient *client, uint8_t *buffer, size_t length)
+{
+    size_t got = 0;
+    unsigned long lastProgress = millis();
+
+    while (got < length)
+    {
+        if (!client->connected() && client->available() == 0)
+            return false;
+
+        int chunk = client->read(buffer + got, length - got);
+        if (chunk > 0)
+        {
+            got += chunk;
+            lastProgress = millis();
+        }
+        else
+        {
+            if (millis() - lastProgress > 10000)
+                return false;
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+    }
+    return true;
+}
+
+static bool writeFirmware(void *context, const uint8_t *data, size_t length)
+{
+    return Update.write((uint8_t *)data, length) == length;
+}
+
+static bool readRunningFirmware(void *context, uint32_t offset, uint8_t *buffer, size_t length)
+{
+    OtaSession *session = (OtaSession *)context;
+    return esp_partition_read(session->running, offset, buffer, length) == ESP_OK;
 }
 
 /**
- * @brief A task that looks for updates every few seconds
+ * @brief Was this header signed with our secret, for this connection?
  *
- * Creates a simple task that checks to see if there's a pending OTA
- * update waiting for us.
+ * The auth field has to be HMAC-SHA256 over the nonce we sent and the
+ * header with its auth field zeroed (see ota-stream.h).
  */
-portTASK_FUNCTION(creatureOTATask, pvParameters)
+static bool authentic(const OtaHeader *header, const uint8_t *nonce)
 {
+    if (strlen(OTA_SECRET) == 0)
+        return false;
+
+    uint8_t message[OTA_NONCE_SIZE + sizeof(OtaHeader)];
+    memcpy(message, nonce, OTA_NONCE_SIZE);
+    memcpy(message + OTA_NONCE_SIZE, header, sizeof(OtaHeader));
+    memset(message + OTA_NONCE_SIZE + offsetof(OtaHeader, auth), 0, OTA_AUTH_SIZE);
+
+    uint8_t expected[OTA_AUTH_SIZE];
+    if (mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                        (const uint8_t *)OTA_SECRET, strlen(OTA_SECRET),
+                        message, sizeof(message),
+                        expected) != 0)
+        return false;
+
+    // Look at every byte, so how long this takes doesn't say how close a guess was
+    uint8_t difference = 0;
+    for (int i = 0; i < OTA_AUTH_SIZE; i++)
+        difference |= expected[i] ^ header->auth[i];
+    return difference == 0;
+}
+
+// Is the firmware a delta was made against the firmware that's running?
+static bool runningFirmwareMatches(OtaSession *session, uint8_t *chunk)
+{
+    const OtaHeader *header = &session->header;
+    if (header->sourceSize > session->running->size)
+        return false;
+
+    uint32_t hash = OTA_DELTA_HASH_START;
+    for (uint32_t offset = 0; offset < header->sourceSize; offset += OTA_CHUNK_SIZE)
+    {
+        size_t length = header->sourceSize - offset;
+        if (length > OTA_CHUNK_SIZE)
+            length = OTA_CHUNK_SIZE;
+
+        if (esp_partition_read(session->running, offset, chunk, length) != ESP_OK)
+            return false;
+        hash = deltaHash(hash, chunk, length);
+
+        vTaskDelay(1);
+    }
+
+    return hash == header->sourceHash;
+}
+
+// Hand unpacked bytes to whatever is building the new image
+static bool consumeImage(OtaSession *session, const uint8_t *data, size_t length)
+{
+    if (session->patcher != NULL)
+    {
+        if (!session->patcher->feed(data, length))
+        {
+            l.error("delta patch failed: %s", session->patcher->error());
+            return false;
+        }
+        return true;
+    }
+
+    return writeFirmware(session, data, length);
+}
+
+static bool inflateChunk(OtaSession *session, const uint8_t *data, size_t length, bool moreInput)
+{
+    mz_uint32 flags = TINFL_FLAG_PARSE_ZLIB_HEADER;
+    if (moreInput)
+        flags |= TINFL_FLAG_HAS_MORE_INPUT;
+
     for (;;)
     {
-        l.verbose("Checking for pending updates");
+        size_t in = length;
+        size_t out = TINFL_LZ_DICT_SIZE - session->dictionaryOffset;
+
+        tinfl_status status = tinfl_decompress(session->inflator,
+                                               data,
+                                               &in,
+                                               session->dictionary,
+                                               session->dictionary + session->dictionaryOffset,
+                                               &out,
+                                               flags);
+        data += in;
+        length -= in;
 
-        ArduinoOTA.handle();
+        if (out > 0)
+        {
+            if (!consumeImage(session, session->dictionary + session->dictionaryOffset, out))
+                return false;
+            session->dictionaryOffset = (session->dictionaryOffset + out) & (TINFL_LZ_DICT_SIZE - 1);
+        }
 
+        if (status < TINFL_STATUS_DONE)
+        {
+            l.error("unable to inflate the update: %d", status);
+            return false;
+        }
+        if (status == TINFL_STATUS_DONE)
+            return true;
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && length == 0)
+            return true;
+    }
+}
+
+static void showProgress(OtaSession *session)
+{
+    uint8_t percent = (uint64_t)session->received * 100 / session->header.payloadSize;
+    if (percent != session->lastPercent)
+    {
+        session->lastPercent = percent;
+        show_ota_progress(percent);
+    }
+}
+
+static bool receiveUpdate(WiFiClient *client, OtaSession *session, uint8_t *chunk)
+{
+    uint8_t nonce[OTA_NONCE_SIZE];
+    esp_fill_random(nonce, OTA_NONCE_SIZE);
+    if (client->write(nonce, OTA_NONCE_SIZE) != OTA_NONCE_SIZE)
+        return false;
+
+    if (!readFully(client, (uint8_t *)&session->header, sizeof(OtaHeader)) ||
+        memcmp(session->header.magic, OTA_MAGIC, 4) != 0)
+    {
+        l.error("not an update, ignoring it");
+        return false;
+    }
+
+    OtaHeader *header = &session->header;
+    if (!authentic(header, nonce))
+    {
+        l.warning("update from %s wasn't signed with our secret, ignoring it",
+                  client->remoteIP().toString().c_str());
+
+        // Slow down anyone guessing
         vTaskDelay(pdMS_TO_TICKS(2000));
+        return false;
+    }
+
+    l.info("incoming update: format %d, %lu bytes on the wire, %lu bytes of firmware",
+           header->format, header->payloadSize, header->imageSize);
+
+    if (header->format != ota_format_raw)
+    {
+        session->inflator = (tinfl_decompressor *)ps_malloc(sizeof(tinfl_decompressor));
+        session->dictionary = (uint8_t *)ps_malloc(TINFL_LZ_DICT_SIZE);
+        if (session->inflator == NULL || session->dictionary == NULL)
+        {
+            l.error("no memory for the inflater");
+            return false;
+        }
+        tinfl_init(session->inflator);
+    }
+
+    if (header->format == ota_format_delta)
+    {
+        session->running = esp_ota_get_running_partition();
+        if (!runningFirmwareMatches(session, chunk))
+        {
+            l.error("delta was made against different firmware than what's running, ignoring it");
+            return false;
+        }
+
+        // The patch says what it was made against too, and that has to agree
+        session->patcher = new DeltaPatcher(readRunningFirmware, writeFirmware, session);
+        session->patcher->expectSource(header->sourceSize, header->sourceHash);
+    }
+
+    if (!Update.begin(header->imageSize, U_FLASH))
+    {
+        l.error("unable to start the update: %s", Update.errorString());
+        return false;
+    }
+
+    char md5[33];
+    memcpy(md5, header->md5, 32);
+    md5[32] = '\0';
+    Update.setMD5(md5);
+
+    while (session->received < header->payloadSize)
+    {
+        size_t wanted = header->payloadSize - session->received;
+        if (wanted > OTA_CHUNK_SIZE)
+            wanted = OTA_CHUNK_SIZE;
+
+        if (!readFully(client, chunk, wanted))
+        {
+            l.error("lost the connection after %lu bytes", session->received);
+            return false;
+        }
+        session->received += wanted;
+
+        bool ok = header->format == ota_format_raw
+                      ? consumeImage(session, chunk, wanted)
+                      : inflateChunk(session, chunk, wanted, session->received < header->payloadSize);
+        if (!ok)
+            return false;
+
+        showProgress(session);
+
+        // Let the clock and the events have a turn between chunks
+        vTaskDelay(1);
+    }
+
+    if (session->patcher != NULL && !session->patcher->finished())
+    {
+        l.error("delta patch ended early at %lu bytes", session->patcher->written());
+        return false;
+    }
+
+    if (!Update.end())
+    {
+        l.error("update didn't verify: %s", Update.errorString());
+        return false;
     }
-}
\ No newline at end of file
+
+    return true;
+}
+
+/**
+ * @brief A task that waits for someone to push an update to us
+ *
+ * Runs at a low priority and yields after every chunk, so a slow upload
+ * doesn't stop the rest of the display from working.
+ */
+portTASK_FUNCTION(creatureOTATask, pvParameters)
+{
+    for (;;)
+    {
+        WiFiClient client = otaServer->available();
+        if (!client)
+        {
+            vTaskDelay(pdMS_TO_TICKS(500));
+            continue;
+        }
+
+        l.info("update connection from %s", client.remoteIP().toString().c_str());
+
+        OtaSession session;
+        memset(&session, 0, sizeof(OtaSession));
+        uint8_t *chunk = (uint8_t *)malloc(OTA_CHUNK_SIZE);
+
+        bool ok = chunk != NULL && receiveUpdate(&client, &session, chunk);
+
+        free(chunk);
+        free(session.inflator);
+        free(session.dictionary);
+        delete session.patcher;
+
+        if (ok)
+        {
+            client.print("OK\n");
+            client.stop();
+
+            l.info("update complete, restarting");
+            show_system_message("Update done!");
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            ESP.restart();
+        }
+
+        if (Update.isRunning())
+            Update.abort();
+
+        client.print("ERR\n");
+        client.stop();
+        show_ota_progress(OTA_PROGRESS_FAILED);
+    }
+}
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <Arduino.h>
-#include <ArduinoOTA.h>
 
 extern "C"
 {
@@ -9,10 +8,12 @@ extern "C"
 #include "freertos/timers.h"
 }
 
+#include "ota-stream.h"
+
 void setup_ota(String hostname);
 void start_ota();
 
 /**
- * @brief A task to check for pending updates in a loop
+ * @brief A task that waits for an update to be pushed to us
  */
 portTASK_FUNCTION_PROTO( creatureOTATask, pvParameters );
@@ -0,0 +1,409 @@
+#include <Arduino.h>
+
+#include "screen.h"
+
+namespace creatures
+{
+
+    static Logger l = Logger();
+
+    static const char *pageTitles[PAGE_COUNT] = {
+        NULL, // The overview is all widgets
+        "Room Temperatures",
+        "Power Use, Last 24 Hours",
+    };
+
+    /**
+     * @brief Make a full screen canvas for every page
+     *
+     * These are too big for internal RAM, malloc() puts them in PSRAM. If
+     * one can't be made the widgets on that page go straight to the panel
+     * like they used to.
+     */
+    void TouchDisplay::createPages()
+    {
+        size_t bytes = 0;
+        for (int page = 0; page < PAGE_COUNT; page++)
+        {
+            pages[page] = new GFXcanvas16(SCREEN_WIDTH, SCREEN_HEIGHT);
+            if (pages[page]->getBuffer() == NULL)
+            {
+                l.error("no memory for page %d, it won't be cached", page);
+                delete pages[page];
+                pages[page] = NULL;
+                continue;
+            }
+            bytes += SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t);
+
+            clearPage((DashboardPage)page);
+        }
+
+        l.info("page cache: %d pages, %d bytes", PAGE_COUNT, bytes);
+    }
+
+    // Put a page back to just its title
+    void TouchDisplay::clearPage(DashboardPage page)
+    {
+        if (pages[page] == NULL)
+            return;
+
+        pages[page]->fillScreen(BACKGROUND_COLOR);
+        if (pageTitles[page] != NULL)
+        {
+            pages[page]->setTextSize(1);
+            pages[page]->setFont(&FreeSans12pt7b);
+            pages[page]->setTextColor(PAGE_TITLE_COLOR);
+            pages[page]->setCursor(_ROOM_ROW_X, PAGE_TITLE_Y);
+            pages[page]->print(pageTitles[page]);
+        }
+        noteDirty(page, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+
+    /**
+     * @brief Where something on a page needs to be drawn
+     *
+     * Always the page's canvas, and the panel too if that page is showing.
+     *
+     * @return uint8_t how many targets there are
+     */
+    uint8_t TouchDisplay::targetsFor(DashboardPage page, Adafruit_GFX **targets)
+    {
+        uint8_t count = 0;
+        if (pages[page] != NULL)
+            targets[count++] = pages[page];
+        if (panelShows(page))
+            targets[count++] = display;
+        return count;
+    }
+
+    // Should drawing on this page go to the panel right now?
+    boolean TouchDisplay::panelShows(DashboardPage page)
+    {
+        return page == visiblePage && !asleep && !rebuilding;
+    }
+
+    // Draw a widget's canvas onto its page
+    void TouchDisplay::blit(DashboardPage page, int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color)
+    {
+#ifdef SMOOTH_TEXT
+        if (coverage->supersample(canvas))
+        {
+            blitCoverage(page, x, y, blendTables.prepare(color, BACKGROUND_COLOR));
+            return;
+        }
+#endif
+
+        Adafruit_GFX *targets[2];
+        uint8_t targetCount = targetsFor(page, targets);
+        for (uint8_t i = 0; i < targetCount; i++)
+        {
+            targets[i]->drawBitmap(x,
+                                   y,
+                                   canvas->getBuffer(),
+                                   canvas->width(),
+                                   canvas->height(),
+                                   color,
+                                   BACKGROUND_COLOR);
+        }
+
+        noteDirty(page, x, y, canvas->width(), canvas->height());
+    }
+
+    // Draw a widget that's on every page, like the clock
+    void TouchDisplay::blitEverywhere(int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color)
+    {
+#ifdef SMOOTH_TEXT
+        // Only work out the coverage once
+        if (coverage->supersample(canvas))
+        {
+            const uint16_t *colors = blendTables.prepare(color, BACKGROUND_COLOR);
+            for (int page = 0; page < PAGE_COUNT; page++)
+                blitCoverage((DashboardPage)page, x, y, colors);
+            return;
+        }
+#endif
+
+        for (int page = 0; page < PAGE_COUNT; page++)
+            blit((DashboardPage)page, x, y, canvas, color);
+    }
+
+    /**
+     * @brief Draw the coverage canvas through a blend table
+     *
+     * Straight into the page's buffer, and a row at a time to the panel in
+     * one address window. Anything past the edge of the screen is clipped.
+     */
+    void TouchDisplay::blitCoverage(DashboardPage page, int16_t x, int16_t y, const uint16_t *colors)
+    {
+#ifdef SMOOTH_TEXT
+        int16_t w = min((int16_t)coverage->width(), (int16_t)(SCREEN_WIDTH - x));
+        int16_t h = min((int16_t)coverage->height(), (int16_t)(SCREEN_HEIGHT - y));
+        if (w <= 0 || h <= 0)
+            return;
+
+        if (pages[page] != NULL)
+        {
+            uint16_t *buffer = pages[page]->getBuffer();
+            for (int16_t row = 0; row < h; row++)
+                coverage->blendRow(row, w, colors, buffer + (y + row) * SCREEN_WIDTH + x);
+        }
+        noteDirty(page, x, y, w, h);
+
+        if (panelShows(page))
+        {
+            display->startWrite();
+            display->setAddrWindow(x, y, w, h);
+            for (int16_t row = 0; row < h; row++)
+            {
+                coverage->blendRow(row, w, colors, smoothRow);
+                display->writePixels(smoothRow, w);
+            }
+            display->endWrite();
+        }
+#endif
+    }
+
+    /**
+     * @brief Copy part of a page's canvas to the panel, if it's showing
+     *
+     * For things that are drawn straight into the page canvas
+     */
+    void TouchDisplay::pushRegion(DashboardPage page, int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+        noteDirty(page, x, y, w, h);
+
+        if (!panelShows(page) || pages[page] == NULL)
+            return;
+
+        uint16_t *buffer = pages[page]->getBuffer();
+
+        display->startWrite();
+        display->setAddrWindow(x, y, w, h);
+        for (int16_t row = 0; row < h; row++)
+            display->writePixels(buffer + (y + row) * SCREEN_WIDTH + x, w);
+        display->endWrite();
+    }
+
+    /**
+     * @brief Put a page on the screen
+     *
+     * The page is already drawn, so this is one bulk write of its canvas.
+     *
+     * @return unsigned long how long the flip took in microseconds
+     */
+    unsigned long TouchDisplay::showPage(DashboardPage page)
+    {
+        visiblePage = page;
+        if (asleep || pages[page] == NULL)
+            return 0;
+
+        unsigned long started = micros();
+
+        display->startWrite();
+        display->setAddrWindow(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        display->writePixels(pages[page]->getBuffer(), SCREEN_WIDTH * SCREEN_HEIGHT);
+        display->endWrite();
+
+        unsigned long took = micros() - started;
+        l.info("showing page %d, the flip took %luus", page, took);
+        return took;
+    }
+
+    DashboardPage TouchDisplay::currentPage()
+    {
+        return visiblePage;
+    }
+
+    /**
+     * @brief The cached pixels of a page, for screenshots
+     *
+     * @return NULL if the page isn't cached
+     */
+    const uint16_t *TouchDisplay::pageBuffer(DashboardPage page)
+    {
+        if (pages[page] == NULL)
+            return NULL;
+        return pages[page]->getBuffer();
+    }
+
+    /**
+     * @brief Remember that part of the visible page changed
+     *
+     * Call it once the page's canvas has been drawn on, never before. The
+     * mirror reads the canvas from another task, and if it catches a draw
+     * halfway it only sends the finished one if it's noted afterwards.
+     *
+     * Overlapping regions are merged, and once there are too many to keep
+     * track of the newest one grows to cover the rest.
+     */
+    void TouchDisplay::noteDirty(DashboardPage page, int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+        if (page != visiblePage || dirtyMutex == NULL)
+            return;
+
+        int16_t right = min((int16_t)(x + w), (int16_t)SCREEN_WIDTH);
+        int16_t bottom = min((int16_t)(y + h), (int16_t)SCREEN_HEIGHT);
+        x = max(x, (int16_t)0);
+        y = max(y, (int16_t)0);
+        if (right <= x || bottom <= y)
+            return;
+
+        xSemaphoreTake(dirtyMutex, portMAX_DELAY);
+
+        DirtyRect *merge = NULL;
+        for (uint8_t i = 0; i < dirtyCount && merge == NULL; i++)
+        {
+            DirtyRect *r = &dirtyRects[i];
+            if (x <= r->x + r->w && r->x <= right && y <= r->y + r->h && r->y <= bottom)
+                merge = r;
+        }
+
+        if (merge == NULL && dirtyCount < MIRROR_DIRTY_RECTS)
+        {
+            dirtyRects[dirtyCount++] = {x, y, (int16_t)(right - x), (int16_t)(bottom - y)};
+        }
+        else
+        {
+            if (merge == NULL)
+                merge = &dirtyRects[dirtyCount - 1];
+
+            int16_t mergedRight = max((int16_t)(merge->x + merge->w), right);
+            int16_t mergedBottom = max((int16_t)(merge->y + merge->h), bottom);
+            merge->x = min(merge->x, x);
+            merge->y = min(merge->y, y);
+            merge->w = mergedRight - merge->x;
+            merge->h = mergedBottom - merge->y;
+        }
+
+        xSemaphoreGive(dirtyMutex);
+    }
+
+    /**
+     * @brief Hand over everything that's changed, and start over
+     *
+     * @param page set to the page that's showing, if it's not the one the
+     *  caller last saw everything it knows is stale
+     * @return uint8_t how many regions were copied to rects
+     */
+    uint8_t TouchDisplay::takeDirtyRects(DirtyRect *rects, uint8_t max, DashboardPage *page)
+    {
+        if (dirtyMutex == NULL)
+            return 0;
+
+        xSemaphoreTake(dirtyMutex, portMAX_DELAY);
+
+        uint8_t count = dirtyCount < max ? dirtyCount : max;
+        memcpy(rects, dirtyRects, count * sizeof(DirtyRect));
+        dirtyCount = 0;
+        *page = visiblePage;
+
+        xSemaphoreGive(dirtyMutex);
+        return count;
+    }
+
+    void TouchDisplay::printRoomTemperature(HistorySeries room, const char *name, float temperature, HistoryStats stats)
+    {
+        l.debug("printing room temperature: %s %.1f", name, temperature);
+
+        uint8_t row = room - half_bathroom_temperature_series;
+        if (row >= ROOM_COUNT)
+            return;
+
+        roomNames[row] = name;
+        roomTemperatures[row] = temperature;
+        roomStats[row] = stats;
+        haveRoom[row] = true;
+        if (asleep)
+        {
+            skippedRenders++;
+            return;
+        }
+
+        unsigned long started = micros();
+        drawRoomRow(row);
+        noteRender(widget_room, started);
+    }
+
+    void TouchDisplay::drawRoomRow(uint8_t row)
+    {
+        if (!haveRoom[row])
+            return;
+
+        roomCanvas->setTextSize(1);
+        roomCanvas->setFont(&FreeSans12pt7b);
+
+        roomCanvas->setCursor(0, 24);
+        roomCanvas->print(roomNames[row]);
+
+        roomCanvas->setCursor(_ROOM_VALUE_X, 24);
+        roomCanvas->printf("%.1fF", roomTemperatures[row]);
+
+        if (roomStats[row].count > 0)
+        {
+            roomCanvas->setCursor(_ROOM_VALUE_X + 100, 24);
+            roomCanvas->printf("%.0f / %.0f", roomStats[row].min, roomStats[row].max);
+        }
+
+        blit(page_rooms, _ROOM_ROW_X, _ROOM_ROW_Y + row * _ROOM_ROW_HEIGHT, roomCanvas, ROOM_COLOR);
+
+        // Get ready for the next pass
+        roomCanvas->fillScreen(BACKGROUND_COLOR);
+    }
+
+    /**
+     * @brief Draw the power history sparkline and its stats
+     *
+     * Each column is the peak of the samples it covers, newest on the right.
+     *
+     * @param samples oldest first
+     */
+    void TouchDisplay::printPowerHistory(const float *samples, uint16_t count, HistoryStats stats)
+    {
+        l.debug("printing power history: %d samples", count);
+
+        if (asleep || count == 0)
+            return;
+
+        unsigned long started = micros();
+
+        GFXcanvas16 *page = pages[page_power];
+        if (page != NULL)
+        {
+            page->fillRect(_POWER_GRAPH_X, _POWER_GRAPH_Y, _POWER_GRAPH_WIDTH, _POWER_GRAPH_HEIGHT, BACKGROUND_COLOR);
+
+            float range = stats.max - stats.min;
+            if (range < 1.0f)
+                range = 1.0f;
+
+            uint16_t columns = count < _POWER_GRAPH_WIDTH ? count : _POWER_GRAPH_WIDTH;
+            int16_t left = _POWER_GRAPH_X + _POWER_GRAPH_WIDTH - columns;
+            int16_t bottom = _POWER_GRAPH_Y + _POWER_GRAPH_HEIGHT - 1;
+
+            for (uint16_t column = 0; column < columns; column++)
+            {
+                uint16_t first = (uint32_t)column * count / columns;
+                uint16_t last = (uint32_t)(column + 1) * count / columns;
+
+                float peak = samples[first];
+                for (uint16_t i = first + 1; i < last; i++)
+                    if (samples[i] > peak)
+                        peak = samples[i];
+
+                int16_t height = 1 + (peak - stats.min) / range * (_POWER_GRAPH_HEIGHT - 2);
+                page->drawFastVLine(left + column, bottom - height + 1, height, POWER_GRAPH_COLOR);
+            }
+
+            pushRegion(page_power, _POWER_GRAPH_X, _POWER_GRAPH_Y, _POWER_GRAPH_WIDTH, _POWER_GRAPH_HEIGHT);
+        }
+
+        powerStatsCanvas->setTextSize(1);
+        powerStatsCanvas->setFont(&FreeSans12pt7b);
+        powerStatsCanvas->setCursor(0, 26);
+        powerStatsCanvas->printf("Low %.0fW   High %.0fW   Avg %.0fW", stats.min, stats.max, stats.mean);
+        blit(page_power, _POWER_STATS_X, _POWER_STATS_Y, powerStatsCanvas, POWER_USED_COLOR);
+
+        // Get ready for the next pass
+        powerStatsCanvas->fillScreen(BACKGROUND_COLOR);
+        noteRender(widget_power_history, started);
+    }
+}
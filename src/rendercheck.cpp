@@ -0,0 +1,280 @@
+#include <Arduino.h>
+
+#include "screen.h"
+
+namespace creatures
+{
+
+    static Logger l = Logger();
+
+    static const char *widgetNames[RENDER_WIDGET_COUNT] = {
+        "clock",
+        "temperature",
+        "wind",
+        "power used",
+        "event log",
+        "flamethrower",
+        "room",
+        "power history",
+    };
+
+    /*
+        How long each widget gets to draw, in microseconds, with its page
+        showing. That's about twice what the drawing takes on a FeatherS2
+        with the page cache in PSRAM, plus the time to push the widget to
+        the panel at 16MHz: 2 bytes a pixel and 11 for the address window,
+        so a 400x48 widget is about 19ms on the bus alone.
+    */
+    static const unsigned long renderBudgets[RENDER_WIDGET_COUNT] = {
+        23000,  // clock, onto every page, 20KB to the panel
+        13000,  // temperature, 10KB
+        19000,  // wind, 17KB
+        18000,  // power used, 15KB once it's clipped to the screen
+        33000,  // event log, timestamp, text and marker, 24KB
+        40000,  // flamethrower, 38KB
+        36000,  // room, 30KB
+        142000, // power history, graph and stats, 202KB
+    };
+
+    /*
+        What the pages should hash to after runRenderScript() on the
+        display, for the default build flags. 0 means there's no golden for
+        that page yet, and the self-test records instead of checking: it
+        logs the hash to copy in here from a good build on the display, and
+        only the budgets can fail it. The host goldens for the stand-in
+        fonts are in test/render-test.cpp.
+    */
+    static const uint32_t renderGoldens[PAGE_COUNT] = {
+        0, // page_overview
+        0, // page_rooms
+        0, // page_power
+    };
+
+    /**
+     * @brief Keep track of how long a widget takes to draw
+     *
+     * Anything over its budget is counted and logged, so slow renders show
+     * up without having to watch the panel.
+     */
+    void TouchDisplay::noteRender(RenderWidget widget, unsigned long started)
+    {
+        unsigned long took = micros() - started;
+        renderMicros += took;
+        renderCount++;
+
+        RenderStats *stats = &renderStats[widget];
+        stats->count++;
+        stats->total += took;
+        if (took > stats->worst)
+            stats->worst = took;
+
+        if (took > renderBudgets[widget])
+        {
+            stats->overBudget++;
+            l.warning("%s took %luus to draw, its budget is %luus (%lu times now)",
+                      widgetNames[widget],
+                      took,
+                      renderBudgets[widget],
+                      (unsigned long)stats->overBudget);
+        }
+    }
+
+    const RenderStats *TouchDisplay::renderStatsFor(RenderWidget widget)
+    {
+        return &renderStats[widget];
+    }
+
+    /**
+     * @brief Write a one line summary of the render timings
+     *
+     * @return int what snprintf() says
+     */
+    int TouchDisplay::describeRenderStats(char *buffer, size_t size)
+    {
+        int used = 0;
+        buffer[0] = '\0';
+
+        for (uint8_t widget = 0; widget < RENDER_WIDGET_COUNT; widget++)
+        {
+            RenderStats *stats = &renderStats[widget];
+            if (stats->count == 0 || used >= (int)size)
+                continue;
+
+            used += snprintf(buffer + used,
+                             size - used,
+                             "%s%s avg %luus worst %luus over %lu",
+                             used > 0 ? ", " : "",
+                             widgetNames[widget],
+                             (unsigned long)(stats->total / stats->count),
+                             stats->worst,
+                             (unsigned long)stats->overBudget);
+        }
+
+        return used;
+    }
+
+    /**
+     * @brief FNV-1a of everything on a page
+     *
+     * @return uint32_t 0 if the page isn't cached
+     */
+    uint32_t TouchDisplay::frameHash(DashboardPage page)
+    {
+        if (pages[page] == NULL)
+            return 0;
+
+        const uint8_t *pixels = (const uint8_t *)pages[page]->getBuffer();
+        uint32_t hash = 2166136261UL;
+        for (size_t i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t); i++)
+        {
+            hash ^= pixels[i];
+            hash *= 16777619UL;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Draw a fixed set of values into the pages
+     *
+     * Covers every widget that goes through the page cache, including text
+     * that has to drop a font size or get cut short. The error and system
+     * message screens go straight to the panel, so they aren't in here.
+     */
+    void TouchDisplay::runRenderScript()
+    {
+        printTime((char *)"12:34:56 PM");
+        printTime((char *)"23:59");
+
+        printTemperature(72.5);
+        printTemperature(-3.0);
+        printWindspeed(12.3);
+        printPowerUsed(1234);
+
+        printFlamethrowerMessage((char *)"Family Room flamethrower on");
+        printFlamethrowerMessage((char *)"Office flamethrower off");
+
+        addHouseEvent("01:02 AM", "Front door opened");
+        addHouseEvent("01:03 AM", "Bunny's Room is 68.5F");
+        addHouseEvent("11:59 PM", "Something with a very long name");
+        addHouseEvent("12:00 AM", "Kitchen is 71.0F");
+
+        const char *rooms[ROOM_COUNT] = {"Half Bathroom",
+                                         "Bunny's Room",
+                                         "Office",
+                                         "Family Room",
+                                         "Workshop",
+                                         "Guest Room",
+                                         "Kitchen"};
+        for (uint8_t row = 0; row < ROOM_COUNT; row++)
+        {
+            HistoryStats stats = {(uint16_t)(row * 10), 60.0f + row, 75.0f + row, 68.0f + row};
+            printRoomTemperature((HistorySeries)(half_bathroom_temperature_series + row),
+                                 rooms[row],
+                                 65.0f + row * 1.5f,
+                                 stats);
+        }
+
+        float samples[96];
+        HistoryStats power = {96, 1e9f, -1e9f, 0.0f};
+        for (uint8_t i = 0; i < 96; i++)
+        {
+            samples[i] = 200 + (i * 37) % 900;
+            power.min = min(power.min, samples[i]);
+            power.max = max(power.max, samples[i]);
+            power.mean += samples[i] / 96;
+        }
+        printPowerHistory(samples, 96, power);
+    }
+
+    // Drop every value and empty the pages, like we just booted
+    void TouchDisplay::forgetEverything()
+    {
+        haveTemperature = false;
+        haveWindspeed = false;
+        havePowerUsed = false;
+        memset(lastFlamethrowerMessage, '\0', _FLAMETHROWER_MESSAGE_LENGTH + 1);
+        memset(haveRoom, '\0', sizeof(haveRoom));
+
+        eventLog.clear();
+        eventLogSlot = 0;
+
+        for (int page = 0; page < PAGE_COUNT; page++)
+            clearPage((DashboardPage)page);
+
+        renderCount = 0;
+        renderMicros = 0;
+        memset(renderStats, '\0', sizeof(renderStats));
+    }
+
+    /**
+     * @brief Check the render path against the device's goldens and budgets
+     */
+    boolean TouchDisplay::selfTest()
+    {
+        return selfTest(renderGoldens);
+    }
+
+    /**
+     * @brief Check the render path against known good frames and budgets
+     *
+     * The script is drawn once per page with that page on the panel, so
+     * every widget's time includes pushing it to the panel when it's on
+     * the page that's showing. Everything is cleared again afterwards, so
+     * this needs to run before any real values come in.
+     *
+     * @param goldens what each page should hash to. For a page without one
+     *  (0) the hash is only logged, so it can be recorded from a good
+     *  build.
+     * @return false if a page didn't match or a widget went over budget
+     */
+    boolean TouchDisplay::selfTest(const uint32_t *goldens)
+    {
+        l.info("running the render self-test");
+
+        boolean passed = true;
+        DashboardPage shown = visiblePage;
+
+        for (int page = 0; page < PAGE_COUNT; page++)
+        {
+            forgetEverything();
+            showPage((DashboardPage)page);
+            runRenderScript();
+
+            uint32_t hash = frameHash((DashboardPage)page);
+            if (goldens[page] == 0)
+            {
+                l.warning("page %d hashes to 0x%08x, record it as its golden if the page looks right",
+                          page,
+                          hash);
+            }
+            else if (hash != goldens[page])
+            {
+                l.error("page %d hashes to 0x%08x, expected 0x%08x", page, hash, goldens[page]);
+                passed = false;
+            }
+
+            char timings[400];
+            describeRenderStats(timings, sizeof(timings));
+            l.info("page %d showing: %s", page, timings);
+
+            for (uint8_t widget = 0; widget < RENDER_WIDGET_COUNT; widget++)
+            {
+                if (renderStats[widget].overBudget > 0)
+                {
+                    l.error("%s went over its %luus budget with page %d showing, worst was %luus",
+                            widgetNames[widget],
+                            renderBudgets[widget],
+                            page,
+                            renderStats[widget].worst);
+                    passed = false;
+                }
+            }
+        }
+
+        forgetEverything();
+        showPage(shown);
+
+        l.info("render self-test %s", passed ? "passed" : "FAILED");
+        return passed;
+    }
+}
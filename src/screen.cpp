@@ -8,17 +8,44 @@ namespace creatures
 
     static Logger l = Logger();
 
+    // Biggest first, for TextLayout::fit()
+    static const GFXfont *const headlineFonts[] = {&FreeSans18pt7b, &FreeSans12pt7b};
+    static const GFXfont *const eventFonts[] = {&FreeSans12pt7b};
+
     TouchDisplay::TouchDisplay()
     {
         l.verbose("hi!");
+        eventLogSlot = 0;
+
+        memset(pages, '\0', sizeof(pages));
+        visiblePage = page_overview;
+        rebuilding = false;
+        memset(haveRoom, '\0', sizeof(haveRoom));
+        dirtyCount = 0;
+        dirtyMutex = NULL;
+
+        haveTemperature = false;
+        haveWindspeed = false;
+        havePowerUsed = false;
+        memset(lastFlamethrowerMessage, '\0', _FLAMETHROWER_MESSAGE_LENGTH + 1);
+
+        asleep = false;
+        panelPower = panel_off;
+        asleepSince = 0;
+        sleepCount = 0;
+        asleepMillis = 0;
+        skippedRenders = 0;
+        renderCount = 0;
+        renderMicros = 0;
+        memset(renderStats, '\0', sizeof(renderStats));
     }
 
     void TouchDisplay::initScreen()
     {
         display = new Adafruit_HX8357(TFT_CS, TFT_DC, TFT_RST);
 
-        powerUpDisplay();
-        display->begin();
+        startPanel();
+        panelPower = panel_on;
 
         l.debug("Screen POST: ");
         uint8_t x = display->readcommand8(HX8357_RDPOWMODE);
@@ -32,33 +59,380 @@ namespace creatures
         x = display->readcommand8(HX8357_RDDSDR);
         l.debug("  Self Diagnostic: %#04x", x);
 
+        // Create the canvases
+        errorCanvas = new GlyphCanvas(_ERROR_CANVAS_WIDTH, _ERROR_CANVAS_HEIGHT);
+        systemMessageCanvas = new GlyphCanvas(_SYSTEM_MESSAGE_CANVAS_WIDTH, _SYSTEM_MESSAGE_CANVAS_HEIGHT);
+        clockCanvas = new GlyphCanvas(_CLOCK_CANVAS_WIDTH, _CLOCK_CANVAS_HEIGHT);
+        temperatureCanvas = new GlyphCanvas(_TEMPERATURE_CANVAS_WIDTH, _TEMPERATURE_CANVAS_HEIGHT);
+        windCanvas = new GlyphCanvas(_WIND_CANVAS_WIDTH, _WIND_CANVAS_HEIGHT);
+        powerUseCanvas = new GlyphCanvas(_POWER_USE_CANVAS_WIDTH, _POWER_USE_CANVAS_HEIGHT);
+        eventTimestampCanvas = new GlyphCanvas(_EVENT_LOG_TEXT_X - _EVENT_LOG_MARKER_WIDTH, _EVENT_LOG_LINE_HEIGHT);
+        eventLineCanvas = new GlyphCanvas(_EVENT_LOG_LINE_WIDTH - _EVENT_LOG_TEXT_X, _EVENT_LOG_LINE_HEIGHT);
+        flamethrowerCanvas = new GlyphCanvas(_FLAMETHROWER_CANVAS_WIDTH, _FLAMETHROWER_CANVAS_HEIGHT);
+        otaCanvas = new GlyphCanvas(_OTA_CANVAS_WIDTH, _OTA_CANVAS_HEIGHT);
+        roomCanvas = new GlyphCanvas(_ROOM_ROW_WIDTH, _ROOM_ROW_HEIGHT);
+        powerStatsCanvas = new GlyphCanvas(_POWER_STATS_WIDTH, _POWER_STATS_HEIGHT);
+
+        dirtyMutex = xSemaphoreCreateMutex();
+        createPages();
+
+        textLayout.addFont(&FreeSans18pt7b);
+        textLayout.addFont(&FreeSans12pt7b);
+
+#ifdef SMOOTH_TEXT
+        coverage = new CoverageCanvas(_SMOOTH_CANVAS_WIDTH, _SMOOTH_CANVAS_HEIGHT);
+        prepareBlendTables();
+#endif
+#ifdef TEXT_BENCHMARK
+        benchmarkText();
+        benchmarkGlyphs();
+#endif
+
+#ifdef RENDER_SELF_TEST
+        if (!selfTest())
+            showError("Render self-test failed!");
+#endif
+
+        l.info("set up the display!");
+    }
+
+    // Every color a widget draws in, against the background
+    void TouchDisplay::prepareBlendTables()
+    {
+#ifdef SMOOTH_TEXT
+        const uint16_t widgetColors[] = {CLOCK_COLOR,
+                                         TEMPERATURE_COLOR,
+                                         WIND_COLOR,
+                                         POWER_USED_COLOR,
+                                         EVENT_TIMESTAMP_COLOR,
+                                         HOUSE_MESSAGE_COLOR,
+                                         FLAMETHROWER_COLOR,
+                                         ROOM_COLOR};
+
+        for (uint8_t i = 0; i < sizeof(widgetColors) / sizeof(uint16_t); i++)
+            blendTables.prepare(widgetColors[i], BACKGROUND_COLOR);
+#endif
+    }
+
+    /**
+     * @brief Time the widget blit and log what the text path costs
+     *
+     * The flamethrower line is still blank when this runs, so it's black
+     * being drawn over black.
+     */
+    void TouchDisplay::benchmarkText()
+    {
+        const uint8_t passes = 10;
+        size_t oneBitBytes = ((_FLAMETHROWER_CANVAS_WIDTH + 7) / 8) * _FLAMETHROWER_CANVAS_HEIGHT;
+
+        unsigned long started = micros();
+        for (uint8_t i = 0; i < passes; i++)
+        {
+            display->drawBitmap(_FLAMETHROWER_CANVAS_X,
+                                _FLAMETHROWER_CANVAS_Y,
+                                flamethrowerCanvas->getBuffer(),
+                                _FLAMETHROWER_CANVAS_WIDTH,
+                                _FLAMETHROWER_CANVAS_HEIGHT,
+                                FLAMETHROWER_COLOR,
+                                BACKGROUND_COLOR);
+        }
+        unsigned long oneBit = (micros() - started) / passes;
+
+        l.info("text blit: 1bpp drawBitmap of a %dx%d widget (%d bytes) takes %luus",
+               _FLAMETHROWER_CANVAS_WIDTH,
+               _FLAMETHROWER_CANVAS_HEIGHT,
+               oneBitBytes,
+               oneBit);
+
+#ifdef SMOOTH_TEXT
+        const uint16_t *colors = blendTables.prepare(FLAMETHROWER_COLOR, BACKGROUND_COLOR);
+
+        started = micros();
+        for (uint8_t i = 0; i < passes; i++)
+            coverage->supersample(flamethrowerCanvas);
+        unsigned long supersample = (micros() - started) / passes;
+
+        started = micros();
+        for (uint8_t i = 0; i < passes; i++)
+            blitCoverage(page_overview, _FLAMETHROWER_CANVAS_X, _FLAMETHROWER_CANVAS_Y, colors);
+        unsigned long blend = (micros() - started) / passes;
+
+        l.info("text blit: %dbpp coverage takes %luus (%luus supersampling, %luus blend and write)",
+               COVERAGE_BITS,
+               supersample + blend,
+               supersample,
+               blend);
+        l.info("text blit: %d bytes for the shared coverage and 2x canvases and %d for the blend tables, a %dbpp canvas for this widget alone would be %d",
+               coverage->bytes(),
+               blendTables.bytes(),
+               COVERAGE_BITS,
+               oneBitBytes * COVERAGE_BITS);
+#endif
+    }
+
+    /**
+     * @brief Time some typical strings both ways through GlyphCanvas
+     *
+     * Also checks the byte copy drew the same pixels the stock path did,
+     * since a difference there would be on every widget.
+     */
+    void TouchDisplay::benchmarkGlyphs()
+    {
+        const uint8_t passes = 10;
+        const GFXfont *fonts[] = {&FreeSans18pt7b, &FreeSans12pt7b};
+        const char *fontNames[] = {"18pt", "12pt"};
+        const char *samples[] = {"12:34:56 PM", "68.5F", "12.0 MPH", "1432W", "Hallway Bathroom Motion"};
+
+        for (uint8_t f = 0; f < sizeof(fonts) / sizeof(GFXfont *); f++)
+        {
+            for (uint8_t s = 0; s < sizeof(samples) / sizeof(char *); s++)
+            {
+                unsigned long took[2];
+                uint32_t hash[2];
+
+                for (uint8_t way = 0; way < 2; way++)
+                {
+                    flamethrowerCanvas->setFastGlyphs(way == 0);
+                    flamethrowerCanvas->setTextSize(1);
+                    flamethrowerCanvas->setFont(fonts[f]);
+
+                    unsigned long started = micros();
+                    for (uint8_t i = 0; i < passes; i++)
+                    {
+                        flamethrowerCanvas->setCursor(6, 35);
+                        flamethrowerCanvas->print(samples[s]);
+                    }
+                    took[way] = (micros() - started) / passes;
+
+                    // FNV-1a over what got drawn
+                    hash[way] = 2166136261u;
+                    uint8_t *buffer = flamethrowerCanvas->getBuffer();
+                    for (size_t i = 0; i < ((_FLAMETHROWER_CANVAS_WIDTH + 7) / 8) * _FLAMETHROWER_CANVAS_HEIGHT; i++)
+                        hash[way] = (hash[way] ^ buffer[i]) * 16777619u;
+
+                    flamethrowerCanvas->fillScreen(BACKGROUND_COLOR);
+                }
+
+                l.info("glyphs: %s \"%s\" takes %luus a byte at a time, %luus a pixel at a time",
+                       fontNames[f],
+                       samples[s],
+                       took[0],
+                       took[1]);
+                if (hash[0] != hash[1])
+                    l.warning("glyphs: the byte copy drew %s \"%s\" differently!", fontNames[f], samples[s]);
+            }
+        }
+
+        flamethrowerCanvas->setFastGlyphs(true);
+    }
+
+    /**
+     * @brief Power up the panel and get it into the state we draw in
+     *
+     * Cutting LDO2 loses all of the panel's registers, so this is needed
+     * both on boot and when waking up.
+     */
+    void TouchDisplay::startPanel()
+    {
+        powerUpDisplay();
+        display->begin();
+
         wipeScreen();
 
         l.debug("setting screen rotation");
         display->setRotation(1);
-
-        // Create the canvases
-        errorCanvas = new GFXcanvas1(_ERROR_CANVAS_WIDTH, _ERROR_CANVAS_HEIGHT);
-        systemMessageCanvas = new GFXcanvas1(_SYSTEM_MESSAGE_CANVAS_WIDTH, _SYSTEM_MESSAGE_CANVAS_HEIGHT);
-        clockCanvas = new GFXcanvas1(_CLOCK_CANVAS_WIDTH, _CLOCK_CANVAS_HEIGHT);
-        temperatureCanvas = new GFXcanvas1(_TEMPERATURE_CANVAS_WIDTH, _TEMPERATURE_CANVAS_HEIGHT);
-        windCanvas = new GFXcanvas1(_WIND_CANVAS_WIDTH, _WIND_CANVAS_HEIGHT);
-        powerUseCanvas = new GFXcanvas1(_POWER_USE_CANVAS_WIDTH, _POWER_USE_CANVAS_HEIGHT);
-        houseMessageCanvas = new GFXcanvas1(_HOUSE_MESSAGE_CANVAS_WIDTH, _HOUSE_MESSAGE_CANVAS_HEIGHT);
-        flamethrowerCanvas = new GFXcanvas1(_FLAMETHROWER_CANVAS_WIDTH, _FLAMETHROWER_CANVAS_HEIGHT);
-
-        l.info("set up the display!");
     }
 
     void TouchDisplay::powerUpDisplay()
     {
         // Turn on LDO2 for the display
         l.debug("powering up the display");
-        pinMode(21, OUTPUT);
-        digitalWrite(21, HIGH);
+        pinMode(TFT_LDO, OUTPUT);
+        digitalWrite(TFT_LDO, HIGH);
 
-        l.debug("powered up, pausing for 1000ms");
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        l.debug("powered up, pausing for %dms", PANEL_POWER_SETTLE_MS);
+        vTaskDelay(pdMS_TO_TICKS(PANEL_POWER_SETTLE_MS));
+    }
+
+    void TouchDisplay::powerDownDisplay()
+    {
+        l.debug("powering down the display");
+
+        // Let the panel go to sleep politely before pulling the power
+        display->sendCommand(HX8357_DISPOFF);
+        display->sendCommand(HX8357_SLPIN);
+        vTaskDelay(pdMS_TO_TICKS(5));
+
+        digitalWrite(TFT_LDO, LOW);
+    }
+
+    /**
+     * @brief Put the panel to sleep and stop drawing
+     *
+     * The widgets keep taking updates while we're asleep, they just remember
+     * the value instead of drawing it. Safe to call every pass: if a wake
+     * is under way the panel goes back off once it's finished starting.
+     */
+    void TouchDisplay::sleep()
+    {
+        if (panelPower == panel_started)
+        {
+            l.info("display was turned off again while it was waking");
+            powerDownDisplay();
+            panelPower = panel_off;
+        }
+
+        if (asleep)
+            return;
+
+        asleep = true;
+        asleepSince = millis();
+        skippedRenders = 0;
+        powerDownDisplay();
+        panelPower = panel_off;
+
+        l.info("display is asleep");
+    }
+
+    // Powers the panel up and sets it up, then goes away
+    void TouchDisplay::panelWakeTask(void *parameter)
+    {
+        TouchDisplay *screen = (TouchDisplay *)parameter;
+
+        unsigned long started = millis();
+        screen->startPanel();
+        screen->panelPower = panel_started;
+        l.debug("the panel took %lums to start", millis() - started);
+
+        vTaskDelete(NULL);
+    }
+
+    /**
+     * @brief Bring the panel back and redraw everything in one pass
+     *
+     * Powering the panel up and resetting it takes the better part of a
+     * second, most of it waiting on the panel. That's done by a task of its
+     * own so the pipeline keeps going, and nothing else touches the panel
+     * while we're asleep. The display stage calls this every pass until
+     * it's done.
+     *
+     * @return true on the call that finished waking up
+     */
+    boolean TouchDisplay::wake()
+    {
+        if (panelPower == panel_off)
+        {
+            panelPower = panel_starting;
+            if (xTaskCreate(panelWakeTask, "panelWakeTask", 4096, this, 1, NULL) != pdPASS)
+            {
+                l.error("unable to start the panel, trying again");
+                panelPower = panel_off;
+            }
+            return false;
+        }
+
+        if (panelPower != panel_started)
+            return false;
+
+        panelPower = panel_on;
+        asleep = false;
+
+        // Bring all of the pages up to date, then put the visible one up in
+        // one go
+        unsigned long started = micros();
+        rebuilding = true;
+        redraw();
+        rebuilding = false;
+        showPage(visiblePage);
+        unsigned long redrawMicros = micros() - started;
+
+        unsigned long asleepFor = millis() - asleepSince;
+        unsigned long averageRender = renderCount > 0 ? renderMicros / renderCount : 0;
+        sleepCount++;
+        asleepMillis += asleepFor;
+
+        // Every second we were asleep is a clock render we didn't do, too
+        uint32_t saved = skippedRenders + asleepFor / 1000;
+        l.info("display is awake after %lus, skipped %lu renders (about %lums of CPU at %luus each), redrew in %luus",
+               asleepFor / 1000,
+               saved,
+               (unsigned long)((uint64_t)saved * averageRender / 1000),
+               averageRender,
+               redrawMicros);
+
+        char power[128];
+        describePowerStats(power, sizeof(power));
+        l.info("display power: %s", power);
+        return true;
+    }
+
+    /**
+     * @brief How long the panel has been off, and what that saved
+     *
+     * The charge is only as good as PANEL_AWAKE_MA and PANEL_ASLEEP_MA,
+     * which have to come from a meter. Without them it says so.
+     *
+     * @return int what snprintf() says
+     */
+    int TouchDisplay::describePowerStats(char *buffer, size_t size)
+    {
+        uint64_t offMillis = asleepMillis;
+        if (asleep)
+            offMillis += millis() - asleepSince;
+        unsigned long upSeconds = millis() / 1000;
+        unsigned long offSeconds = offMillis / 1000;
+
+        int used = snprintf(buffer,
+                            size,
+                            "panel off %lus of %lus (%lu%%) over %lu sleeps",
+                            offSeconds,
+                            upSeconds,
+                            upSeconds > 0 ? offSeconds * 100 / upSeconds : 0,
+                            (unsigned long)(sleepCount + (asleep ? 1 : 0)));
+        if (used >= (int)size)
+            return used;
+
+#if defined(PANEL_AWAKE_MA) && defined(PANEL_ASLEEP_MA)
+        // mA times hours, kept in mA seconds until the end
+        uint64_t savedMilliampSeconds = (uint64_t)(PANEL_AWAKE_MA - PANEL_ASLEEP_MA) * offSeconds;
+        used += snprintf(buffer + used,
+                         size - used,
+                         ", saved %lumAh at %dmA less",
+                         (unsigned long)(savedMilliampSeconds / 3600),
+                         PANEL_AWAKE_MA - PANEL_ASLEEP_MA);
+#else
+        used += snprintf(buffer + used, size - used, ", set PANEL_AWAKE_MA and PANEL_ASLEEP_MA for the charge saved");
+#endif
+        return used;
+    }
+
+    boolean TouchDisplay::isAsleep()
+    {
+        return asleep;
+    }
+
+    /**
+     * @brief Draw every widget from the last value it was given
+     *
+     * The clock isn't included. Its last value is stale by however long we
+     * slept and the clock stage will send a fresh one.
+     */
+    void TouchDisplay::redraw()
+    {
+        l.debug("redrawing everything");
+
+        if (haveTemperature)
+            printTemperature(lastTemperature);
+        if (haveWindspeed)
+            printWindspeed(lastWindspeed);
+        if (havePowerUsed)
+            printPowerUsed(lastPowerUsed);
+        if (lastFlamethrowerMessage[0] != '\0')
+            printFlamethrowerMessage(lastFlamethrowerMessage);
+        for (uint8_t row = 0; row < ROOM_COUNT; row++)
+            drawRoomRow(row);
+
+        redrawEventLog();
     }
 
     unsigned long TouchDisplay::wipeScreen()
@@ -72,6 +446,11 @@ namespace creatures
     void TouchDisplay::showError(const char *errorMessage)
     {
         l.verbose("showing error message: %s", errorMessage);
+
+        // Nobody would see it, and the panel may be starting on another task
+        if (asleep)
+            return;
+
         errorCanvas->fillScreen(BACKGROUND_COLOR);
         errorCanvas->setTextSize(1);
         errorCanvas->setFont(&FreeSans18pt7b);
@@ -90,6 +469,10 @@ namespace creatures
     void TouchDisplay::showSystemMessage(const char *systemMessage)
     {
         l.verbose("showing system message: %s", systemMessage);
+
+        if (asleep)
+            return;
+
         systemMessageCanvas->setTextSize(1);
         systemMessageCanvas->setFont(&FreeSans18pt7b);
         systemMessageCanvas->setCursor(6, 35);
@@ -111,21 +494,21 @@ namespace creatures
     {
         l.debug("printing time: %s", clockDisplay);
 
+        if (asleep)
+            return;
+
+        unsigned long started = micros();
+
         clockCanvas->setTextSize(1);
         clockCanvas->setFont(&FreeSans18pt7b);
         clockCanvas->setCursor(6, 35);
 
         clockCanvas->print(clockDisplay);
-        display->drawBitmap(_CLOCK_CANVAS_X,
-                            _CLOCK_CANVAS_Y,
-                            clockCanvas->getBuffer(),
-                            _CLOCK_CANVAS_WIDTH,
-                            _CLOCK_CANVAS_HEIGHT,
-                            CLOCK_COLOR,
-                            BACKGROUND_COLOR);
+        blitEverywhere(_CLOCK_CANVAS_X, _CLOCK_CANVAS_Y, clockCanvas, CLOCK_COLOR);
 
         // Get ready for the next pass
         clockCanvas->fillScreen(BACKGROUND_COLOR);
+        noteRender(widget_clock, started);
 
         l.verbose("done printing time");
     }
@@ -135,6 +518,16 @@ namespace creatures
 
         l.debug("printing temperature: %.1f", temperature);
 
+        lastTemperature = temperature;
+        haveTemperature = true;
+        if (asleep)
+        {
+            skippedRenders++;
+            return;
+        }
+
+        unsigned long started = micros();
+
         temperatureCanvas->setTextSize(1);
         temperatureCanvas->setFont(&FreeSans18pt7b);
         temperatureCanvas->setCursor(6, 35);
@@ -145,16 +538,11 @@ namespace creatures
         sprintf(temp, "%.1fF", temperature);
 
         temperatureCanvas->print(temp);
-        display->drawBitmap(_TEMPERATURE_CANVAS_X,
-                            _TEMPERATURE_CANVAS_Y,
-                            temperatureCanvas->getBuffer(),
-                            _TEMPERATURE_CANVAS_WIDTH,
-                            _TEMPERATURE_CANVAS_HEIGHT,
-                            TEMPERATURE_COLOR,
-                            BACKGROUND_COLOR);
+        blit(page_overview, _TEMPERATURE_CANVAS_X, _TEMPERATURE_CANVAS_Y, temperatureCanvas, TEMPERATURE_COLOR);
 
         // Get ready for the next pass
         temperatureCanvas->fillScreen(BACKGROUND_COLOR);
+        noteRender(widget_temperature, started);
 
         l.verbose("done printing temperature");
     }
@@ -163,6 +551,16 @@ namespace creatures
     {
         l.debug("printing wind speed: %.1f", speed);
 
+        lastWindspeed = speed;
+        haveWindspeed = true;
+        if (asleep)
+        {
+            skippedRenders++;
+            return;
+        }
+
+        unsigned long started = micros();
+
         windCanvas->setTextSize(1);
         windCanvas->setFont(&FreeSans18pt7b);
         windCanvas->setCursor(6, 35);
@@ -173,16 +571,11 @@ namespace creatures
         sprintf(temp, "%.1f MPH", speed);
 
         windCanvas->print(temp);
-        display->drawBitmap(_WIND_CANVAS_X,
-                            _WIND_CANVAS_Y,
-                            windCanvas->getBuffer(),
-                            _WIND_CANVAS_WIDTH,
-                            _WIND_CANVAS_HEIGHT,
-                            WIND_COLOR,
-                            BACKGROUND_COLOR);
+        blit(page_overview, _WIND_CANVAS_X, _WIND_CANVAS_Y, windCanvas, WIND_COLOR);
 
         // Get ready for the next pass
         windCanvas->fillScreen(BACKGROUND_COLOR);
+        noteRender(widget_wind, started);
 
         l.verbose("done printing wind speed");
     }
@@ -191,6 +584,16 @@ namespace creatures
     {
         l.debug("printing power use: %.1f", powerUsed);
 
+        lastPowerUsed = powerUsed;
+        havePowerUsed = true;
+        if (asleep)
+        {
+            skippedRenders++;
+            return;
+        }
+
+        unsigned long started = micros();
+
         powerUseCanvas->setTextSize(1);
         powerUseCanvas->setFont(&FreeSans18pt7b);
         powerUseCanvas->setCursor(6, 35);
@@ -201,63 +604,190 @@ namespace creatures
         sprintf(temp, "%.0fW", powerUsed);
 
         powerUseCanvas->print(temp);
-        display->drawBitmap(_POWER_USE_CANVAS_X,
-                            _POWER_USE_CANVAS_Y,
-                            powerUseCanvas->getBuffer(),
-                            _POWER_USE_CANVAS_WIDTH,
-                            _POWER_USE_CANVAS_HEIGHT,
-                            POWER_USED_COLOR,
-                            BACKGROUND_COLOR);
+        blit(page_overview, _POWER_USE_CANVAS_X, _POWER_USE_CANVAS_Y, powerUseCanvas, POWER_USED_COLOR);
 
         // Get ready for the next pass
         powerUseCanvas->fillScreen(BACKGROUND_COLOR);
+        noteRender(widget_power_used, started);
 
         l.verbose("done printing power use");
     }
 
-    void TouchDisplay::printHouseMessage(char *message)
+    /**
+     * @brief Add an event to the house event log
+     *
+     * Only the new line is drawn. It goes over the oldest line and a marker
+     * moves to it, the rest of the log stays where it is on the panel. (The
+     * HX8357 can only scroll along its native 480 pixel axis, which is side
+     * to side in the landscape rotation we run in.)
+     */
+    void TouchDisplay::addHouseEvent(const char *timestamp, const char *message)
     {
-        l.debug("printlng a house message: %s", message);
-
-        houseMessageCanvas->setTextSize(1);
-        houseMessageCanvas->setFont(&FreeSans18pt7b);
-        houseMessageCanvas->setCursor(6, 35);
-
-        houseMessageCanvas->print(message);
-        display->drawBitmap(_HOUSE_MESSAGE_CANVAS_X,
-                            _HOUSE_MESSAGE_CANVAS_Y,
-                            houseMessageCanvas->getBuffer(),
-                            _HOUSE_MESSAGE_CANVAS_WIDTH,
-                            _HOUSE_MESSAGE_CANVAS_HEIGHT,
-                            HOUSE_MESSAGE_COLOR,
-                            BACKGROUND_COLOR);
+        l.debug("adding a house event: %s %s", timestamp, message);
 
-        // Get ready for the next pass
-        houseMessageCanvas->fillScreen(BACKGROUND_COLOR);
+        const LoggedEvent *event = eventLog.add(timestamp, message);
+        if (asleep)
+        {
+            skippedRenders++;
+            return;
+        }
 
-        l.verbose("done printing house message");
+        unsigned long started = micros();
+        drawEventLine(event);
+        noteRender(widget_event_log, started);
+
+        l.verbose("done adding house event");
+    }
+
+    /**
+     * @brief Rebuild the whole event log from the ring buffer
+     *
+     * Needed after anything that wipes the screen.
+     */
+    void TouchDisplay::redrawEventLog()
+    {
+        l.debug("redrawing the event log");
+
+        eventLogSlot = 0;
+
+        Adafruit_GFX *targets[2];
+        uint8_t targetCount = targetsFor(page_overview, targets);
+        for (uint8_t i = 0; i < targetCount; i++)
+        {
+            targets[i]->fillRect(_EVENT_LOG_X,
+                                 _EVENT_LOG_Y,
+                                 _EVENT_LOG_LINE_WIDTH,
+                                 EVENT_LOG_LINES * _EVENT_LOG_LINE_HEIGHT,
+                                 BACKGROUND_COLOR);
+        }
+        noteDirty(page_overview, _EVENT_LOG_X, _EVENT_LOG_Y, _EVENT_LOG_LINE_WIDTH, EVENT_LOG_LINES * _EVENT_LOG_LINE_HEIGHT);
+
+        uint8_t lines = eventLog.count() < EVENT_LOG_LINES ? eventLog.count() : EVENT_LOG_LINES;
+        for (int age = lines - 1; age >= 0; age--)
+            drawEventLine(eventLog.recent(age));
+    }
+
+    void TouchDisplay::drawEventLine(const LoggedEvent *event)
+    {
+        uint8_t slot = eventLogSlot;
+        uint16_t y = _EVENT_LOG_Y + slot * _EVENT_LOG_LINE_HEIGHT;
+
+        eventTimestampCanvas->setTextSize(1);
+        eventTimestampCanvas->setFont(&FreeSans12pt7b);
+        eventTimestampCanvas->setCursor(0, 22);
+        eventTimestampCanvas->print(event->timestamp);
+        blit(page_overview, _EVENT_LOG_X + _EVENT_LOG_MARKER_WIDTH, y, eventTimestampCanvas, EVENT_TIMESTAMP_COLOR);
+        eventTimestampCanvas->fillScreen(BACKGROUND_COLOR);
+
+        char text[EVENT_TEXT_LENGTH + 1];
+        eventLineCanvas->setTextSize(1);
+        eventLineCanvas->setFont(textLayout.fit(event->text,
+                                                _EVENT_LOG_LINE_WIDTH - _EVENT_LOG_TEXT_X,
+                                                eventFonts,
+                                                1,
+                                                text,
+                                                sizeof(text)));
+        eventLineCanvas->setCursor(0, 22);
+        eventLineCanvas->print(text);
+        blit(page_overview, _EVENT_LOG_X + _EVENT_LOG_TEXT_X, y, eventLineCanvas, HOUSE_MESSAGE_COLOR);
+        eventLineCanvas->fillScreen(BACKGROUND_COLOR);
+
+        eventLogSlot = (slot + 1) % EVENT_LOG_LINES;
+
+        // Move the newest marker to the line we just drew
+        uint8_t previous = (slot + EVENT_LOG_LINES - 1) % EVENT_LOG_LINES;
+
+        Adafruit_GFX *targets[2];
+        uint8_t targetCount = targetsFor(page_overview, targets);
+        for (uint8_t i = 0; i < targetCount; i++)
+        {
+            targets[i]->fillRect(_EVENT_LOG_X,
+                                 _EVENT_LOG_Y + previous * _EVENT_LOG_LINE_HEIGHT,
+                                 _EVENT_LOG_MARKER_WIDTH,
+                                 _EVENT_LOG_LINE_HEIGHT,
+                                 BACKGROUND_COLOR);
+            targets[i]->fillTriangle(_EVENT_LOG_X,
+                                     y + 8,
+                                     _EVENT_LOG_X,
+                                     y + 22,
+                                     _EVENT_LOG_X + _EVENT_LOG_MARKER_WIDTH - 3,
+                                     y + 15,
+                                     HOUSE_MESSAGE_COLOR);
+        }
+        noteDirty(page_overview, _EVENT_LOG_X, _EVENT_LOG_Y, _EVENT_LOG_MARKER_WIDTH, EVENT_LOG_LINES * _EVENT_LOG_LINE_HEIGHT);
     }
 
     void TouchDisplay::printFlamethrowerMessage(char *message)
     {
         l.debug("printlng a flamethwoer message: %s", message);
 
+        if (message != lastFlamethrowerMessage)
+            strncpy(lastFlamethrowerMessage, message, _FLAMETHROWER_MESSAGE_LENGTH);
+        if (asleep)
+        {
+            skippedRenders++;
+            return;
+        }
+
+        unsigned long started = micros();
+
+        // Long room names drop to the smaller font, then get cut short
+        char text[_FLAMETHROWER_MESSAGE_LENGTH + 1];
         flamethrowerCanvas->setTextSize(1);
-        flamethrowerCanvas->setFont(&FreeSans18pt7b);
+        flamethrowerCanvas->setFont(textLayout.fit(message,
+                                                   _FLAMETHROWER_CANVAS_WIDTH - 12,
+                                                   headlineFonts,
+                                                   2,
+                                                   text,
+                                                   sizeof(text)));
         flamethrowerCanvas->setCursor(6, 35);
 
-        flamethrowerCanvas->print(message);
-        display->drawBitmap(_FLAMETHROWER_CANVAS_X,
-                            _FLAMETHROWER_CANVAS_Y,
-                            flamethrowerCanvas->getBuffer(),
-                            _FLAMETHROWER_CANVAS_WIDTH,
-                            _FLAMETHROWER_CANVAS_HEIGHT,
-                            FLAMETHROWER_COLOR,
-                            BACKGROUND_COLOR);
+        flamethrowerCanvas->print(text);
+        blit(page_overview, _FLAMETHROWER_CANVAS_X, _FLAMETHROWER_CANVAS_Y, flamethrowerCanvas, FLAMETHROWER_COLOR);
 
         // Get ready for the next pass
         flamethrowerCanvas->fillScreen(BACKGROUND_COLOR);
+        noteRender(widget_flamethrower, started);
 
         l.verbose("done printing house message");
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Show how far along an OTA update is
+     *
+     * @param percent 0-100, or OTA_PROGRESS_FAILED
+     */
+    void TouchDisplay::showOtaProgress(uint8_t percent)
+    {
+        l.debug("OTA progress: %d", percent);
+
+        if (asleep)
+            return;
+
+        otaCanvas->setTextSize(1);
+        otaCanvas->setFont(&FreeSans12pt7b);
+        otaCanvas->setCursor(0, 18);
+
+        if (percent == OTA_PROGRESS_FAILED)
+        {
+            otaCanvas->print("Update failed :(");
+        }
+        else
+        {
+            otaCanvas->printf("Updating %d%%", percent);
+            otaCanvas->drawRect(0, 26, _OTA_CANVAS_WIDTH, 12, 1);
+            otaCanvas->fillRect(2, 28, (_OTA_CANVAS_WIDTH - 4) * percent / 100, 8, 1);
+        }
+
+        display->drawBitmap(_OTA_CANVAS_X,
+                            _OTA_CANVAS_Y,
+                            otaCanvas->getBuffer(),
+                            _OTA_CANVAS_WIDTH,
+                            _OTA_CANVAS_HEIGHT,
+                            OTA_COLOR,
+                            BACKGROUND_COLOR);
+
+        // Get ready for the next pass
+        otaCanvas->fillScreen(BACKGROUND_COLOR);
+    }
+}
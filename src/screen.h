@@ -7,11 +7,16 @@
 
 #include <Adafruit_GFX.h>
 #include <Adafruit_HX8357.h>
-#include <Fonts/FreeSans12pt7b.h>
-#include <Fonts/FreeSans18pt7b.h>
 
 #include "logging/logging.h"
 
+#include "eventlog.h"
+#include "fonts.h"
+#include "glyphcanvas.h"
+#include "history.h"
+#include "smoothtext.h"
+#include "textlayout.h"
+
 #define SCREEN_WIDTH 480
 #define SCREEN_HEIGHT 320
 
@@ -45,21 +50,73 @@
 #define _POWER_USE_CANVAS_X SCREEN_WIDTH - _POWER_USE_CANVAS_WIDTH + 5
 #define _POWER_USE_CANVAS_Y 5
 
-#define _HOUSE_MESSAGE_CANVAS_WIDTH 400
-#define _HOUSE_MESSAGE_CANVAS_HEIGHT 48
-#define _HOUSE_MESSAGE_CANVAS_X 15
-#define _HOUSE_MESSAGE_CANVAS_Y 180
+// The house event log is EVENT_LOG_LINES lines tall, one canvas line at a time
+#define EVENT_LOG_LINES 3
+#define _EVENT_LOG_LINE_WIDTH 400
+#define _EVENT_LOG_LINE_HEIGHT 30
+#define _EVENT_LOG_X 15
+#define _EVENT_LOG_Y 176
+#define _EVENT_LOG_MARKER_WIDTH 10
+#define _EVENT_LOG_TEXT_X 100
 
 #define _FLAMETHROWER_CANVAS_WIDTH 400
 #define _FLAMETHROWER_CANVAS_HEIGHT 48
 #define _FLAMETHROWER_CANVAS_X 15
 #define _FLAMETHROWER_CANVAS_Y 125
+#define _FLAMETHROWER_MESSAGE_LENGTH 30
+
+// OTA progress goes in the lower left, next to the clock
+#define _OTA_CANVAS_WIDTH 250
+#define _OTA_CANVAS_HEIGHT 40
+#define _OTA_CANVAS_X 5
+#define _OTA_CANVAS_Y SCREEN_HEIGHT - _OTA_CANVAS_HEIGHT
+#define OTA_PROGRESS_FAILED 0xFF
+
+
+// The rooms page has one row per room, in HistorySeries order
+#define ROOM_COUNT (kitchen_temperature_series - half_bathroom_temperature_series + 1)
+#define _ROOM_ROW_WIDTH 460
+#define _ROOM_ROW_HEIGHT 33
+#define _ROOM_ROW_X 10
+#define _ROOM_ROW_Y 36
+#define _ROOM_VALUE_X 230
 
+// The power page is a sparkline of the whole history and a line of stats
+#define _POWER_GRAPH_WIDTH 460
+#define _POWER_GRAPH_HEIGHT 180
+#define _POWER_GRAPH_X 10
+#define _POWER_GRAPH_Y 40
+#define _POWER_STATS_WIDTH 460
+#define _POWER_STATS_HEIGHT 40
+#define _POWER_STATS_X 10
+#define _POWER_STATS_Y 226
+
+#define PAGE_TITLE_Y 26
+
+// How many changed regions we keep for the live mirror before merging them
+#define MIRROR_DIRTY_RECTS 8
+
+// Big enough for every widget that goes through blit(). Build with
+// SMOOTH_TEXT to anti-alias them.
+#define _SMOOTH_CANVAS_WIDTH 460
+#define _SMOOTH_CANVAS_HEIGHT 48
 
 // Screen pins
 #define TFT_CS 33
 #define TFT_DC 38
 #define TFT_RST 1
+#define TFT_LDO 21 // LDO2 powers the panel and the backlight
+
+// How long LDO2 gets to come up before the panel is reset. The AP2112K is
+// up in well under a millisecond; begin() does the HX8357's own reset and
+// sleep-out waits after this.
+#define PANEL_POWER_SETTLE_MS 10
+
+// What the board draws at the supply with the panel on and with it off, in
+// mA. Build with both, read off a meter with the feathers2-powertest env,
+// to have the charge the panel's sleep saved reported.
+// #define PANEL_AWAKE_MA
+// #define PANEL_ASLEEP_MA
 
 // Colors
 #define BACKGROUND_COLOR HX8357_BLACK
@@ -68,7 +125,71 @@
 #define WIND_COLOR HX8357_BLUE
 #define POWER_USED_COLOR HX8357_RED
 #define HOUSE_MESSAGE_COLOR HX8357_CYAN
+#define EVENT_TIMESTAMP_COLOR HX8357_WHITE
 #define FLAMETHROWER_COLOR HX8357_YELLOW
+#define OTA_COLOR HX8357_GREEN
+#define PAGE_TITLE_COLOR HX8357_WHITE
+#define ROOM_COLOR HX8357_CYAN
+#define POWER_GRAPH_COLOR HX8357_RED
+
+/*
+    Every page is kept fully drawn in a 16 bit canvas in PSRAM, whether it's
+    showing or not. Widgets draw into their page's canvas (and the panel,
+    if their page is up), so flipping pages is one bulk write of the canvas.
+*/
+enum DashboardPage
+{
+    page_overview,
+    page_rooms,
+    page_power,
+
+    PAGE_COUNT
+};
+
+/*
+    Widgets that keep render timings. Each one has a time budget in
+    rendercheck.cpp, and going over it gets logged and counted.
+*/
+enum RenderWidget
+{
+    widget_clock,
+    widget_temperature,
+    widget_wind,
+    widget_power_used,
+    widget_event_log,
+    widget_flamethrower,
+    widget_room,
+    widget_power_history,
+
+    RENDER_WIDGET_COUNT
+};
+
+// A part of the visible page that's changed since the mirror last looked
+struct DirtyRect
+{
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+// Where the panel's power is. Waking takes long enough to be done off the
+// pipeline task, so it goes through starting and started.
+enum PanelPower
+{
+    panel_on,
+    panel_off,
+    panel_starting, // A task is powering it up
+    panel_started   // Powered and set up, waiting for wake() to redraw
+};
+
+struct RenderStats
+{
+    uint32_t count;
+    uint32_t overBudget;
+    unsigned long worst;
+    uint64_t total;
+};
 
 namespace creatures
 {
@@ -84,23 +205,112 @@ namespace creatures
         void printTemperature(float temperature);
         void printWindspeed(float speed);
         void printPowerUsed(float powerUsed);
-        void printHouseMessage(char *message);
+        void addHouseEvent(const char *timestamp, const char *message);
+        void redrawEventLog();
         void printFlamethrowerMessage(char *message);
+        void showOtaProgress(uint8_t percent);
+        void printRoomTemperature(HistorySeries room, const char *name, float temperature, HistoryStats stats);
+        void printPowerHistory(const float *samples, uint16_t count, HistoryStats stats);
+
+        unsigned long showPage(DashboardPage page);
+        DashboardPage currentPage();
+
+        const uint16_t *pageBuffer(DashboardPage page);
+        uint8_t takeDirtyRects(DirtyRect *rects, uint8_t max, DashboardPage *page);
+
+        uint32_t frameHash(DashboardPage page);
+        boolean selfTest();
+        boolean selfTest(const uint32_t *goldens);
+        const RenderStats *renderStatsFor(RenderWidget widget);
+        int describeRenderStats(char *buffer, size_t size);
 
         void initScreen();
         unsigned long wipeScreen();
 
+        void sleep();
+        boolean wake();
+        boolean isAsleep();
+        int describePowerStats(char *buffer, size_t size);
+
     private:
+        static void panelWakeTask(void *parameter);
         void powerUpDisplay();
+        void powerDownDisplay();
+        void startPanel();
+        void redraw();
+        void noteRender(RenderWidget widget, unsigned long started);
+        void drawEventLine(const LoggedEvent *event);
+        void createPages();
+        void clearPage(DashboardPage page);
+        void runRenderScript();
+        void forgetEverything();
+        void drawRoomRow(uint8_t row);
+        boolean panelShows(DashboardPage page);
+        uint8_t targetsFor(DashboardPage page, Adafruit_GFX **targets);
+        void blit(DashboardPage page, int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color);
+        void blitEverywhere(int16_t x, int16_t y, GFXcanvas1 *canvas, uint16_t color);
+        void blitCoverage(DashboardPage page, int16_t x, int16_t y, const uint16_t *colors);
+        void prepareBlendTables();
+        void benchmarkText();   // With TEXT_BENCHMARK
+        void benchmarkGlyphs(); // With TEXT_BENCHMARK
+        void pushRegion(DashboardPage page, int16_t x, int16_t y, int16_t w, int16_t h);
+        void noteDirty(DashboardPage page, int16_t x, int16_t y, int16_t w, int16_t h);
         Adafruit_HX8357 *display;
-        GFXcanvas1 *errorCanvas;
-        GFXcanvas1 *systemMessageCanvas;
-        GFXcanvas1 *clockCanvas;
-        GFXcanvas1 *temperatureCanvas;
-        GFXcanvas1 *windCanvas;
-        GFXcanvas1 *powerUseCanvas;
-        GFXcanvas1 *houseMessageCanvas;
-        GFXcanvas1 *flamethrowerCanvas;
+        GlyphCanvas *errorCanvas;
+        GlyphCanvas *systemMessageCanvas;
+        GlyphCanvas *clockCanvas;
+        GlyphCanvas *temperatureCanvas;
+        GlyphCanvas *windCanvas;
+        GlyphCanvas *powerUseCanvas;
+        GlyphCanvas *eventLineCanvas;
+        GlyphCanvas *eventTimestampCanvas;
+        GlyphCanvas *flamethrowerCanvas;
+        GlyphCanvas *otaCanvas;
+        GlyphCanvas *roomCanvas;
+        GlyphCanvas *powerStatsCanvas;
+
+        GFXcanvas16 *pages[PAGE_COUNT];
+        DashboardPage visiblePage;
+        boolean rebuilding; // Only draw into the pages, the panel gets one flip at the end
+
+        DirtyRect dirtyRects[MIRROR_DIRTY_RECTS];
+        uint8_t dirtyCount;
+        SemaphoreHandle_t dirtyMutex;
+
+        TextLayout textLayout;
+
+#ifdef SMOOTH_TEXT
+        CoverageCanvas *coverage;
+        BlendTables blendTables;
+        uint16_t smoothRow[_SMOOTH_CANVAS_WIDTH];
+#endif
+
+        EventLog eventLog;
+        uint8_t eventLogSlot;      // The physical line the next event is drawn on
+
+        // The latest value for each widget, so we can redraw on wake
+        float lastTemperature;
+        float lastWindspeed;
+        float lastPowerUsed;
+        boolean haveTemperature;
+        boolean haveWindspeed;
+        boolean havePowerUsed;
+        char lastFlamethrowerMessage[_FLAMETHROWER_MESSAGE_LENGTH + 1];
+        float roomTemperatures[ROOM_COUNT];
+        HistoryStats roomStats[ROOM_COUNT];
+        boolean haveRoom[ROOM_COUNT];
+        const char *roomNames[ROOM_COUNT];
+
+        // Low power bookkeeping
+        volatile boolean asleep;
+        volatile PanelPower panelPower;
+        unsigned long asleepSince;
+        uint32_t sleepCount;
+        uint64_t asleepMillis; // With the panel off, over every sleep that's ended
+        uint32_t skippedRenders;
+        uint32_t renderCount;
+        uint64_t renderMicros;
+        RenderStats renderStats[RENDER_WIDGET_COUNT];
     };
 }
 
@@ -0,0 +1,221 @@
+#include <Arduino.h>
+
+#include "smoothtext.h"
+#include "logging/logging.h"
+
+namespace creatures
+{
+
+    static Logger l = Logger();
+
+    // Is this pixel of a 1 bit row lit? Off the edges is never lit.
+    static inline uint8_t lit(const uint8_t *row, int16_t x, int16_t w)
+    {
+        if (row == NULL || x < 0 || x >= w)
+            return 0;
+        return (row[x >> 3] >> (7 - (x & 7))) & 1;
+    }
+
+    CoverageCanvas::CoverageCanvas(int16_t w, int16_t h)
+    {
+        capacityWidth = w;
+        capacityHeight = h;
+        this->w = 0;
+        this->h = 0;
+
+        fine = new GFXcanvas1(w * 2, h * 2);
+        buffer = (uint8_t *)malloc(((w + 1) / 2) * h);
+        if (buffer == NULL || fine->getBuffer() == NULL)
+            l.error("no memory for a %dx%d coverage canvas", w, h);
+    }
+
+    /**
+     * @brief Work out the coverage of every pixel on a 1 bit canvas
+     *
+     * Called once per blit, it replaces whatever the last widget left
+     * here. blendRow() reads the result.
+     *
+     * @return false if the canvas is bigger than we are, use drawBitmap()
+     */
+    boolean CoverageCanvas::supersample(GFXcanvas1 *canvas)
+    {
+        if (buffer == NULL || fine->getBuffer() == NULL ||
+            canvas->width() > capacityWidth || canvas->height() > capacityHeight)
+            return false;
+
+        w = canvas->width();
+        h = canvas->height();
+
+        drawDouble(canvas);
+        boxDown();
+        return true;
+    }
+
+    /**
+     * @brief Draw a canvas at twice the size into the fine canvas
+     *
+     * Every pixel becomes four samples, like a glyph drawn at textsize 2.
+     * A sample in a corner takes the value of the two pixels beside it
+     * when they agree with each other and the pixels across from them
+     * don't (scale2x), which is what turns the steps back into edges.
+     */
+    void CoverageCanvas::drawDouble(GFXcanvas1 *canvas)
+    {
+        const uint8_t *source = canvas->getBuffer();
+        uint16_t sourceStride = (w + 7) / 8;
+        uint8_t *samples = fine->getBuffer();
+        uint16_t fineStride = (fine->width() + 7) / 8;
+
+        for (int16_t y = 0; y < h; y++)
+        {
+            const uint8_t *above = y > 0 ? source + (y - 1) * sourceStride : NULL;
+            const uint8_t *row = source + y * sourceStride;
+            const uint8_t *below = y < h - 1 ? source + (y + 1) * sourceStride : NULL;
+            uint8_t *top = samples + (2 * y) * fineStride;
+            uint8_t *bottom = top + fineStride;
+
+            for (int16_t x = 0; x < w; x++)
+            {
+                uint8_t p = lit(row, x, w);
+                uint8_t a = lit(above, x, w);
+                uint8_t b = lit(row, x + 1, w);
+                uint8_t c = lit(row, x - 1, w);
+                uint8_t d = lit(below, x, w);
+
+                uint8_t topLeft = c == a && c != d && a != b ? a : p;
+                uint8_t topRight = a == b && a != c && b != d ? b : p;
+                uint8_t bottomLeft = d == c && d != b && c != a ? c : p;
+                uint8_t bottomRight = b == d && b != a && d != c ? d : p;
+
+                // Two samples a pixel, so four pixels a byte
+                uint8_t shift = 6 - 2 * (x & 3);
+                uint8_t topBits = (topLeft << 1 | topRight) << shift;
+                uint8_t bottomBits = (bottomLeft << 1 | bottomRight) << shift;
+                uint8_t mask = 3 << shift;
+
+                top[x >> 2] = (top[x >> 2] & ~mask) | topBits;
+                bottom[x >> 2] = (bottom[x >> 2] & ~mask) | bottomBits;
+            }
+        }
+    }
+
+    // Average each 2x2 block of samples into a pixel's coverage
+    void CoverageCanvas::boxDown()
+    {
+        const uint8_t *samples = fine->getBuffer();
+        uint16_t fineStride = (fine->width() + 7) / 8;
+        uint16_t stride = (w + 1) / 2;
+
+        for (int16_t y = 0; y < h; y++)
+        {
+            const uint8_t *top = samples + (2 * y) * fineStride;
+            const uint8_t *bottom = top + fineStride;
+            uint8_t *out = buffer + y * stride;
+
+            for (int16_t x = 0; x < w; x++)
+            {
+                uint8_t shift = 6 - 2 * (x & 3);
+                uint8_t pair = (top[x >> 2] >> shift) & 3;
+                uint8_t lower = (bottom[x >> 2] >> shift) & 3;
+                uint8_t count = (pair >> 1) + (pair & 1) + (lower >> 1) + (lower & 1);
+                uint8_t coverage = (count * (COVERAGE_LEVELS - 1) + 2) / 4;
+
+                if (x & 1)
+                    out[x >> 1] |= coverage;
+                else
+                    out[x >> 1] = coverage << 4;
+            }
+        }
+    }
+
+    /**
+     * @brief Turn a row of coverage into RGB565 pixels
+     *
+     * @param colors a table from BlendTables
+     */
+    void CoverageCanvas::blendRow(int16_t y, int16_t count, const uint16_t *colors, uint16_t *out)
+    {
+        const uint8_t *row = buffer + y * ((w + 1) / 2);
+        for (int16_t x = 0; x < count; x++)
+        {
+            uint8_t packed = row[x >> 1];
+            out[x] = colors[x & 1 ? packed & 0x0F : packed >> 4];
+        }
+    }
+
+    int16_t CoverageCanvas::width()
+    {
+        return w;
+    }
+
+    int16_t CoverageCanvas::height()
+    {
+        return h;
+    }
+
+    // The map and the fine canvas
+    size_t CoverageCanvas::bytes()
+    {
+        return ((capacityWidth + 1) / 2) * capacityHeight + ((capacityWidth * 2 + 7) / 8) * capacityHeight * 2;
+    }
+
+    uint8_t *CoverageCanvas::getBuffer()
+    {
+        return buffer;
+    }
+
+    BlendTables::BlendTables()
+    {
+        tableCount = 0;
+        nextVictim = 0;
+    }
+
+    /**
+     * @brief Get the table for a color pair, making it if it's new
+     *
+     * Each channel is mixed linearly from the background at no coverage to
+     * the foreground at full coverage.
+     */
+    const uint16_t *BlendTables::prepare(uint16_t foreground, uint16_t background)
+    {
+        for (uint8_t i = 0; i < tableCount; i++)
+        {
+            if (tables[i].foreground == foreground && tables[i].background == background)
+                return tables[i].colors;
+        }
+
+        BlendTable *table;
+        if (tableCount < BLEND_TABLE_COUNT)
+        {
+            table = &tables[tableCount++];
+        }
+        else
+        {
+            l.warning("more than %d color pairs, reusing a blend table", BLEND_TABLE_COUNT);
+            table = &tables[nextVictim];
+            nextVictim = (nextVictim + 1) % BLEND_TABLE_COUNT;
+        }
+
+        table->foreground = foreground;
+        table->background = background;
+
+        int16_t fr = foreground >> 11, fg = (foreground >> 5) & 0x3F, fb = foreground & 0x1F;
+        int16_t br = background >> 11, bg = (background >> 5) & 0x3F, bb = background & 0x1F;
+        const int16_t full = COVERAGE_LEVELS - 1;
+
+        for (int16_t c = 0; c < COVERAGE_LEVELS; c++)
+        {
+            uint16_t r = (fr * c + br * (full - c) + full / 2) / full;
+            uint16_t g = (fg * c + bg * (full - c) + full / 2) / full;
+            uint16_t b = (fb * c + bb * (full - c) + full / 2) / full;
+            table->colors[c] = (r << 11) | (g << 5) | b;
+        }
+
+        return table->colors;
+    }
+
+    size_t BlendTables::bytes()
+    {
+        return sizeof(tables);
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#define COVERAGE_BITS 4
+#define COVERAGE_LEVELS (1 << COVERAGE_BITS)
+#define BLEND_TABLE_COUNT 12
+
+namespace creatures
+{
+
+    /**
+     * @brief A 4 bit per pixel coverage map of a widget
+     *
+     * The GFX fonts are 1 bit, so the widget's text is drawn again at twice
+     * the size into a 1 bit canvas, the way drawChar() does at textsize 2.
+     * At that size each stair step on a curve or diagonal is turned into the
+     * edge it stands for: the outer corner of a step loses its quarter and
+     * the inner corner gains one, and straight edges are left alone. Each
+     * pixel's coverage is then how many of its four
+     * samples are lit, so strokes keep their weight and nothing gets a halo.
+     *
+     * This runs on every blit, it's not a cache. There's one map shared by
+     * every widget, and it only holds the widget that was blitted last.
+     * Keeping a map per widget (or per string) would take about 48KB
+     * instead of 11KB, and it wouldn't save much: the clock changes every
+     * second and the rest redraw when their value changes.
+     */
+    class CoverageCanvas
+    {
+
+    public:
+        CoverageCanvas(int16_t w, int16_t h);
+
+        boolean supersample(GFXcanvas1 *canvas);
+        void blendRow(int16_t y, int16_t count, const uint16_t *colors, uint16_t *out);
+
+        int16_t width();
+        int16_t height();
+        size_t bytes();
+        uint8_t *getBuffer();
+
+    private:
+        void drawDouble(GFXcanvas1 *canvas);
+        void boxDown();
+
+        GFXcanvas1 *fine; // Twice our size, for the samples
+        uint8_t *buffer;
+        int16_t capacityWidth;
+        int16_t capacityHeight;
+        int16_t w;
+        int16_t h;
+    };
+
+    /**
+     * @brief Coverage to RGB565 lookup tables, one per fg/bg color pair
+     *
+     * Widgets only use a handful of colors, so the tables are made when the
+     * screen is laid out and a blit is one table lookup per pixel.
+     */
+    class BlendTables
+    {
+
+    public:
+        BlendTables();
+
+        const uint16_t *prepare(uint16_t foreground, uint16_t background);
+        size_t bytes();
+
+    private:
+        struct BlendTable
+        {
+            uint16_t foreground;
+            uint16_t background;
+            uint16_t colors[COVERAGE_LEVELS];
+        };
+
+        BlendTable tables[BLEND_TABLE_COUNT];
+        uint8_t tableCount;
+        uint8_t nextVictim;
+    };
+}
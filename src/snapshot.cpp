@@ -0,0 +1,251 @@
+#include <string.h>
+
+#include "snapshot.h"
+
+namespace creatures
+{
+
+    /**
+     * @brief COBS stuff a snapshot for the wire, so it has no 0x00 in it
+     *
+     * @param out at least SNAPSHOT_STUFFED_SIZE(length) bytes
+     * @return size_t how many bytes of out were used
+     */
+    size_t snapshotStuff(const uint8_t *data, size_t length, uint8_t *out)
+    {
+        size_t code = 0;
+        size_t written = 1;
+        uint8_t run = 1;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            if (data[i] != 0)
+            {
+                out[written++] = data[i];
+                run++;
+            }
+
+            // A zero ends the block, and so does a block that's full
+            if (data[i] == 0 || run == 0xFF)
+            {
+                out[code] = run;
+                code = written;
+                run = 1;
+                if (data[i] == 0 || i + 1 < length)
+                    written++;
+            }
+        }
+
+        // Unless the data ended with a full block, there's one still open
+        if (code < written)
+            out[code] = run;
+        return written;
+    }
+
+    /**
+     * @brief Undo snapshotStuff(), in place
+     *
+     * @return size_t how long the snapshot really is, or 0 if the stuffing
+     *         is broken (which is what a payload that got cut short looks like)
+     */
+    size_t snapshotUnstuff(uint8_t *buffer, size_t length)
+    {
+        size_t in = 0;
+        size_t out = 0;
+
+        while (in < length)
+        {
+            uint8_t code = buffer[in++];
+            if (code == 0 || (size_t)(code - 1) > length - in)
+                return 0;
+
+            for (uint8_t i = 1; i < code; i++)
+            {
+                if (buffer[in] == 0)
+                    return 0;
+                buffer[out++] = buffer[in++];
+            }
+
+            // Every block but a full one ends in a zero, except the last
+            if (code != 0xFF && in < length)
+                buffer[out++] = 0;
+        }
+        return out;
+    }
+
+    SnapshotReader::SnapshotReader(const uint8_t *buffer, size_t length)
+    {
+        this->buffer = buffer;
+        this->length = length;
+        position = 0;
+        fields = 0;
+        fieldsRead = 0;
+    }
+
+    /**
+     * @brief Read the array header and check the version
+     *
+     * @return false if this isn't a snapshot we understand
+     */
+    bool SnapshotReader::begin()
+    {
+        if (!take(1))
+            return false;
+
+        uint8_t marker = buffer[position - 1];
+        if ((marker & 0xF0) == 0x90)
+        {
+            fields = marker & 0x0F;
+        }
+        else if (marker == 0xDC && take(2))
+        {
+            fields = bigEndian(position - 2, 2);
+        }
+        else
+        {
+            return false;
+        }
+
+        float version;
+        bool unused;
+        return next(&version, &unused) == snapshot_number && version == SNAPSHOT_VERSION;
+    }
+
+    /**
+     * @brief Decode the next field
+     *
+     * @param number set if the field is a number
+     * @param flag set if the field is a bool
+     */
+    SnapshotValueType SnapshotReader::next(float *number, bool *flag)
+    {
+        if (fieldsRead >= fields)
+            return snapshot_end;
+        if (!take(1))
+            return snapshot_error;
+
+        fieldsRead++;
+        uint8_t marker = buffer[position - 1];
+
+        // Fixints are the whole value in one byte
+        if (marker <= 0x7F)
+        {
+            *number = marker;
+            return snapshot_number;
+        }
+        if (marker >= 0xE0)
+        {
+            *number = (int8_t)marker;
+            return snapshot_number;
+        }
+
+        switch (marker)
+        {
+        case 0xC0:
+            return snapshot_nil;
+        case 0xC2:
+        case 0xC3:
+            *flag = marker == 0xC3;
+            return snapshot_bool;
+
+        case 0xCC: // uint 8
+            if (!take(1))
+                return snapshot_error;
+            *number = buffer[position - 1];
+            return snapshot_number;
+        case 0xCD: // uint 16
+            if (!take(2))
+                return snapshot_error;
+            *number = (uint16_t)bigEndian(position - 2, 2);
+            return snapshot_number;
+        case 0xCE: // uint 32
+            if (!take(4))
+                return snapshot_error;
+            *number = bigEndian(position - 4, 4);
+            return snapshot_number;
+        case 0xD0: // int 8
+            if (!take(1))
+                return snapshot_error;
+            *number = (int8_t)buffer[position - 1];
+            return snapshot_number;
+        case 0xD1: // int 16
+            if (!take(2))
+                return snapshot_error;
+            *number = (int16_t)bigEndian(position - 2, 2);
+            return snapshot_number;
+        case 0xD2: // int 32
+            if (!take(4))
+                return snapshot_error;
+            *number = (int32_t)bigEndian(position - 4, 4);
+            return snapshot_number;
+
+        case 0xCA: // float 32
+        {
+            if (!take(4))
+                return snapshot_error;
+            uint32_t bits = bigEndian(position - 4, 4);
+            memcpy(number, &bits, 4);
+            return snapshot_number;
+        }
+        case 0xCB: // float 64
+        {
+            if (!take(8))
+                return snapshot_error;
+            uint64_t bits = ((uint64_t)bigEndian(position - 8, 4) << 32) | bigEndian(position - 4, 4);
+            double value;
+            memcpy(&value, &bits, 8);
+            *number = (float)value;
+            return snapshot_number;
+        }
+        }
+
+        return snapshot_error;
+    }
+
+    /**
+     * @brief Check the whole snapshot decodes, to exactly its own length
+     *
+     * A payload that was cut short, or has anything after it, doesn't. This
+     * walks a copy of the reader, so it can be asked before begin().
+     */
+    bool SnapshotReader::complete()
+    {
+        SnapshotReader walk(buffer, length);
+        if (!walk.begin())
+            return false;
+
+        float number;
+        bool flag;
+        SnapshotValueType type;
+        while ((type = walk.next(&number, &flag)) < snapshot_end)
+            ;
+        return type == snapshot_end && walk.consumed() == length;
+    }
+
+    uint16_t SnapshotReader::fieldCount()
+    {
+        return fields;
+    }
+
+    size_t SnapshotReader::consumed()
+    {
+        return position;
+    }
+
+    // Step over count bytes, if there are that many left
+    bool SnapshotReader::take(size_t count)
+    {
+        if (length - position < count)
+            return false;
+        position += count;
+        return true;
+    }
+
+    uint32_t SnapshotReader::bigEndian(size_t offset, uint8_t bytes)
+    {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < bytes; i++)
+            value = (value << 8) | buffer[offset + i];
+        return value;
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/*
+    Binary state snapshots
+
+    Instead of one text topic per value, a snapshot carries everything the
+    dashboard shows in one MessagePack array with a fixed layout:
+
+        [ version, outside temperature, wind speed, power use,
+          half bathroom, bunny's room, office, family room,
+          workshop, guest room, kitchen,
+          family room flamethrower, office flamethrower ]
+
+    Numbers can be any MessagePack int or float, flamethrowers are bools, and
+    nil means "no news" for that field. Extra trailing fields of those types
+    are ignored so the schema can grow.
+
+    MQTT hands the display its payloads as C strings, so on the wire the
+    snapshot is COBS stuffed to keep 0x00 out of it. That way nothing gets
+    cut short at the first zero, and the string length is the real length.
+
+    The reader walks the payload in place, one field at a time. Nothing is
+    copied or allocated. This file is plain C++ so the host aggregator can
+    use the same schema.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DISPLAY_SNAPSHOT_TOPIC "display/snapshot"
+#define SNAPSHOT_VERSION 1
+
+// The most snapshotStuff() can turn length bytes into
+#define SNAPSHOT_STUFFED_SIZE(length) ((length) + (length) / 254 + 1)
+
+enum SnapshotField
+{
+    snapshot_version,
+    snapshot_outside_temperature,
+    snapshot_outside_wind_speed,
+    snapshot_home_power_use,
+    snapshot_half_bathroom_temperature,
+    snapshot_bunnys_room_temperature,
+    snapshot_office_temperature,
+    snapshot_family_room_temperature,
+    snapshot_workshop_temperature,
+    snapshot_guest_room_temperature,
+    snapshot_kitchen_temperature,
+    snapshot_family_room_flamethrower,
+    snapshot_office_flamethrower,
+
+    SNAPSHOT_FIELD_COUNT
+};
+
+enum SnapshotValueType
+{
+    snapshot_nil,
+    snapshot_number,
+    snapshot_bool,
+    snapshot_end,   // No more fields
+    snapshot_error  // Something we don't understand, or ran off the end
+};
+
+namespace creatures
+{
+
+    size_t snapshotStuff(const uint8_t *data, size_t length, uint8_t *out);
+    size_t snapshotUnstuff(uint8_t *buffer, size_t length);
+
+    /**
+     * @brief Walks a snapshot straight out of the MQTT payload buffer
+     */
+    class SnapshotReader
+    {
+
+    public:
+        SnapshotReader(const uint8_t *buffer, size_t length);
+
+        bool begin();
+        SnapshotValueType next(float *number, bool *flag);
+        bool complete();
+
+        uint16_t fieldCount();
+        size_t consumed();
+
+    private:
+        bool take(size_t count);
+        uint32_t bigEndian(size_t offset, uint8_t bytes);
+
+        const uint8_t *buffer;
+        size_t length;
+        size_t position;
+        uint16_t fields;
+        uint16_t fieldsRead;
+    };
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "stages.h"
+
+namespace creatures
+{
+
+    StageExecutor::StageExecutor(StageClock clock)
+    {
+        this->clock = clock;
+        count = 0;
+    }
+
+    /**
+     * @brief Set up a stage and start running it on the next pass
+     *
+     * @return false if there's no room for it
+     */
+    bool StageExecutor::add(Stage *stage, const char *name, StageStep step, void *context)
+    {
+        if (count >= STAGE_MAX)
+            return false;
+
+        memset(stage, '\0', sizeof(Stage));
+        stage->name = name;
+        stage->step = step;
+        stage->context = context;
+        stage->state = stage_waiting;
+
+        stages[count++] = stage;
+        return true;
+    }
+
+    /**
+     * @brief Give every stage a turn
+     *
+     * Stages go in the order they were added, so whatever one hands to the
+     * next is picked up in the same pass.
+     *
+     * @param now milliseconds, wrapping is fine
+     * @return uint32_t how many milliseconds until a timed wait is up, 0 if
+     *  a stage yielded, or STAGE_WAIT_FOREVER
+     */
+    uint32_t StageExecutor::runOnce(uint32_t now)
+    {
+        uint32_t wait = STAGE_WAIT_FOREVER;
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            Stage *stage = stages[i];
+            if (stage->state == stage_done)
+                continue;
+
+            stage->now = now;
+            uint32_t started = clock();
+            stage->state = stage->step(stage);
+            uint32_t took = clock() - started;
+
+            stage->stats.resumes++;
+            stage->stats.totalMicros += took;
+            if (took > stage->stats.worstMicros)
+                stage->stats.worstMicros = took;
+
+            if (stage->state == stage_yielded)
+            {
+                wait = 0;
+            }
+            else if (stage->state == stage_waiting && stage->timed)
+            {
+                uint32_t left = stageDue(stage) ? 0 : stage->wakeAt - now;
+                if (left < wait)
+                    wait = left;
+            }
+        }
+
+        return wait;
+    }
+
+    uint8_t StageExecutor::stageCount()
+    {
+        return count;
+    }
+
+    const Stage *StageExecutor::stageAt(uint8_t index)
+    {
+        return index < count ? stages[index] : NULL;
+    }
+
+    /**
+     * @brief Write a one line summary of how each stage has been doing
+     *
+     * @return int what snprintf() says
+     */
+    int StageExecutor::describeStats(char *buffer, size_t size)
+    {
+        int used = 0;
+        buffer[0] = '\0';
+
+        for (uint8_t i = 0; i < count && used < (int)size; i++)
+        {
+            StageStats *s = &stages[i]->stats;
+            used += snprintf(buffer + used,
+                             size - used,
+                             "%s%s resumed %lu worst %luus avg %luus",
+                             used > 0 ? ", " : "",
+                             stages[i]->name,
+                             (unsigned long)s->resumes,
+                             (unsigned long)s->worstMicros,
+                             (unsigned long)(s->resumes > 0 ? s->totalMicros / s->resumes : 0));
+        }
+
+        return used;
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+/*
+    Stackless stages for the display pipeline
+
+    Our toolchain (GCC 8) has no C++20 coroutines, so these are the
+    protothread kind: a stage is a function that picks up where it left off
+    by jumping back into a switch on its resume point. A stage that has to
+    wait returns to the executor instead of blocking, so no stage holds a
+    stack while it waits. They all share the executor's.
+
+        static StageState clockStage(Stage *stage)
+        {
+            STAGE_BEGIN(stage);
+            for (;;)
+            {
+                tick();
+                STAGE_SLEEP(stage, 1000);
+            }
+            STAGE_END(stage);
+        }
+
+    The catch is that locals don't survive a wait. Anything that has to
+    must live in the stage's context. Only one wait per line, too, since
+    the line number is the resume point.
+
+    Plain C++ (no Arduino.h) so tools/pipeline-bench can time it on the
+    host.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define STAGE_MAX 4
+
+// runOnce() has nothing on a timer
+#define STAGE_WAIT_FOREVER UINT32_MAX
+
+enum StageState
+{
+    stage_waiting, // Resume when the executor next looks
+    stage_yielded, // Resume right away, after everyone else has had a turn
+    stage_done     // Never resume
+};
+
+struct StageStats
+{
+    uint32_t resumes;
+    uint32_t worstMicros; // Longest a single resume took
+    uint64_t totalMicros;
+};
+
+struct Stage;
+typedef StageState (*StageStep)(Stage *stage);
+
+struct Stage
+{
+    const char *name;
+    StageStep step;
+    void *context;
+
+    uint16_t resumePoint; // 0 to start from the top
+    uint32_t now;         // Milliseconds, as of this resume
+    uint32_t wakeAt;      // When a timed wait is up
+    bool timed;
+    StageState state;
+
+    StageStats stats;
+};
+
+#define STAGE_BEGIN(stage) \
+    switch ((stage)->resumePoint) \
+    { \
+    case 0:
+
+// Wait until condition is true. It's checked every time the stage resumes.
+#define STAGE_AWAIT(stage, condition) \
+    do \
+    { \
+        (stage)->resumePoint = __LINE__; \
+    case __LINE__: \
+        if (!(condition)) \
+            return stage_waiting; \
+    } while (0)
+
+// Wait until condition is true, or ms have gone by
+#define STAGE_AWAIT_FOR(stage, condition, ms) \
+    do \
+    { \
+        (stage)->wakeAt = (stage)->now + (ms); \
+        (stage)->timed = true; \
+        STAGE_AWAIT(stage, (condition) || stageDue(stage)); \
+        (stage)->timed = false; \
+    } while (0)
+
+#define STAGE_SLEEP(stage, ms) STAGE_AWAIT_FOR(stage, false, ms)
+
+// Let the other stages have a turn, then carry on
+#define STAGE_YIELD(stage) \
+    do \
+    { \
+        (stage)->resumePoint = __LINE__; \
+        return stage_yielded; \
+    case __LINE__:; \
+    } while (0)
+
+#define STAGE_END(stage) \
+    } \
+    (stage)->resumePoint = 0; \
+    return stage_done
+
+inline bool stageDue(const Stage *stage)
+{
+    return (int32_t)(stage->now - stage->wakeAt) >= 0;
+}
+
+namespace creatures
+{
+
+    // Where timings come from, microseconds
+    typedef uint32_t (*StageClock)();
+
+    /**
+     * @brief Runs stages one after the other on whatever calls runOnce()
+     *
+     * It doesn't wait for anything itself. The caller blocks on whatever
+     * the stages wait on, for as long as runOnce() says the timers allow,
+     * then calls it again.
+     */
+    class StageExecutor
+    {
+
+    public:
+        StageExecutor(StageClock clock);
+
+        bool add(Stage *stage, const char *name, StageStep step, void *context);
+        uint32_t runOnce(uint32_t now);
+
+        uint8_t stageCount();
+        const Stage *stageAt(uint8_t index);
+        int describeStats(char *buffer, size_t size);
+
+    private:
+        StageClock clock;
+        Stage *stages[STAGE_MAX];
+        uint8_t count;
+    };
+}
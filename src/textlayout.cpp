@@ -0,0 +1,131 @@
+#include <Arduino.h>
+
+#include "textlayout.h"
+#include "logging/logging.h"
+
+namespace creatures
+{
+
+    static Logger l = Logger();
+
+    TextLayout::TextLayout()
+    {
+        fontCount = 0;
+    }
+
+    /**
+     * @brief Copy a font's advance widths into a flat table
+     *
+     * Characters the font doesn't have are 0 wide, same as the GFX library
+     * treats them.
+     */
+    void TextLayout::addFont(const GFXfont *font)
+    {
+        if (fontCount >= TEXT_LAYOUT_FONTS)
+        {
+            l.error("no room for another font in the text layout");
+            return;
+        }
+
+        FontMetrics *m = &metrics[fontCount++];
+        memset(m, '\0', sizeof(FontMetrics));
+        m->font = font;
+        m->first = pgm_read_word(&font->first);
+        m->last = pgm_read_word(&font->last);
+
+        GFXglyph *glyphs = (GFXglyph *)pgm_read_ptr(&font->glyph);
+        for (uint16_t c = m->first; c <= m->last; c++)
+            m->advance[c] = pgm_read_byte(&glyphs[c - m->first].xAdvance);
+    }
+
+    TextLayout::FontMetrics *TextLayout::metricsFor(const GFXfont *font)
+    {
+        for (uint8_t i = 0; i < fontCount; i++)
+        {
+            if (metrics[i].font == font)
+                return &metrics[i];
+        }
+        return NULL;
+    }
+
+    uint16_t TextLayout::sumAdvances(FontMetrics *m, const char *text, size_t length)
+    {
+        uint16_t width = 0;
+        for (size_t i = 0; i < length; i++)
+            width += m->advance[(uint8_t)text[i]];
+        return width;
+    }
+
+    /**
+     * @brief How many pixels wide text is in a font
+     */
+    uint16_t TextLayout::measure(const GFXfont *font, const char *text)
+    {
+        FontMetrics *m = metricsFor(font);
+        if (m == NULL)
+        {
+            l.warning("measuring with a font that was never added");
+            return 0;
+        }
+
+        return sumAdvances(m, text, strlen(text));
+    }
+
+    /**
+     * @brief Make text fit in maxWidth pixels
+     *
+     * Tries each font in order, biggest first. If it doesn't fit in any of
+     * them it's cut short with an ellipsis in the last (smallest) font.
+     *
+     * @param out where the text to print goes
+     * @return const GFXfont* the font to print it in
+     */
+    const GFXfont *TextLayout::fit(const char *text,
+                                   uint16_t maxWidth,
+                                   const GFXfont *const *fonts,
+                                   uint8_t fontCount,
+                                   char *out,
+                                   size_t outSize)
+    {
+        for (uint8_t i = 0; i < fontCount; i++)
+        {
+            if (measure(fonts[i], text) <= maxWidth)
+            {
+                strncpy(out, text, outSize - 1);
+                out[outSize - 1] = '\0';
+                return fonts[i];
+            }
+        }
+
+        const GFXfont *font = fonts[fontCount - 1];
+        FontMetrics *m = metricsFor(font);
+        if (m == NULL)
+        {
+            strncpy(out, text, outSize - 1);
+            out[outSize - 1] = '\0';
+            return font;
+        }
+
+        // Keep as many characters as fit with room left for the ellipsis
+        size_t ellipsisLength = strlen(TEXT_LAYOUT_ELLIPSIS);
+        uint16_t ellipsisWidth = sumAdvances(m, TEXT_LAYOUT_ELLIPSIS, ellipsisLength);
+        uint16_t width = 0;
+        size_t keep = 0;
+        while (text[keep] != '\0' && keep + ellipsisLength + 1 < outSize)
+        {
+            uint8_t advance = m->advance[(uint8_t)text[keep]];
+            if (width + advance + ellipsisWidth > maxWidth)
+                break;
+            width += advance;
+            keep++;
+        }
+
+        // Don't leave a dangling space before the dots
+        while (keep > 0 && text[keep - 1] == ' ')
+            keep--;
+
+        memcpy(out, text, keep);
+        memcpy(out + keep, TEXT_LAYOUT_ELLIPSIS, ellipsisLength + 1);
+        return font;
+    }
+}
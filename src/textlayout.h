@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#define TEXT_LAYOUT_FONTS 2
+#define TEXT_LAYOUT_ELLIPSIS "..."
+
+namespace creatures
+{
+
+    /**
+     * @brief Measures and fits text without walking the glyph bitmaps
+     *
+     * Each font's advance widths are copied into a flat table once, so a
+     * string is measured by adding up one byte per character. That's as
+     * cheap as looking the string up anywhere would be, so nothing is
+     * cached.
+     */
+    class TextLayout
+    {
+
+    public:
+        TextLayout();
+
+        void addFont(const GFXfont *font);
+        uint16_t measure(const GFXfont *font, const char *text);
+        const GFXfont *fit(const char *text,
+                           uint16_t maxWidth,
+                           const GFXfont *const *fonts,
+                           uint8_t fontCount,
+                           char *out,
+                           size_t outSize);
+
+    private:
+        struct FontMetrics
+        {
+            const GFXfont *font;
+            uint8_t first;
+            uint8_t last;
+            uint8_t advance[256];
+        };
+
+        FontMetrics *metricsFor(const GFXfont *font);
+        uint16_t sumAdvances(FontMetrics *metrics, const char *text, size_t length);
+
+        FontMetrics metrics[TEXT_LAYOUT_FONTS];
+        uint8_t fontCount;
+    };
+}
@@ -0,0 +1,267 @@
+/*
+    Host test for the sensor history
+
+    Pushes a few days of samples through every series and checks the
+    hourly min, max and sum, and the samples themselves, against a brute
+    force scan of the same window, including well past the point where the
+    ring has wrapped. Hours that change too fast for a byte a minute may
+    come back a little off, but never by more than half the step that hour
+    needed. The store has to fit the budget below for as many series as
+    we mean to keep, and the test prints what a query costs next to
+    rescanning.
+
+    Usage:
+        history-test
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "history.h"
+
+using creatures::SensorHistory;
+
+// Values we expect back out, already through the fixed-point scale
+using Window = std::vector<float>;
+
+// 24 hours for about 15 series in a few tens of KB
+#define BUDGET_SERIES 15
+#define BUDGET_BYTES (32 * 1024)
+
+static uint32_t seed = 1;
+
+static uint32_t nextRandom()
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+// Something shaped like the data: slow drifts, with long runs up and down
+// and the odd spike
+static float nextValue(HistorySeries series, int minute, float previous)
+{
+    float value = previous;
+    switch (nextRandom() % 8)
+    {
+    case 0:
+        value += ((float)(nextRandom() % 400) - 200.0f) / (series == home_power_use_series ? 1.0f : 10.0f);
+        break;
+    case 1:
+    case 2:
+        value += 0.1f * ((minute / 300) % 2 ? 1.0f : -1.0f);
+        break;
+    default:
+        value += 0.1f * ((float)(nextRandom() % 3) - 1.0f);
+        break;
+    }
+    // Kept inside what the fixed-point scale can hold
+    if (series == home_power_use_series)
+        return roundf(std::min(std::max(value, 0.0f), 20000.0f));
+    return roundf(std::min(std::max(value, -40.0f), 120.0f) * 10.0f) / 10.0f;
+}
+
+static bool near(float a, float b, float tolerance = 0.0f)
+{
+    return fabsf(a - b) <= tolerance + 0.0001f * std::max(1.0f, fabsf(b));
+}
+
+static float scaleOf(HistorySeries series)
+{
+    return series == home_power_use_series ? 1.0f : 10.0f;
+}
+
+// How far off a sample from a finished hour can come back. An hour whose
+// biggest change fits a byte is exact, otherwise it's half of the smallest
+// step that leaves room for the rounding carried from the sample before.
+static float toleranceFor(HistorySeries series, const Window &all, size_t index)
+{
+    size_t first = index - index % HISTORY_BLOCK_SAMPLES;
+    if (first + HISTORY_BLOCK_SAMPLES > all.size())
+        return 0.0f;
+
+    float scale = scaleOf(series);
+    long biggest = 0;
+    for (size_t i = first + 1; i < first + HISTORY_BLOCK_SAMPLES; i++)
+        biggest = std::max(biggest, labs(lroundf(all[i] * scale) - lroundf(all[i - 1] * scale)));
+    if (biggest <= 127)
+        return 0.0f;
+
+    int shift = 1;
+    while (126L << shift < biggest)
+        shift++;
+    return (float)(1 << (shift - 1)) / scale;
+}
+
+static bool check(SensorHistory &history, HistorySeries series, const Window &all, int minute)
+{
+    // Whole hours, plus the one in progress
+    size_t open = all.size() % HISTORY_BLOCK_SAMPLES;
+    size_t hours = std::min(all.size() / HISTORY_BLOCK_SAMPLES, (size_t)HISTORY_BLOCKS);
+    size_t count = hours * HISTORY_BLOCK_SAMPLES + open;
+    size_t start = all.size() - count;
+    Window window(all.begin() + start, all.end());
+
+    float low = window[0], high = window[0];
+    double sum = 0.0;
+    for (float value : window)
+    {
+        low = std::min(low, value);
+        high = std::max(high, value);
+        sum += value;
+    }
+    float mean = (float)(sum / count);
+
+    HistoryStats stats = history.stats(series);
+    if (stats.count != count || !near(stats.min, low) || !near(stats.max, high) ||
+        fabsf(stats.mean - mean) > 0.01f)
+    {
+        printf("series %d, minute %d: stats %u %.1f..%.1f mean %.2f, "
+               "expected %zu %.1f..%.1f mean %.2f\n",
+               series, minute, stats.count, stats.min, stats.max, stats.mean,
+               count, low, high, mean);
+        return false;
+    }
+
+    static float recent[HISTORY_SAMPLES + HISTORY_BLOCK_SAMPLES];
+    uint16_t want = (uint16_t)(nextRandom() % (HISTORY_SAMPLES + 100));
+    uint16_t got = history.copyRecent(series, recent, want);
+    if (got != std::min((size_t)want, count))
+    {
+        printf("series %d, minute %d: copyRecent gave %u of %u\n", series, minute, got, want);
+        return false;
+    }
+    for (uint16_t i = 0; i < got; i++)
+    {
+        size_t index = all.size() - got + i;
+        float tolerance = toleranceFor(series, all, index);
+        if (!near(recent[i], all[index], tolerance))
+        {
+            printf("series %d, minute %d: recent[%u] is %.1f, expected %.1f give or take %.1f\n",
+                   series, minute, i, recent[i], all[index], tolerance);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    bool ok = true;
+
+    SensorHistory history;
+    if (!history.init())
+        return 1;
+
+    // Not every series reports every minute, and some report twice
+    std::vector<Window> expected(HISTORY_SERIES_COUNT);
+    std::vector<float> current(HISTORY_SERIES_COUNT, 50.0f);
+    std::vector<bool> started(HISTORY_SERIES_COUNT, false);
+
+    const int minutes = 3 * HISTORY_SAMPLES + 17;
+    for (int minute = 0; minute < minutes && ok; minute++)
+    {
+        for (int i = 0; i < HISTORY_SERIES_COUNT; i++)
+        {
+            HistorySeries series = (HistorySeries)i;
+
+            // Each series starts reporting a little later than the last
+            if (minute >= i * 37 && nextRandom() % 4 != 0)
+            {
+                current[i] = nextValue(series, minute, current[i]);
+                history.record(series, current[i]);
+                started[i] = true;
+            }
+        }
+        history.commitSample();
+
+        for (int i = 0; i < HISTORY_SERIES_COUNT; i++)
+        {
+            // Sample-and-hold, so a quiet minute repeats the last value
+            if (started[i])
+                expected[i].push_back(current[i]);
+
+            if (started[i] && (minute % 7 == 0 || minute % HISTORY_SAMPLES >= HISTORY_SAMPLES - 3))
+                ok &= check(history, (HistorySeries)i, expected[i], minute);
+        }
+    }
+
+    // The end state, every series
+    for (int i = 0; i < HISTORY_SERIES_COUNT && ok; i++)
+        ok &= check(history, (HistorySeries)i, expected[i], minutes);
+
+    // A steady fall then a steady rise, each longer than the window, with
+    // the wrap in the middle of an hour
+    SensorHistory steady;
+    steady.init();
+    Window ramp;
+    for (int minute = 0; minute < 4 * HISTORY_SAMPLES + 29 && ok; minute++)
+    {
+        int step = minute < 2 * HISTORY_SAMPLES ? -minute : minute - 4 * HISTORY_SAMPLES;
+        ramp.push_back((float)step / 10.0f);
+        steady.record(office_temperature_series, ramp.back());
+        steady.commitSample();
+        if (minute % 13 == 0 || minute % HISTORY_BLOCK_SAMPLES == 0)
+            ok &= check(steady, office_temperature_series, ramp, minute);
+    }
+
+    // Power that swings across its whole range every minute, and hours of
+    // it next to quiet ones. Stats stay exact, the samples come back to
+    // within half a step of that hour.
+    SensorHistory swings;
+    swings.init();
+    Window watts;
+    for (int minute = 0; minute < 2 * HISTORY_SAMPLES && ok; minute++)
+    {
+        bool busy = (minute / HISTORY_BLOCK_SAMPLES) % 3 == 0;
+        watts.push_back(busy ? (float)(minute % 2 ? 20000 - minute : minute) : 500.0f + minute % 7);
+        swings.record(home_power_use_series, watts.back());
+        swings.commitSample();
+        if (minute % 11 == 0)
+            ok &= check(swings, home_power_use_series, watts, minute);
+    }
+
+    // Density: everything the store costs, per sample it holds, and what
+    // it would take for as many series as we want to keep
+    size_t samples = (size_t)HISTORY_SERIES_COUNT * HISTORY_SAMPLES;
+    size_t perSeries = history.footprint() / HISTORY_SERIES_COUNT;
+    printf("footprint %zu bytes for %zu samples, %.2f bytes a sample, %zu bytes for %d series\n",
+           history.footprint(), samples, (double)history.footprint() / samples,
+           perSeries * BUDGET_SERIES, BUDGET_SERIES);
+    if (perSeries * BUDGET_SERIES > BUDGET_BYTES)
+    {
+        printf("%d series would take more than %d bytes\n", BUDGET_SERIES, BUDGET_BYTES);
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        printf("history test FAILED\n");
+        return 1;
+    }
+
+    // Query cost, against scanning the full window for the same answer
+    const int queries = 20000;
+    volatile float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++)
+        sink = sink + history.stats((HistorySeries)(q % HISTORY_SERIES_COUNT)).max;
+    auto middle = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++)
+    {
+        const Window &all = expected[q % HISTORY_SERIES_COUNT];
+        float high = all[all.size() - HISTORY_SAMPLES];
+        for (size_t j = all.size() - HISTORY_SAMPLES; j < all.size(); j++)
+            high = std::max(high, all[j]);
+        sink = sink + high;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double statsNanos = std::chrono::duration<double, std::nano>(middle - start).count() / queries;
+    double scanNanos = std::chrono::duration<double, std::nano>(end - middle).count() / queries;
+    printf("stats() %.0f ns, rescanning the window %.0f ns\n", statsNanos, scanNanos);
+
+    printf("history test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
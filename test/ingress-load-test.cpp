@@ -0,0 +1,256 @@
+/*
+    Host load test for the display queue
+
+    Runs the load test's message mix (src/loadtest.cpp) through the display
+    queue with the display's own policies, and draws what comes out with
+    the real widgets on the stand-in panel, so every draw costs what its
+    push over SPI would. It's laid out like the pipeline task: MQTT's
+    messages pile up until the reader takes a batch of them and posts them
+    (without waiting, it's the task that makes the room), then the display
+    stage draws up to a queue's worth. The clock posts once a second.
+
+    Time is the shim's, moved on by the panel and by waiting for the next
+    message, so a minute of load takes a moment. The panel's cost model is
+    the only time the host has in common with the display. Drawing on the
+    S2 takes longer than on the host, so these are a floor.
+
+    Each rate reports what each class dropped and merged, the queue's
+    peak, how far behind MQTT's queue got, and the longest anything took
+    from reaching MQTT's queue to being on the screen. The device's rate,
+    and INGRESS_LOAD_HEADROOM times it, have to stay inside the limits in
+    ingress.h, the same ones the device holds itself to. A flood at ten
+    times the rate is only reported, to show where the load goes.
+
+    Usage:
+        ingress-load-test
+*/
+
+#include <cstdio>
+#include <deque>
+
+#include "history.h"
+#include "ingress.h"
+#include "screen.h"
+
+using creatures::IngressQueue;
+using creatures::SensorHistory;
+using creatures::TouchDisplay;
+
+// What the device's load test sends, and how many of the reader's batch
+#define LOAD_RATE 20
+#define LOAD_SECONDS 60
+#define READER_BATCH 4
+#define QUEUE_LENGTH 16
+
+enum LoadDraw
+{
+    draw_reading,
+    draw_room,
+    draw_event,
+    draw_flamethrower,
+    draw_clock
+};
+
+// One of loadtest.cpp's messages, after the reader has worked out what it is
+struct LoadMessage
+{
+    IngressClass ingressClass;
+    LoadDraw draw;
+    HistorySeries series;
+    const char *text;
+    float value;
+};
+
+static const LoadMessage loadMessages[] = {
+    {ingress_temperature, draw_reading, outside_temperature_series, NULL, 54.3f},
+    {ingress_temperature, draw_reading, home_power_use_series, NULL, 1432.0f},
+    {ingress_motion, draw_event, outside_temperature_series, "Office Motion", 0.0f},
+    {ingress_temperature, draw_room, kitchen_temperature_series, "Kitchen", 70.1f},
+    {ingress_temperature, draw_reading, home_power_use_series, NULL, 1520.0f},
+    {ingress_temperature, draw_reading, outside_wind_speed_series, NULL, 12.0f},
+    {ingress_motion, draw_event, outside_temperature_series, "Office Cleared", 0.0f},
+    {ingress_temperature, draw_room, family_room_temperature_series, "Family Room", 68.4f},
+    {ingress_temperature, draw_reading, home_power_use_series, NULL, 1498.0f},
+    {ingress_flamethrower, draw_flamethrower, outside_temperature_series, "Office On", 0.0f},
+    {ingress_motion, draw_event, outside_temperature_series, "Workshop Motion", 0.0f},
+    {ingress_temperature, draw_room, bunnys_room_temperature_series, "Bunny's Room", 66.9f},
+    {ingress_flamethrower, draw_flamethrower, outside_temperature_series, "Office Off", 0.0f},
+    {ingress_motion, draw_event, outside_temperature_series, "Workshop Cleared", 0.0f},
+};
+
+#define LOAD_MESSAGE_COUNT (sizeof(loadMessages) / sizeof(LoadMessage))
+
+static const LoadMessage clockMessage = {ingress_clock, draw_clock, outside_temperature_series, "8:15:00 AM", 0.0f};
+
+// What goes through the queue
+struct Queued
+{
+    const LoadMessage *message;
+    unsigned long arrived; // When it got to MQTT's queue
+};
+
+// The display's policies, from main.cpp
+static const BackpressurePolicy policies[INGRESS_CLASS_COUNT] = {
+    policy_coalesce,
+    policy_coalesce,
+    policy_drop_oldest,
+    policy_coalesce,
+    policy_coalesce,
+};
+
+struct LoadResult
+{
+    size_t mqttPeak;
+    uint32_t drawn;
+    unsigned long clockOnScreenMicros; // Worst, from the tick to it being drawn
+    unsigned long onScreenMicros;      // Worst for anything, from MQTT to being drawn
+};
+
+static void draw(TouchDisplay &display, SensorHistory &history, const LoadMessage *message)
+{
+    switch (message->draw)
+    {
+    case draw_reading:
+        if (message->series == outside_temperature_series)
+            display.printTemperature(message->value);
+        else if (message->series == outside_wind_speed_series)
+            display.printWindspeed(message->value);
+        else
+            display.printPowerUsed(message->value);
+        break;
+    case draw_room:
+        display.addHouseEvent("08:15 PM", message->text);
+        display.printRoomTemperature(message->series, message->text, message->value, history.stats(message->series));
+        break;
+    case draw_event:
+        display.addHouseEvent("08:15 PM", message->text);
+        break;
+    case draw_flamethrower:
+        display.printFlamethrowerMessage((char *)message->text);
+        break;
+    case draw_clock:
+        display.printTime((char *)message->text);
+        break;
+    }
+}
+
+// Where messages from the same source coalesce, like post_display_message's callers
+static uint32_t keyFor(const LoadMessage *message)
+{
+    return message->ingressClass == ingress_temperature ? message->series : 0;
+}
+
+static LoadResult runLoad(TouchDisplay &display, IngressQueue &queue, uint32_t rate)
+{
+    SensorHistory history;
+    LoadResult result = {};
+    std::deque<Queued> mqtt;
+
+    unsigned long start = micros();
+    unsigned long end = start + LOAD_SECONDS * 1000000UL;
+    unsigned long interval = 1000000UL / rate;
+    unsigned long nextMessage = start;
+    unsigned long nextTick = start;
+    uint32_t sent = 0;
+
+    for (unsigned long now = micros(); now < end; now = micros())
+    {
+        // What MQTT got while we were drawing
+        while (nextMessage <= now)
+        {
+            mqtt.push_back({&loadMessages[sent++ % LOAD_MESSAGE_COUNT], nextMessage});
+            nextMessage += interval;
+        }
+        result.mqttPeak = std::max(result.mqttPeak, mqtt.size());
+
+        if (nextTick <= now)
+        {
+            Queued tick = {&clockMessage, nextTick};
+            queue.send(ingress_clock, 0, &tick, false);
+            nextTick += 1000000UL;
+        }
+
+        for (int i = 0; i < READER_BATCH && !mqtt.empty(); i++)
+        {
+            Queued queued = mqtt.front();
+            mqtt.pop_front();
+            if (queued.message->draw == draw_reading || queued.message->draw == draw_room)
+                history.record(queued.message->series, queued.message->value);
+            queue.send(queued.message->ingressClass, keyFor(queued.message), &queued, false);
+        }
+
+        Queued queued;
+        for (int drawn = 0; drawn < QUEUE_LENGTH && queue.receive(&queued, 0); drawn++)
+        {
+            draw(display, history, queued.message);
+            result.drawn++;
+            result.onScreenMicros = std::max(result.onScreenMicros, micros() - queued.arrived);
+            if (queued.message->ingressClass == ingress_clock)
+                result.clockOnScreenMicros = std::max(result.clockOnScreenMicros, micros() - queued.arrived);
+        }
+
+        // Nothing to do until the next message or tick
+        if (mqtt.empty() && queue.waiting() == 0)
+        {
+            unsigned long next = std::min(nextMessage, nextTick);
+            now = micros();
+            if (next > now)
+                delay((next - now + 999) / 1000);
+        }
+    }
+
+    return result;
+}
+
+static bool withinLimits(uint32_t rate, IngressQueue &queue, const LoadResult &result)
+{
+    const IngressStats *clock = queue.statsFor(ingress_clock);
+    const IngressStats *config = queue.statsFor(ingress_config);
+    bool ok = true;
+
+    if (result.onScreenMicros > INGRESS_LOAD_LATENCY_US)
+    {
+        printf("%u a second: a message took %luus to be drawn, more than %dus\n",
+               rate, result.onScreenMicros, INGRESS_LOAD_LATENCY_US);
+        ok = false;
+    }
+    if (clock->dropped > 0 || config->dropped > 0)
+    {
+        printf("%u a second: dropped %u clock ticks and %u config messages\n",
+               rate, clock->dropped, config->dropped);
+        ok = false;
+    }
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+
+    TouchDisplay display;
+    display.initScreen();
+    display.showPage(page_overview);
+
+    for (uint32_t rate : {LOAD_RATE, LOAD_RATE * INGRESS_LOAD_HEADROOM, LOAD_RATE * 10})
+    {
+        IngressQueue queue;
+        queue.init(QUEUE_LENGTH, sizeof(Queued));
+        for (int i = 0; i < INGRESS_CLASS_COUNT; i++)
+            queue.setPolicy((IngressClass)i, policies[i], 100);
+
+        LoadResult result = runLoad(display, queue, rate);
+
+        char stats[448];
+        queue.describeStats(stats, sizeof(stats));
+        printf("%u a second for %ds: drew %u, mqtt queue peak %zu\n  %s\n"
+               "  on screen within %luus, the clock within %luus\n",
+               rate, LOAD_SECONDS, result.drawn, result.mqttPeak, stats,
+               result.onScreenMicros, result.clockOnScreenMicros);
+
+        if (rate <= LOAD_RATE * INGRESS_LOAD_HEADROOM)
+            ok &= withinLimits(rate, queue, result);
+    }
+
+    printf("ingress load test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,376 @@
+/*
+    Host test for delta patches
+
+    Applies patches through the same DeltaPatcher the display runs, fed in
+    the kinds of pieces the network and the inflater hand it: one byte at a
+    time, all at once, and split everywhere in between. Patches that are
+    cut short have to stop without finishing, and broken ones, or ones made
+    against other firmware, have to fail without reading outside the source
+    or writing past the end of the target.
+
+    Usage:
+        ota-delta-test
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ota-delta.h"
+
+using creatures::DeltaPatcher;
+using Bytes = std::vector<uint8_t>;
+
+struct Applied
+{
+    const Bytes *source;
+    Bytes output;
+    bool strayRead;    // Asked for bytes outside the source
+    bool failReads;
+    bool failWrites;
+};
+
+static bool readSource(void *context, uint32_t offset, uint8_t *buffer, size_t length)
+{
+    Applied *applied = (Applied *)context;
+    if (applied->failReads)
+        return false;
+    if (offset > applied->source->size() || length > applied->source->size() - offset)
+    {
+        applied->strayRead = true;
+        return false;
+    }
+    memcpy(buffer, applied->source->data() + offset, length);
+    return true;
+}
+
+static bool writeTarget(void *context, const uint8_t *data, size_t length)
+{
+    Applied *applied = (Applied *)context;
+    if (applied->failWrites)
+        return false;
+    applied->output.insert(applied->output.end(), data, data + length);
+    return true;
+}
+
+static void putLittleEndian(Bytes &out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out.push_back((value >> (8 * i)) & 0xFF);
+}
+
+static uint32_t hashOf(const Bytes &data)
+{
+    return creatures::deltaHash(OTA_DELTA_HASH_START, data.data(), data.size());
+}
+
+static Bytes header(const Bytes &source, uint32_t targetSize)
+{
+    Bytes patch(OTA_DELTA_MAGIC, OTA_DELTA_MAGIC + 4);
+    putLittleEndian(patch, source.size());
+    putLittleEndian(patch, targetSize);
+    putLittleEndian(patch, hashOf(source));
+    return patch;
+}
+
+static void copyOp(Bytes &patch, uint32_t offset, uint32_t length)
+{
+    patch.push_back(OTA_DELTA_COPY);
+    putLittleEndian(patch, offset);
+    putLittleEndian(patch, length);
+}
+
+static void addOp(Bytes &patch, const Bytes &data)
+{
+    patch.push_back(OTA_DELTA_ADD);
+    putLittleEndian(patch, data.size());
+    patch.insert(patch.end(), data.begin(), data.end());
+}
+
+static Bytes noise(size_t length, uint32_t seed)
+{
+    Bytes out(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        out[i] = seed >> 24;
+    }
+    return out;
+}
+
+// A source, and a patch that builds the target from it
+struct Sample
+{
+    Bytes source;
+    Bytes target;
+    Bytes patch;
+};
+
+static Sample sample()
+{
+    Sample s;
+    s.source = noise(3000, 1);
+    Bytes added = noise(300, 2);
+
+    // Longer than the copy buffer, some new bytes, a copy from further
+    // back, an empty add, and a short one to finish
+    s.target.insert(s.target.end(), s.source.begin() + 100, s.source.begin() + 1600);
+    s.target.insert(s.target.end(), added.begin(), added.end());
+    s.target.insert(s.target.end(), s.source.begin() + 2000, s.source.end());
+    s.target.insert(s.target.end(), s.source.begin(), s.source.begin() + 10);
+    s.target.insert(s.target.end(), added.begin(), added.begin() + 5);
+
+    s.patch = header(s.source, s.target.size());
+    copyOp(s.patch, 100, 1500);
+    addOp(s.patch, added);
+    copyOp(s.patch, 2000, 1000);
+    copyOp(s.patch, 0, 10);
+    addOp(s.patch, Bytes());
+    addOp(s.patch, Bytes(added.begin(), added.begin() + 5));
+    return s;
+}
+
+/**
+ * @brief Feed a patch in pieces of the given sizes, cycling through them
+ *
+ * @return what feed() said about the last piece
+ */
+static bool feedPieces(DeltaPatcher &patcher, const Bytes &patch, const std::vector<size_t> &pieces)
+{
+    bool ok = true;
+    size_t pos = 0;
+    for (size_t i = 0; pos < patch.size(); i++)
+    {
+        size_t length = std::min(pieces[i % pieces.size()], patch.size() - pos);
+        ok = patcher.feed(&patch[pos], length);
+        if (!ok)
+            break;
+        pos += length;
+    }
+    return ok;
+}
+
+static bool appliesIn(const char *name, const Sample &s, const std::vector<size_t> &pieces)
+{
+    Applied applied = {&s.source, {}, false, false, false};
+    DeltaPatcher patcher(readSource, writeTarget, &applied);
+    patcher.expectSource(s.source.size(), hashOf(s.source));
+
+    bool ok = feedPieces(patcher, s.patch, pieces);
+    if (!ok || !patcher.finished() || applied.output != s.target)
+    {
+        printf("%s: didn't apply (%s), wrote %zu of %zu bytes\n",
+               name, patcher.error() ? patcher.error() : "no error", applied.output.size(), s.target.size());
+        return false;
+    }
+    return true;
+}
+
+static bool splitsApply()
+{
+    Sample s = sample();
+    bool ok = true;
+
+    ok &= appliesIn("all at once", s, {s.patch.size()});
+    for (size_t size = 1; size <= 64 && ok; size++)
+        ok &= appliesIn(("pieces of " + std::to_string(size)).c_str(), s, {size});
+
+    // Every place the patch could be cut in two
+    for (size_t cut = 1; cut < s.patch.size() && ok; cut++)
+        ok &= appliesIn(("cut at " + std::to_string(cut)).c_str(), s, {cut, s.patch.size()});
+
+    // Sizes that wander, like the inflater's output does
+    for (uint32_t seed = 1; seed <= 50 && ok; seed++)
+    {
+        std::vector<size_t> pieces;
+        for (uint8_t byte : noise(40, seed))
+            pieces.push_back(byte % 37 + 1);
+        ok &= appliesIn(("wandering pieces, seed " + std::to_string(seed)).c_str(), s, pieces);
+    }
+
+    if (ok)
+        printf("patch of %zu bytes applied whole and split every way\n", s.patch.size());
+    return ok;
+}
+
+// A patch that stops early isn't an error until the caller says it's over
+static bool truncationsDontFinish()
+{
+    Sample s = sample();
+
+    for (size_t cut = 0; cut < s.patch.size(); cut++)
+    {
+        Applied applied = {&s.source, {}, false, false, false};
+        DeltaPatcher patcher(readSource, writeTarget, &applied);
+        Bytes truncated(s.patch.begin(), s.patch.begin() + cut);
+
+        bool fed = feedPieces(patcher, truncated, {7});
+        bool prefix = applied.output.size() < s.target.size() &&
+                      std::equal(applied.output.begin(), applied.output.end(), s.target.begin());
+        if (!fed || patcher.finished() || patcher.failed() || !prefix)
+        {
+            printf("a patch cut to %zu of %zu bytes %s, wrote %zu bytes\n",
+                   cut, s.patch.size(), patcher.finished() ? "finished" : "went wrong", applied.output.size());
+            return false;
+        }
+    }
+
+    printf("patch cut short at every byte stopped without finishing\n");
+    return true;
+}
+
+struct Corruption
+{
+    const char *name;
+    Bytes patch;
+    bool failReads;
+    bool failWrites;
+};
+
+static bool failsSafely(const Sample &s, const Corruption &corruption, size_t piece)
+{
+    Applied applied = {&s.source, {}, false, corruption.failReads, corruption.failWrites};
+    DeltaPatcher patcher(readSource, writeTarget, &applied);
+    patcher.expectSource(s.source.size(), hashOf(s.source));
+
+    bool fed = feedPieces(patcher, corruption.patch, {piece});
+    if (fed || !patcher.failed() || patcher.error() == NULL)
+    {
+        printf("%s: wasn't turned away\n", corruption.name);
+        return false;
+    }
+    if (applied.strayRead || applied.output.size() > s.target.size())
+    {
+        printf("%s: read outside the source or wrote past the target\n", corruption.name);
+        return false;
+    }
+
+    // Once it's failed it stays failed
+    uint8_t more = OTA_DELTA_ADD;
+    if (patcher.feed(&more, 1))
+    {
+        printf("%s: took more data after failing\n", corruption.name);
+        return false;
+    }
+    return true;
+}
+
+static bool corruptionsRejected()
+{
+    Sample s = sample();
+    Bytes body(s.patch.begin() + OTA_DELTA_HEADER_SIZE, s.patch.end());
+    std::vector<Corruption> corruptions;
+
+    Bytes patch = s.patch;
+    patch[0] = 'X';
+    corruptions.push_back({"bad magic", patch, false, false});
+
+    patch = s.patch;
+    patch[OTA_DELTA_HEADER_SIZE] = 'Z';
+    corruptions.push_back({"unknown operation", patch, false, false});
+
+    patch = header(s.source, s.target.size());
+    copyOp(patch, s.source.size() - 10, 20);
+    corruptions.push_back({"copy past the end of the source", patch, false, false});
+
+    patch = header(s.source, s.target.size());
+    copyOp(patch, 0xFFFFFFF0u, 0x20);
+    corruptions.push_back({"copy offset that wraps around", patch, false, false});
+
+    patch = header(s.source, 10);
+    copyOp(patch, 0, 20);
+    corruptions.push_back({"copy past the end of the target", patch, false, false});
+
+    patch = header(s.source, 10);
+    addOp(patch, noise(20, 3));
+    corruptions.push_back({"add past the end of the target", patch, false, false});
+
+    patch = s.patch;
+    patch.push_back(OTA_DELTA_ADD);
+    corruptions.push_back({"data after the end", patch, false, false});
+
+    corruptions.push_back({"source that can't be read", s.patch, true, false});
+    corruptions.push_back({"target that can't be written", s.patch, false, true});
+
+    bool ok = true;
+    for (const Corruption &corruption : corruptions)
+    {
+        ok &= failsSafely(s, corruption, 1);
+        ok &= failsSafely(s, corruption, 5);
+        ok &= failsSafely(s, corruption, corruption.patch.size());
+    }
+
+    // Every byte flipped in turn: it can't be caught every time, but it
+    // must never read outside the source or write past the target
+    for (size_t i = 0; i < s.patch.size(); i++)
+    {
+        patch = s.patch;
+        patch[i] ^= 0xFF;
+
+        Applied applied = {&s.source, {}, false, false, false};
+        DeltaPatcher patcher(readSource, writeTarget, &applied);
+        feedPieces(patcher, patch, {3});
+        if (applied.strayRead || applied.output.size() > patcher.targetSize())
+        {
+            printf("flipping byte %zu read outside the source or wrote past the target\n", i);
+            ok = false;
+        }
+    }
+
+    if (ok)
+        printf("%zu kinds of broken patch turned away\n", corruptions.size());
+    return ok;
+}
+
+// Patches for other firmware have to fail on the header, before any writes
+static bool otherSourcesRejected()
+{
+    Sample s = sample();
+    Bytes other = s.source;
+    other[1234] ^= 0x01;
+
+    struct
+    {
+        const char *name;
+        uint32_t size;
+        uint32_t hash;
+    } expectations[] = {
+        {"a different size of source", (uint32_t)s.source.size() + 1, hashOf(s.source)},
+        {"a source one bit different", (uint32_t)other.size(), hashOf(other)},
+    };
+
+    for (auto &expected : expectations)
+    {
+        for (size_t piece : {(size_t)1, (size_t)OTA_DELTA_HEADER_SIZE, s.patch.size()})
+        {
+            Applied applied = {&s.source, {}, false, false, false};
+            DeltaPatcher patcher(readSource, writeTarget, &applied);
+            patcher.expectSource(expected.size, expected.hash);
+
+            bool fed = feedPieces(patcher, s.patch, {piece});
+            if (fed || !applied.output.empty())
+            {
+                printf("a patch applied to %s wasn't turned away up front, wrote %zu bytes\n",
+                       expected.name, applied.output.size());
+                return false;
+            }
+        }
+    }
+
+    printf("patches for other firmware turned away before writing\n");
+    return true;
+}
+
+int main()
+{
+    bool ok = true;
+
+    ok &= splitsApply();
+    ok &= truncationsDontFinish();
+    ok &= corruptionsRejected();
+    ok &= otherSourcesRejected();
+
+    printf("delta test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
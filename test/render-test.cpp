@@ -0,0 +1,290 @@
+/*
+    Host test for the render path
+
+    Sets the screen up against the stand-in panel and fonts in test/shim,
+    then runs the render self-test: every page is drawn with the render
+    script while it's showing, hashed, and checked against the goldens
+    below, with each widget held to its time budget including its push to
+    the panel. After that each page is put up and given new values, and
+    what's on the panel has to match the page cache pixel for pixel.
+    Every pixel the updates changed has to be in a dirty region, and the
+    page and its regions go through the mirror's RLE coder and back, which
+    is where the mirror's numbers come from.
+
+    Last the display is put to sleep, updated while it's asleep, and woken.
+    Waking mustn't hold up the caller (the pipeline task on the display)
+    while the panel starts, and what's on the panel afterwards has to match
+    the cache.
+
+    The goldens are for the stand-in fonts, the display's own are in
+    rendercheck.cpp. If the stand-ins or a widget change on purpose, record
+    the hashes the failure prints. The self-test is run once more with no
+    goldens, which has to log the hashes and pass on the budgets alone.
+
+    Usage:
+        render-test
+*/
+
+#include <cstdio>
+#include <vector>
+
+#include "mirror-rle.h"
+#include "mirror-stream.h"
+#include "screen.h"
+
+using creatures::RleDecoder;
+using creatures::RleEncoder;
+using creatures::TouchDisplay;
+using Pixels = std::vector<uint16_t>;
+
+static const uint32_t goldens[PAGE_COUNT] = {
+    0xc23e11c3, // page_overview
+    0xc69ceb53, // page_rooms
+    0x168b1037, // page_power
+};
+
+static bool panelMatches(TouchDisplay &display, DashboardPage page, const char *when)
+{
+    Adafruit_HX8357 *panel = shimPanel();
+    const uint16_t *cached = display.pageBuffer(page);
+
+    int wrong = 0;
+    int16_t firstX = 0, firstY = 0;
+    for (int16_t y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < SCREEN_WIDTH; x++)
+        {
+            if (panel->getPixel(x, y) != cached[y * SCREEN_WIDTH + x] && wrong++ == 0)
+            {
+                firstX = x;
+                firstY = y;
+            }
+        }
+    }
+
+    if (wrong > 0)
+    {
+        printf("page %d %s: %d pixels on the panel aren't what's cached, the first at %d,%d\n",
+               page, when, wrong, firstX, firstY);
+        return false;
+    }
+    return true;
+}
+
+static bool collectPixels(void *context, uint16_t pixel, size_t count)
+{
+    ((Pixels *)context)->insert(((Pixels *)context)->end(), count, pixel);
+    return true;
+}
+
+static bool feedDecoder(void *context, const uint8_t *data, size_t length)
+{
+    return ((RleDecoder *)context)->feed(data, length);
+}
+
+/**
+ * @brief What the mirror would send for part of a page
+ *
+ * Encoded the way mirror.cpp does it, a row at a time through one chunk,
+ * then decoded again to make sure it comes back the same.
+ *
+ * @return uint32_t encoded bytes, 0 if it didn't come back right
+ */
+static uint32_t mirrorBytes(const uint16_t *page, DirtyRect region)
+{
+    Pixels decoded;
+    RleDecoder decoder(collectPixels, &decoded);
+    uint8_t chunk[MIRROR_CHUNK_SIZE];
+    RleEncoder encoder(feedDecoder, &decoder, chunk, sizeof(chunk));
+
+    Pixels expected;
+    for (int16_t row = 0; row < region.h; row++)
+    {
+        const uint16_t *start = page + (region.y + row) * SCREEN_WIDTH + region.x;
+        encoder.add(start, region.w);
+        expected.insert(expected.end(), start, start + region.w);
+    }
+    if (!encoder.finish() || decoded != expected)
+    {
+        printf("the %dx%d region at %d,%d didn't come back through RLE\n",
+               region.w, region.h, region.x, region.y);
+        return 0;
+    }
+    return encoder.encodedBytes();
+}
+
+// Everything that changed has to be somewhere the mirror will look
+static bool dirtyCovers(const Pixels &before, const uint16_t *after, const DirtyRect *rects, uint8_t count, DashboardPage page)
+{
+    for (int16_t y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < SCREEN_WIDTH; x++)
+        {
+            if (before[y * SCREEN_WIDTH + x] == after[y * SCREEN_WIDTH + x])
+                continue;
+
+            bool covered = false;
+            for (uint8_t i = 0; i < count && !covered; i++)
+                covered = x >= rects[i].x && x < rects[i].x + rects[i].w &&
+                          y >= rects[i].y && y < rects[i].y + rects[i].h;
+            if (!covered)
+            {
+                printf("page %d: %d,%d changed but isn't in a dirty region\n", page, x, y);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// New values for everything on a page, while it's showing
+static void update(TouchDisplay &display, DashboardPage page)
+{
+    display.printTime((char *)"8:15 AM");
+    switch (page)
+    {
+    case page_overview:
+        display.printTemperature(31.5);
+        display.printWindspeed(4.0);
+        display.printPowerUsed(987);
+        display.printFlamethrowerMessage((char *)"Office flamethrower on");
+        display.addHouseEvent("08:15 AM", "Garage door closed");
+        display.addHouseEvent("08:16 AM", "Workshop is 55.5F");
+        break;
+
+    case page_rooms:
+        for (uint8_t row = 0; row < ROOM_COUNT; row += 2)
+        {
+            HistoryStats stats = {5, 50.0f, 60.0f, 55.0f};
+            display.printRoomTemperature((HistorySeries)(half_bathroom_temperature_series + row),
+                                         "Somewhere",
+                                         58.5f,
+                                         stats);
+        }
+        break;
+
+    case page_power:
+    {
+        float samples[300];
+        HistoryStats stats = {300, 100.0f, 3100.0f, 1600.0f};
+        for (uint16_t i = 0; i < 300; i++)
+            samples[i] = 100.0f + (i * 10) % 3001;
+        display.printPowerHistory(samples, 300, stats);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Sleep, take updates, and wake like the display stage does
+ *
+ * The stage calls wake() once a pass until it's done. In between it waits,
+ * which is when the shim runs the task that starts the panel.
+ */
+static bool wakesWithoutWaiting(TouchDisplay &display)
+{
+    display.showPage(page_overview);
+    display.sleep();
+    update(display, page_overview);
+
+    unsigned long held = 0;
+    unsigned long started = micros();
+    int passes = 0;
+    bool awake = false;
+    while (!awake && passes < 10)
+    {
+        unsigned long pass = micros();
+        awake = display.wake();
+        held = std::max(held, micros() - pass);
+        passes++;
+        if (!awake)
+            vTaskDelay(pdMS_TO_TICKS(100));
+    }
+
+    if (!awake || display.isAsleep())
+    {
+        printf("the display didn't wake up after %d passes\n", passes);
+        return false;
+    }
+
+    char power[160];
+    display.describePowerStats(power, sizeof(power));
+    printf("woke in %d passes over %luus, holding the caller for %luus at most. %s\n",
+           passes, micros() - started, held, power);
+
+    // Starting the panel takes HX8357_SHIM_BEGIN_MS, none of that is the caller's
+    if (held >= HX8357_SHIM_BEGIN_MS * 1000UL)
+    {
+        printf("waking held the caller while the panel started\n");
+        return false;
+    }
+    return panelMatches(display, page_overview, "after waking");
+}
+
+int main()
+{
+    bool ok = true;
+
+    TouchDisplay display;
+    display.initScreen();
+
+    ok &= display.selfTest(goldens);
+
+    // With nothing recorded it only logs the hashes, like a new display
+    const uint32_t unrecorded[PAGE_COUNT] = {0};
+    ok &= display.selfTest(unrecorded);
+
+    for (int page = 0; page < PAGE_COUNT; page++)
+    {
+        uint64_t busBefore = shimPanel()->busBytes();
+        unsigned long flip = display.showPage((DashboardPage)page);
+        printf("page %d: the flip sent %llu bytes and took %luus\n",
+               page, (unsigned long long)(shimPanel()->busBytes() - busBefore), flip);
+        ok &= panelMatches(display, (DashboardPage)page, "after the flip");
+
+        DirtyRect rects[MIRROR_DIRTY_RECTS];
+        DashboardPage shown;
+        display.takeDirtyRects(rects, MIRROR_DIRTY_RECTS, &shown);
+
+        const uint16_t *cached = display.pageBuffer((DashboardPage)page);
+        Pixels before(cached, cached + SCREEN_WIDTH * SCREEN_HEIGHT);
+
+        update(display, (DashboardPage)page);
+        ok &= panelMatches(display, (DashboardPage)page, "after updates");
+
+        uint8_t count = display.takeDirtyRects(rects, MIRROR_DIRTY_RECTS, &shown);
+        ok &= dirtyCovers(before, cached, rects, count, (DashboardPage)page);
+
+        uint32_t updateBytes = 0, updatePixels = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint32_t bytes = mirrorBytes(cached, rects[i]);
+            ok &= bytes > 0;
+            updateBytes += bytes;
+            updatePixels += rects[i].w * rects[i].h;
+        }
+
+        DirtyRect everything = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+        uint32_t screenBytes = mirrorBytes(cached, everything);
+        ok &= screenBytes > 0;
+
+        printf("page %d: a screenshot is %u bytes, %u%% of the raw %u. "
+               "The update was %u bytes in %u regions, %u%% of their raw %u\n",
+               page,
+               screenBytes,
+               screenBytes * 100 / (SCREEN_WIDTH * SCREEN_HEIGHT * 2),
+               SCREEN_WIDTH * SCREEN_HEIGHT * 2,
+               updateBytes,
+               count,
+               updatePixels > 0 ? updateBytes * 100 / (updatePixels * 2) : 0,
+               updatePixels * 2);
+    }
+
+    ok &= wakesWithoutWaiting(display);
+
+    printf("render test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
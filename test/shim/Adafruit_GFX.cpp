@@ -0,0 +1,528 @@
+#include "Adafruit_GFX.h"
+
+// Ported from Adafruit_GFX.cpp, keep the arithmetic the same
+
+#define _swap_int16_t(a, b) \
+    {                       \
+        int16_t t = a;      \
+        a = b;              \
+        b = t;              \
+    }
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h)
+{
+    _width = WIDTH;
+    _height = HEIGHT;
+    rotation = 0;
+    cursor_y = cursor_x = 0;
+    textsize_x = textsize_y = 1;
+    textcolor = textbgcolor = 0xFFFF;
+    wrap = true;
+    gfxFont = NULL;
+}
+
+void Adafruit_GFX::startWrite()
+{
+}
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    drawPixel(x, y, color);
+}
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    fillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    drawFastVLine(x, y, h, color);
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        _swap_int16_t(x0, y0);
+        _swap_int16_t(x1, y1);
+    }
+
+    if (x0 > x1)
+    {
+        _swap_int16_t(x0, x1);
+        _swap_int16_t(y0, y1);
+    }
+
+    int16_t dx, dy;
+    dx = x1 - x0;
+    dy = abs(y1 - y0);
+
+    int16_t err = dx / 2;
+    int16_t ystep;
+
+    if (y0 < y1)
+        ystep = 1;
+    else
+        ystep = -1;
+
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+            writePixel(y0, x0, color);
+        else
+            writePixel(x0, y0, color);
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::endWrite()
+{
+}
+
+void Adafruit_GFX::setRotation(uint8_t x)
+{
+    rotation = (x & 3);
+    switch (rotation)
+    {
+    case 0:
+    case 2:
+        _width = WIDTH;
+        _height = HEIGHT;
+        break;
+    case 1:
+    case 3:
+        _width = HEIGHT;
+        _height = WIDTH;
+        break;
+    }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    startWrite();
+    writeLine(x, y, x, y + h - 1, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    startWrite();
+    writeLine(x, y, x + w - 1, y, color);
+    endWrite();
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    startWrite();
+    for (int16_t i = x; i < x + w; i++)
+        writeFastVLine(i, y, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (x0 == x1)
+    {
+        if (y0 > y1)
+            _swap_int16_t(y0, y1);
+        drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    }
+    else if (y0 == y1)
+    {
+        if (x0 > x1)
+            _swap_int16_t(x0, x1);
+        drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    }
+    else
+    {
+        startWrite();
+        writeLine(x0, y0, x1, y1, color);
+        endWrite();
+    }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    int16_t a, b, y, last;
+
+    // Sort coordinates by Y order (y2 >= y1 >= y0)
+    if (y0 > y1)
+    {
+        _swap_int16_t(y0, y1);
+        _swap_int16_t(x0, x1);
+    }
+    if (y1 > y2)
+    {
+        _swap_int16_t(y2, y1);
+        _swap_int16_t(x2, x1);
+    }
+    if (y0 > y1)
+    {
+        _swap_int16_t(y0, y1);
+        _swap_int16_t(x0, x1);
+    }
+
+    startWrite();
+    if (y0 == y2)
+    {
+        a = b = x0;
+        if (x1 < a)
+            a = x1;
+        else if (x1 > b)
+            b = x1;
+        if (x2 < a)
+            a = x2;
+        else if (x2 > b)
+            b = x2;
+        writeFastHLine(a, y0, b - a + 1, color);
+        endWrite();
+        return;
+    }
+
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+            dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+
+    if (y1 == y2)
+        last = y1;
+    else
+        last = y1 - 1;
+
+    for (y = y0; y <= last; y++)
+    {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b)
+            _swap_int16_t(a, b);
+        writeFastHLine(a, y, b - a + 1, color);
+    }
+
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++)
+    {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b)
+            _swap_int16_t(a, b);
+        writeFastHLine(a, y, b - a + 1, color);
+    }
+    endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+    int16_t byteWidth = (w + 7) / 8;
+    uint8_t b = 0;
+
+    startWrite();
+    for (int16_t j = 0; j < h; j++, y++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            if (i & 7)
+                b <<= 1;
+            else
+                b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+            writePixel(x + i, y, (b & 0x80) ? color : bg);
+        }
+    }
+    endWrite();
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y)
+{
+    if (gfxFont == NULL)
+        return;
+
+    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+    GFXglyph *glyph = ((GFXglyph *)pgm_read_ptr(&gfxFont->glyph)) + c;
+    uint8_t *bitmap = (uint8_t *)pgm_read_ptr(&gfxFont->bitmap);
+
+    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+    int8_t xo = pgm_read_byte(&glyph->xOffset), yo = pgm_read_byte(&glyph->yOffset);
+    uint8_t xx, yy, bits = 0, bit = 0;
+    int16_t xo16 = 0, yo16 = 0;
+
+    if (size_x > 1 || size_y > 1)
+    {
+        xo16 = xo;
+        yo16 = yo;
+    }
+
+    startWrite();
+    for (yy = 0; yy < h; yy++)
+    {
+        for (xx = 0; xx < w; xx++)
+        {
+            if (!(bit++ & 7))
+                bits = pgm_read_byte(&bitmap[bo++]);
+            if (bits & 0x80)
+            {
+                if (size_x == 1 && size_y == 1)
+                    writePixel(x + xo + xx, y + yo + yy, color);
+                else
+                    writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y, size_x, size_y, color);
+            }
+            bits <<= 1;
+        }
+    }
+    endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if (gfxFont == NULL)
+    {
+        // The classic font isn't drawn, but it takes up the same room
+        if (c == '\n')
+        {
+            cursor_x = 0;
+            cursor_y += textsize_y * 8;
+        }
+        else if (c != '\r')
+        {
+            cursor_x += textsize_x * 6;
+        }
+        return 1;
+    }
+
+    if (c == '\n')
+    {
+        cursor_x = 0;
+        cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+    }
+    else if (c != '\r')
+    {
+        uint8_t first = pgm_read_byte(&gfxFont->first);
+        if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last)))
+        {
+            GFXglyph *glyph = ((GFXglyph *)pgm_read_ptr(&gfxFont->glyph)) + (c - first);
+            uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+            if ((w > 0) && (h > 0))
+            {
+                int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset);
+                if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width))
+                {
+                    cursor_x = 0;
+                    cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+                }
+                drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+            }
+            cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
+        }
+    }
+    return 1;
+}
+
+void Adafruit_GFX::setTextSize(uint8_t s)
+{
+    textsize_x = (s > 0) ? s : 1;
+    textsize_y = (s > 0) ? s : 1;
+}
+
+void Adafruit_GFX::setFont(const GFXfont *f)
+{
+    if (f)
+    {
+        // Custom fonts draw from the baseline, the classic one from the top
+        if (!gfxFont)
+            cursor_y += 6;
+    }
+    else if (gfxFont)
+    {
+        cursor_y -= 6;
+    }
+    gfxFont = (GFXfont *)f;
+}
+
+void Adafruit_GFX::setCursor(int16_t x, int16_t y)
+{
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c)
+{
+    textcolor = textbgcolor = c;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c, uint16_t bg)
+{
+    textcolor = c;
+    textbgcolor = bg;
+}
+
+void Adafruit_GFX::setTextWrap(bool w)
+{
+    wrap = w;
+}
+
+int16_t Adafruit_GFX::width() const
+{
+    return _width;
+}
+
+int16_t Adafruit_GFX::height() const
+{
+    return _height;
+}
+
+uint8_t Adafruit_GFX::getRotation() const
+{
+    return rotation;
+}
+
+int16_t Adafruit_GFX::getCursorX() const
+{
+    return cursor_x;
+}
+
+int16_t Adafruit_GFX::getCursorY() const
+{
+    return cursor_y;
+}
+
+// Where a pixel in the rotated coordinates is in the buffer
+static void rotate(uint8_t rotation, int16_t w, int16_t h, int16_t *x, int16_t *y)
+{
+    int16_t t;
+    switch (rotation)
+    {
+    case 1:
+        t = *x;
+        *x = w - 1 - *y;
+        *y = t;
+        break;
+    case 2:
+        *x = w - 1 - *x;
+        *y = h - 1 - *y;
+        break;
+    case 3:
+        t = *x;
+        *x = *y;
+        *y = h - 1 - t;
+        break;
+    }
+}
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h)
+{
+    uint32_t bytes = ((w + 7) / 8) * h;
+    if ((buffer = (uint8_t *)malloc(bytes)))
+        memset(buffer, 0, bytes);
+}
+
+GFXcanvas1::~GFXcanvas1()
+{
+    free(buffer);
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (buffer == NULL || x < 0 || y < 0 || x >= _width || y >= _height)
+        return;
+
+    rotate(rotation, WIDTH, HEIGHT, &x, &y);
+
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+    if (color)
+        *ptr |= 0x80 >> (x & 7);
+    else
+        *ptr &= ~(0x80 >> (x & 7));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color)
+{
+    if (buffer)
+        memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const
+{
+    rotate(rotation, WIDTH, HEIGHT, &x, &y);
+    if (buffer == NULL || x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+        return false;
+    return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
+
+uint8_t *GFXcanvas1::getBuffer() const
+{
+    return buffer;
+}
+
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h)
+{
+    uint32_t bytes = w * h * 2;
+    if ((buffer = (uint16_t *)malloc(bytes)))
+        memset(buffer, 0, bytes);
+}
+
+GFXcanvas16::~GFXcanvas16()
+{
+    free(buffer);
+}
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (buffer == NULL || x < 0 || y < 0 || x >= _width || y >= _height)
+        return;
+
+    rotate(rotation, WIDTH, HEIGHT, &x, &y);
+
+    buffer[x + y * WIDTH] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color)
+{
+    if (buffer == NULL)
+        return;
+
+    for (uint32_t i = 0; i < (uint32_t)WIDTH * HEIGHT; i++)
+        buffer[i] = color;
+}
+
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const
+{
+    rotate(rotation, WIDTH, HEIGHT, &x, &y);
+    if (buffer == NULL || x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+        return 0;
+    return buffer[x + y * WIDTH];
+}
+
+uint16_t *GFXcanvas16::getBuffer() const
+{
+    return buffer;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+    The parts of Adafruit GFX the dashboard draws with, for the host tests.
+
+    Drawing, text and the canvases work the same as the library, down to
+    which pixels a glyph or a triangle lights up, so a frame drawn here
+    hashes the same as one drawn on the display with the same fonts. Only
+    GFX fonts are drawn; the classic 5x7 font isn't, it just moves the
+    cursor.
+*/
+
+#include "Arduino.h"
+#include "gfxfont.h"
+
+class Adafruit_GFX : public Print
+{
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite();
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    virtual void endWrite();
+
+    virtual void setRotation(uint8_t r);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y);
+
+    void setTextSize(uint8_t s);
+    void setFont(const GFXfont *f = NULL);
+    void setCursor(int16_t x, int16_t y);
+    void setTextColor(uint16_t c);
+    void setTextColor(uint16_t c, uint16_t bg);
+    void setTextWrap(bool w);
+
+    using Print::write;
+    virtual size_t write(uint8_t c) override;
+
+    int16_t width() const;
+    int16_t height() const;
+    uint8_t getRotation() const;
+    int16_t getCursorX() const;
+    int16_t getCursorY() const;
+
+protected:
+    int16_t WIDTH;
+    int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize_x;
+    uint8_t textsize_y;
+    uint8_t rotation;
+    bool wrap;
+    GFXfont *gfxFont;
+};
+
+class GFXcanvas1 : public Adafruit_GFX
+{
+public:
+    GFXcanvas1(uint16_t w, uint16_t h);
+    ~GFXcanvas1();
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y) const;
+    uint8_t *getBuffer() const;
+
+private:
+    uint8_t *buffer;
+};
+
+class GFXcanvas16 : public Adafruit_GFX
+{
+public:
+    GFXcanvas16(uint16_t w, uint16_t h);
+    ~GFXcanvas16();
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    uint16_t getPixel(int16_t x, int16_t y) const;
+    uint16_t *getBuffer() const;
+
+private:
+    uint16_t *buffer;
+};
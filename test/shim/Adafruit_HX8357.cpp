@@ -0,0 +1,185 @@
+#include "Adafruit_HX8357.h"
+
+// CASET and four bytes, PASET and four bytes, RAMWR
+#define ADDRESS_WINDOW_BYTES 11
+
+static Adafruit_HX8357 *lastPanel = NULL;
+
+Adafruit_HX8357 *shimPanel()
+{
+    return lastPanel;
+}
+
+Adafruit_HX8357::Adafruit_HX8357(int8_t cs, int8_t dc, int8_t rst, uint8_t type)
+    : GFXcanvas16(HX8357_TFTWIDTH, HX8357_TFTHEIGHT)
+{
+    frequency = HX8357_SHIM_DEFAULT_FREQ;
+    sent = 0;
+    windowX = windowY = windowW = windowH = 0;
+    windowNext = 0;
+    lastPanel = this;
+}
+
+void Adafruit_HX8357::begin(uint32_t freq)
+{
+    frequency = freq ? freq : HX8357_SHIM_DEFAULT_FREQ;
+    delay(HX8357_SHIM_BEGIN_MS);
+    setRotation(0);
+}
+
+void Adafruit_HX8357::setRotation(uint8_t r)
+{
+    GFXcanvas16::setRotation(r);
+    send(2); // MADCTL
+}
+
+void Adafruit_HX8357::sendCommand(uint8_t commandByte, const uint8_t *dataBytes, uint8_t numDataBytes)
+{
+    send(1 + numDataBytes);
+}
+
+// What a panel that's just been set up answers
+uint8_t Adafruit_HX8357::readcommand8(uint8_t commandByte, uint8_t index)
+{
+    send(3);
+    switch (commandByte)
+    {
+    case HX8357_RDPOWMODE:
+        return 0x9C;
+    case HX8357_RDMADCTL:
+        return 0xC0;
+    case HX8357_RDCOLMOD:
+        return 0x55;
+    case HX8357_RDDSDR:
+        return 0xC0;
+    default:
+        return 0x00;
+    }
+}
+
+void Adafruit_HX8357::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    windowX = x;
+    windowY = y;
+    windowW = w;
+    windowH = h;
+    windowNext = 0;
+    send(ADDRESS_WINDOW_BYTES);
+}
+
+// Fills the address window left to right, top to bottom
+void Adafruit_HX8357::writePixels(uint16_t *colors, uint32_t len, bool block, bool bigEndian)
+{
+    uint32_t area = (uint32_t)windowW * windowH;
+    for (uint32_t i = 0; i < len && area > 0; i++)
+    {
+        uint32_t at = windowNext++ % area;
+        GFXcanvas16::drawPixel(windowX + at % windowW, windowY + at / windowW, colors[i]);
+    }
+    send(len * 2);
+}
+
+void Adafruit_HX8357::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    startWrite();
+    writePixel(x, y, color);
+    endWrite();
+}
+
+void Adafruit_HX8357::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || x >= _width || y < 0 || y >= _height)
+        return;
+
+    GFXcanvas16::drawPixel(x, y, color);
+    send(ADDRESS_WINDOW_BYTES + 2);
+}
+
+// Clipped the way Adafruit_SPITFT does it
+void Adafruit_HX8357::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (w == 0 || h == 0)
+        return;
+    if (w < 0)
+    {
+        x += w + 1;
+        w = -w;
+    }
+    if (h < 0)
+    {
+        y += h + 1;
+        h = -h;
+    }
+
+    int16_t x2 = x + w - 1;
+    int16_t y2 = y + h - 1;
+    if (x >= _width || y >= _height || x2 < 0 || y2 < 0)
+        return;
+    if (x < 0)
+    {
+        x = 0;
+        w = x2 + 1;
+    }
+    if (y < 0)
+    {
+        y = 0;
+        h = y2 + 1;
+    }
+    if (x2 >= _width)
+        w = _width - x;
+    if (y2 >= _height)
+        h = _height - y;
+
+    for (int16_t row = y; row < y + h; row++)
+        for (int16_t column = x; column < x + w; column++)
+            GFXcanvas16::drawPixel(column, row, color);
+    send(ADDRESS_WINDOW_BYTES + (uint32_t)w * h * 2);
+}
+
+void Adafruit_HX8357::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    writeFillRect(x, y, 1, h, color);
+}
+
+void Adafruit_HX8357::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    writeFillRect(x, y, w, 1, color);
+}
+
+void Adafruit_HX8357::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    startWrite();
+    writeFillRect(x, y, w, h, color);
+    endWrite();
+}
+
+void Adafruit_HX8357::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    startWrite();
+    writeFillRect(x, y, 1, h, color);
+    endWrite();
+}
+
+void Adafruit_HX8357::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    startWrite();
+    writeFillRect(x, y, w, 1, color);
+    endWrite();
+}
+
+// The panel has no fast clear, it's one big fill
+void Adafruit_HX8357::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+uint64_t Adafruit_HX8357::busBytes() const
+{
+    return sent;
+}
+
+void Adafruit_HX8357::send(uint32_t bytes)
+{
+    sent += bytes;
+    shimAdvanceNanos((uint64_t)bytes * 8 * 1000000000ULL / frequency);
+}
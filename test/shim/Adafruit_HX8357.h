@@ -0,0 +1,90 @@
+#pragma once
+
+/*
+    A pretend HX8357 for the host tests.
+
+    What's drawn lands in a 16 bit canvas the size of the panel, so a test
+    can check the screen matches the page cache. Every draw also keeps the
+    clock (see Arduino.h) busy for as long as the SPI bytes the real
+    library would send take at the bus speed begin() picks, so the render
+    timings include the pushes to the panel. The byte counts follow
+    Adafruit_SPITFT: an 11 byte address window before each pixel, fill
+    and block of pixels, then 2 bytes a pixel.
+*/
+
+#include "Adafruit_GFX.h"
+
+#define HX8357D 0xD
+#define HX8357B 0xB
+
+#define HX8357_TFTWIDTH 320
+#define HX8357_TFTHEIGHT 480
+
+#define HX8357_SLPIN 0x10
+#define HX8357_SLPOUT 0x11
+#define HX8357_DISPOFF 0x28
+#define HX8357_DISPON 0x29
+#define HX8357_RDPOWMODE 0x0A
+#define HX8357_RDMADCTL 0x0B
+#define HX8357_RDCOLMOD 0x0C
+#define HX8357_RDDIM 0x0D
+#define HX8357_RDDSDR 0x0F
+
+#define HX8357_BLACK 0x0000
+#define HX8357_BLUE 0x001F
+#define HX8357_RED 0xF800
+#define HX8357_GREEN 0x07E0
+#define HX8357_CYAN 0x07FF
+#define HX8357_MAGENTA 0xF81F
+#define HX8357_YELLOW 0xFFE0
+#define HX8357_WHITE 0xFFFF
+
+// What Adafruit_HX8357::begin() runs the bus at if it isn't told
+#define HX8357_SHIM_DEFAULT_FREQ 16000000
+
+// How long begin() waits on the panel: Adafruit_SPITFT's hardware reset
+// (100ms high, 100ms low, 200ms after) and the HX8357D init list's waits
+// after SWRESET, SLPOUT and DISPON
+#define HX8357_SHIM_BEGIN_MS 700
+
+class Adafruit_HX8357 : public GFXcanvas16
+{
+public:
+    Adafruit_HX8357(int8_t cs, int8_t dc, int8_t rst = -1, uint8_t type = HX8357D);
+
+    void begin(uint32_t freq = 0);
+    void setRotation(uint8_t r) override;
+    void sendCommand(uint8_t commandByte, const uint8_t *dataBytes = NULL, uint8_t numDataBytes = 0);
+    uint8_t readcommand8(uint8_t commandByte, uint8_t index = 0);
+
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void writePixels(uint16_t *colors, uint32_t len, bool block = true, bool bigEndian = false);
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+
+    // Not Adafruit: how many bytes have gone over the bus
+    uint64_t busBytes() const;
+
+private:
+    void send(uint32_t bytes);
+
+    uint32_t frequency;
+    uint64_t sent;
+
+    int16_t windowX;
+    int16_t windowY;
+    int16_t windowW;
+    int16_t windowH;
+    uint32_t windowNext;
+};
+
+// Not Adafruit: the panel that was made last, for tests to look at
+Adafruit_HX8357 *shimPanel();
@@ -0,0 +1,74 @@
+#include <chrono>
+
+#include "Arduino.h"
+
+static uint64_t advancedNanos = 0;
+
+static uint64_t hostNanos()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+void shimAdvanceNanos(uint64_t nanos)
+{
+    advancedNanos += nanos;
+}
+
+unsigned long micros()
+{
+    return (unsigned long)((hostNanos() + advancedNanos) / 1000);
+}
+
+unsigned long millis()
+{
+    return (unsigned long)((hostNanos() + advancedNanos) / 1000000);
+}
+
+void delay(unsigned long ms)
+{
+    advancedNanos += (uint64_t)ms * 1000000;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+}
+
+void *ps_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void *ps_calloc(size_t count, size_t size)
+{
+    return calloc(count, size);
+}
+
+size_t Print::write(const char *text)
+{
+    size_t written = 0;
+    while (*text)
+        written += write((uint8_t)*text++);
+    return written;
+}
+
+size_t Print::print(const char *text)
+{
+    return write(text);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return write(buffer);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+/*
+    Just enough of the Arduino core for the parts of the firmware that don't
+    touch hardware to build and run on the host, so they can be tested there.
+
+    micros() and millis() are the host's clock plus however long the fake
+    panel (see Adafruit_HX8357.h) has kept the SPI bus busy, so anything
+    timed on the host includes the pushes to the screen.
+*/
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+typedef bool boolean;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+// There's no PSRAM on the host, it's all just heap
+void *ps_malloc(size_t size);
+void *ps_calloc(size_t count, size_t size);
+
+// Not Arduino: pushes the clock on, for time spent on a bus that isn't there
+void shimAdvanceNanos(uint64_t nanos);
+
+class Print
+{
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    size_t write(const char *text);
+    size_t print(const char *text);
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+// screen.h pulls this in, but nothing the host tests build uses it
@@ -0,0 +1,268 @@
+// Stand-in for the Adafruit GFX FreeSans12pt7b, for host tests only.
+// Made by test/shim/make-fonts.py, don't edit it.
+
+#pragma once
+
+const uint8_t FreeSans12pt7bBitmaps[] PROGMEM = {
+  0x7F, 0xDF, 0xFF, 0x03, 0x60, 0x6C, 0x19, 0x83, 0x30, 0xC6, 0x18, 0xC6,
+  0x19, 0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C, 0x07, 0x00, 0x40, 0x00,
+  0x4B, 0x3D, 0xFF, 0xFD, 0xE0, 0x7F, 0xDF, 0xFF, 0x01, 0xE0, 0x3C, 0x07,
+  0x80, 0xF0, 0x1F, 0xFF, 0xFF, 0xF8, 0x0F, 0x01, 0xE0, 0x3C, 0x07, 0x80,
+  0xF0, 0x1F, 0xFF, 0x7F, 0xC0, 0x7F, 0xDF, 0xFF, 0x00, 0x60, 0x0C, 0x01,
+  0x80, 0x30, 0x07, 0xFF, 0xFF, 0xF8, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80,
+  0x30, 0x06, 0x00, 0x40, 0x00, 0x40, 0x01, 0x60, 0x00, 0xF0, 0x00, 0xD8,
+  0x00, 0xCC, 0x00, 0xC6, 0x00, 0xC3, 0x00, 0xC1, 0x80, 0xC0, 0xC0, 0xC0,
+  0x60, 0xC0, 0x30, 0xC0, 0x18, 0xC0, 0x0C, 0xC0, 0x06, 0xC0, 0x03, 0xC0,
+  0x01, 0xFF, 0xFF, 0x7F, 0xFF, 0x00, 0x7F, 0xDF, 0xFF, 0x03, 0xE0, 0x7C,
+  0x1F, 0x83, 0xF0, 0xDE, 0x1B, 0xC6, 0x79, 0x8F, 0x31, 0xEC, 0x3D, 0x87,
+  0xE0, 0xFC, 0x1F, 0x03, 0x40, 0x40, 0x5F, 0xFE, 0x80, 0x4B, 0x3C, 0xF3,
+  0xCF, 0x3D, 0xB6, 0xDB, 0x6D, 0xBC, 0xF3, 0xCF, 0x3C, 0xE3, 0x8E, 0x38,
+  0xFD, 0xE0, 0x4B, 0x3C, 0xF3, 0xCF, 0x3E, 0xFB, 0xEF, 0xBF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xDF, 0x7D, 0xF7, 0xDD, 0x20, 0x7D, 0xFF, 0x87, 0x8D, 0x99,
+  0x91, 0x00, 0x40, 0xB0, 0x3C, 0x1B, 0x0C, 0xC6, 0x33, 0x0D, 0x83, 0xC0,
+  0xFF, 0xDF, 0xE0, 0x5F, 0xFE, 0x80, 0xFF, 0xF0, 0x5D, 0x00, 0x7B, 0xFC,
+  0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x0C,
+  0x30, 0xC1, 0x00, 0x7F, 0xDF, 0xFF, 0x01, 0xE0, 0x3C, 0x07, 0x80, 0xF0,
+  0x1E, 0x03, 0xC0, 0x78, 0x0F, 0x01, 0xE0, 0x3C, 0x07, 0x80, 0xF0, 0x1E,
+  0x03, 0x40, 0x40, 0x4B, 0x3C, 0xF3, 0xCF, 0x3C, 0xF3, 0xCF, 0x3C, 0xF3,
+  0xCF, 0x3C, 0xFF, 0x78, 0x7F, 0xDF, 0xFF, 0x03, 0x60, 0x6C, 0x19, 0x83,
+  0x30, 0xC7, 0xFF, 0xFF, 0xF9, 0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C,
+  0x07, 0xFF, 0x7F, 0xC0, 0x40, 0x58, 0x0F, 0x03, 0xE0, 0x7C, 0x1F, 0x83,
+  0xF0, 0xDF, 0xFF, 0xFF, 0xF9, 0x8F, 0x31, 0xEC, 0x3D, 0x87, 0xE0, 0xFC,
+  0x1F, 0x03, 0x40, 0x40, 0x40, 0x18, 0x03, 0x80, 0x70, 0x0F, 0x01, 0xE0,
+  0x36, 0x06, 0xC0, 0xCC, 0x18, 0xC3, 0x18, 0x61, 0x8C, 0x31, 0x83, 0x30,
+  0x67, 0xFF, 0x7F, 0xC0, 0x7F, 0xDF, 0xFF, 0x80, 0x70, 0x0F, 0x01, 0xE0,
+  0x36, 0x06, 0xC0, 0xCC, 0x18, 0xC3, 0x18, 0x61, 0x8C, 0x31, 0x83, 0x30,
+  0x66, 0x06, 0x40, 0x40, 0x40, 0x58, 0x0F, 0x81, 0xF0, 0x3F, 0x07, 0xE0,
+  0xF6, 0x1F, 0xFF, 0xFF, 0xF8, 0xCF, 0x19, 0xE1, 0xBC, 0x37, 0x83, 0xF0,
+  0x7E, 0x07, 0x40, 0x40, 0x7F, 0xDF, 0xFF, 0x81, 0xF0, 0x3F, 0x07, 0xE0,
+  0xF6, 0x1F, 0xFF, 0xFF, 0xF8, 0xCF, 0x19, 0xE1, 0xBC, 0x37, 0x83, 0xF0,
+  0x7F, 0xFF, 0x7F, 0xC0, 0x7F, 0xDF, 0xFF, 0x03, 0x60, 0x6C, 0x19, 0x83,
+  0x30, 0xC7, 0xFF, 0xFF, 0xF9, 0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C,
+  0x07, 0x00, 0x40, 0x00, 0x40, 0x58, 0x0F, 0x03, 0x60, 0x6C, 0x19, 0x83,
+  0x30, 0xC7, 0xFF, 0xFF, 0xF9, 0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C,
+  0x07, 0xFF, 0x7F, 0xC0, 0x5F, 0xFF, 0xFF, 0xFF, 0xA0, 0x5F, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xD0, 0x40, 0x58, 0x0F, 0x03, 0x60, 0x6C, 0x19, 0x83, 0x30,
+  0xC7, 0xFF, 0xFF, 0xF9, 0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C, 0x07,
+  0xFF, 0x7F, 0xC0, 0x40, 0xB0, 0x3C, 0x0F, 0x03, 0xFF, 0xDF, 0xE0, 0x7F,
+  0xDF, 0xFF, 0x03, 0x60, 0x6C, 0x19, 0x83, 0x30, 0xC6, 0x18, 0xC6, 0x19,
+  0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C, 0x07, 0x00, 0x40, 0x00, 0x40,
+  0x58, 0x0F, 0x03, 0x60, 0x6C, 0x19, 0x83, 0x30, 0xC7, 0xFF, 0xFF, 0xF9,
+  0x83, 0x30, 0x6C, 0x0D, 0x81, 0xE0, 0x3C, 0x07, 0xFF, 0x7F, 0xC0, 0x40,
+  0x00, 0x2C, 0x00, 0x07, 0xC0, 0x00, 0xFC, 0x00, 0x1B, 0xC0, 0x03, 0x3C,
+  0x00, 0x63, 0xC0, 0x0C, 0x3C, 0x01, 0x83, 0xC0, 0x60, 0x3C, 0x0C, 0x03,
+  0xC1, 0x80, 0x3C, 0x30, 0x03, 0xC6, 0x00, 0x3C, 0xC0, 0x03, 0xD8, 0x00,
+  0x3F, 0xFF, 0xFF, 0x7F, 0xFF, 0xE0, 0x7F, 0xFB, 0xFF, 0xFE, 0x00, 0xFC,
+  0x03, 0xD8, 0x0F, 0x60, 0x3C, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0x0C, 0x3C,
+  0x18, 0xF0, 0x33, 0xC0, 0x6F, 0x01, 0xBC, 0x03, 0xFF, 0xFF, 0x7F, 0xF8,
+  0x40, 0x0C, 0x00, 0xE0, 0x0E, 0x00, 0xF0, 0x0D, 0x80, 0xD8, 0x0F, 0xFF,
+  0xFF, 0xFC, 0x60, 0xC3, 0x0C, 0x30, 0xC1, 0x8C, 0x0C, 0xC0, 0xCC, 0x06,
+  0x40, 0x20, 0x7F, 0xF7, 0xFF, 0xF0, 0x0D, 0x80, 0xCC, 0x06, 0x60, 0x63,
+  0x06, 0x18, 0x30, 0xC3, 0x06, 0x30, 0x31, 0x81, 0x98, 0x0D, 0x80, 0x6C,
+  0x03, 0xC0, 0x1F, 0xFF, 0x7F, 0xF0, 0x7F, 0xFB, 0xFF, 0xFC, 0x01, 0xF0,
+  0x0F, 0xC0, 0x6F, 0x01, 0xBC, 0x0C, 0xF0, 0x63, 0xC3, 0x0F, 0x0C, 0x3C,
+  0x60, 0xF3, 0x03, 0xD8, 0x0F, 0x60, 0x3F, 0x00, 0xF8, 0x03, 0x40, 0x08,
+  0x40, 0x05, 0x80, 0x0F, 0x00, 0x3E, 0x00, 0xFC, 0x03, 0x78, 0x0C, 0xF0,
+  0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x86, 0x0F, 0x18, 0x1E, 0x30, 0x3C, 0xC0,
+  0x7B, 0x00, 0xFC, 0x01, 0xF0, 0x03, 0x40, 0x04, 0x7F, 0xEF, 0xFF, 0xC0,
+  0x6C, 0x06, 0xC0, 0xCC, 0x18, 0xC1, 0x8F, 0xFF, 0xFF, 0xFC, 0x60, 0xCC,
+  0x0C, 0xC0, 0xD8, 0x0F, 0x00, 0xF0, 0x0F, 0xFF, 0x7F, 0xE0, 0x40, 0x06,
+  0x00, 0x30, 0x01, 0x80, 0x0C, 0x00, 0x60, 0x03, 0x00, 0x18, 0x00, 0xC0,
+  0x06, 0x00, 0x30, 0x01, 0x80, 0x0C, 0x00, 0x60, 0x03, 0x00, 0x18, 0x00,
+  0x40, 0x00, 0x40, 0x06, 0x00, 0x30, 0x01, 0x80, 0x0C, 0x00, 0x60, 0x03,
+  0x00, 0x1F, 0xFF, 0xFF, 0xFE, 0x00, 0x30, 0x01, 0x80, 0x0C, 0x00, 0x60,
+  0x03, 0x00, 0x1F, 0xFF, 0x7F, 0xF0, 0x5F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x40, 0x40, 0x05, 0x80, 0x0F, 0x00, 0x3E, 0x00, 0xFC, 0x03, 0x78, 0x0C,
+  0xF0, 0x19, 0xE0, 0x63, 0xC1, 0x87, 0x86, 0x0F, 0x18, 0x1E, 0x30, 0x3C,
+  0xC0, 0x7B, 0x00, 0xFC, 0x01, 0xF0, 0x03, 0x40, 0x04, 0x7F, 0xFB, 0xFF,
+  0xFE, 0x00, 0xFC, 0x03, 0xD8, 0x0F, 0x60, 0x3C, 0xC0, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x0C, 0x3C, 0x18, 0xF0, 0x33, 0xC0, 0x6F, 0x01, 0xBC, 0x03, 0xFF,
+  0xFF, 0x7F, 0xF8, 0x7F, 0xF7, 0xFF, 0xF8, 0x01, 0xE0, 0x0F, 0x00, 0x6C,
+  0x03, 0x30, 0x1F, 0xFF, 0xFF, 0xFE, 0x18, 0x30, 0xC1, 0x83, 0x0C, 0x0C,
+  0x60, 0x63, 0x01, 0x98, 0x06, 0x40, 0x10, 0x40, 0x00, 0x60, 0x00, 0x38,
+  0x00, 0x1E, 0x00, 0x0D, 0x80, 0x06, 0x60, 0x03, 0x18, 0x01, 0x86, 0x00,
+  0xC1, 0x80, 0x60, 0x60, 0x30, 0x18, 0x18, 0x06, 0x0C, 0x01, 0x86, 0x00,
+  0x63, 0x00, 0x19, 0x80, 0x06, 0x40, 0x01, 0x00, 0x7F, 0xFB, 0xFF, 0xFE,
+  0x00, 0xFC, 0x03, 0xD8, 0x0F, 0x60, 0x3C, 0xC0, 0xF1, 0x83, 0xC3, 0x0F,
+  0x0C, 0x3C, 0x18, 0xF0, 0x33, 0xC0, 0x6F, 0x01, 0xBC, 0x03, 0xFF, 0xFF,
+  0x7F, 0xF8, 0x40, 0x05, 0x80, 0x0F, 0x00, 0x3E, 0x00, 0xFC, 0x03, 0x78,
+  0x0C, 0xF0, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x86, 0x0F, 0x18, 0x1E, 0x30,
+  0x3C, 0xC0, 0x7B, 0x00, 0xFC, 0x01, 0xF0, 0x03, 0x40, 0x04, 0x40, 0x2C,
+  0x03, 0xC0, 0x6C, 0x06, 0xC0, 0xCC, 0x18, 0xC1, 0x8C, 0x30, 0xC6, 0x0C,
+  0x60, 0xCC, 0x0C, 0xC0, 0xD8, 0x0F, 0x00, 0xF0, 0x0E, 0x00, 0x40, 0x00,
+  0x7F, 0xF7, 0xFF, 0xF0, 0x0D, 0x80, 0xCC, 0x06, 0x60, 0x63, 0x06, 0x1F,
+  0xFF, 0xFF, 0xFE, 0x30, 0x31, 0x81, 0x98, 0x0D, 0x80, 0x6C, 0x03, 0xC0,
+  0x1C, 0x00, 0x40, 0x00, 0x7F, 0xF7, 0xFF, 0xF0, 0x01, 0x80, 0x0C, 0x00,
+  0x60, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x06, 0x00, 0x30, 0x01, 0x80, 0x0C,
+  0x00, 0x60, 0x03, 0x00, 0x1F, 0xFF, 0x7F, 0xF0, 0x40, 0x0C, 0x00, 0xC0,
+  0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC0,
+  0x0C, 0x00, 0xC0, 0x0C, 0x00, 0xC0, 0x0C, 0x00, 0x40, 0x00, 0x40, 0x05,
+  0x80, 0x0F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x78, 0x00, 0xF0, 0x01, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x80, 0x0F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x78, 0x00,
+  0xF0, 0x01, 0xE0, 0x03, 0x40, 0x04, 0x7F, 0xFB, 0xFF, 0xFC, 0x00, 0xF0,
+  0x03, 0xC0, 0x0F, 0x00, 0x3C, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x3C,
+  0x00, 0xF0, 0x03, 0xC0, 0x0F, 0x00, 0x3C, 0x00, 0xFF, 0xFF, 0x7F, 0xF8,
+  0x40, 0x16, 0x00, 0xF0, 0x0D, 0x80, 0xCC, 0x06, 0x60, 0x63, 0x06, 0x18,
+  0x30, 0xC3, 0x06, 0x30, 0x31, 0x81, 0x98, 0x0D, 0x80, 0x6C, 0x03, 0xC0,
+  0x1C, 0x00, 0x40, 0x00, 0x7F, 0xFF, 0xEF, 0xFF, 0xFF, 0xC0, 0x00, 0xCC,
+  0x00, 0x18, 0xC0, 0x03, 0x0C, 0x00, 0x60, 0xC0, 0x0C, 0x0C, 0x01, 0x80,
+  0xC0, 0x60, 0x0C, 0x0C, 0x00, 0xC1, 0x80, 0x0C, 0x30, 0x00, 0xC6, 0x00,
+  0x0C, 0xC0, 0x00, 0xD8, 0x00, 0x0F, 0xFF, 0xFF, 0x7F, 0xFF, 0xE0, 0x7F,
+  0xFB, 0xFF, 0xFE, 0x00, 0xFC, 0x03, 0xD8, 0x0F, 0x60, 0x3C, 0xC0, 0xF1,
+  0x83, 0xC3, 0x0F, 0x0C, 0x3C, 0x18, 0xF0, 0x33, 0xC0, 0x6F, 0x01, 0xBC,
+  0x03, 0xFF, 0xFF, 0x7F, 0xF8, 0x40, 0x05, 0x80, 0x0F, 0x80, 0x1F, 0x80,
+  0x3D, 0x80, 0x79, 0x80, 0xF3, 0x01, 0xE3, 0x03, 0xC3, 0x07, 0x83, 0x0F,
+  0x03, 0x1E, 0x06, 0x3C, 0x06, 0x78, 0x06, 0xF0, 0x07, 0xE0, 0x07, 0x40,
+  0x04, 0x7F, 0xEF, 0xFF, 0xC0, 0x6C, 0x06, 0xC0, 0xCC, 0x18, 0xC1, 0x8F,
+  0xFF, 0xFF, 0xFC, 0x60, 0xCC, 0x0C, 0xC0, 0xD8, 0x0F, 0x00, 0xF0, 0x0F,
+  0xFF, 0x7F, 0xE0, 0x4B, 0x3C, 0xF3, 0xCF, 0x3D, 0xB6, 0xDB, 0x6F, 0xFF,
+  0xF3, 0xCF, 0x3C, 0xE3, 0x8E, 0x38, 0xE1, 0x00, 0x4B, 0x3C, 0xF3, 0xCF,
+  0x3D, 0xB6, 0xDB, 0x6D, 0xBC, 0xF3, 0xCF, 0x3C, 0xE3, 0x8E, 0x38, 0xE1,
+  0x00, 0x7B, 0xFC, 0xF3, 0xCF, 0x3D, 0xB6, 0xDB, 0x6D, 0xBC, 0xF3, 0xCF,
+  0x3C, 0xE3, 0x8E, 0x38, 0xFD, 0xE0, 0x42, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3,
+  0x42, 0xFF, 0xFF, 0xFF, 0xC0, 0x6F, 0x40, 0x40, 0x58, 0x0F, 0x03, 0x60,
+  0xCC, 0x31, 0xFF, 0xFF, 0xFE, 0x60, 0xD8, 0x1B, 0x03, 0xC0, 0x7F, 0xF7,
+  0xFC, 0x7F, 0xBF, 0xFC, 0x1F, 0x07, 0xC3, 0xF0, 0xFC, 0x6F, 0x1B, 0xCC,
+  0xF3, 0x3D, 0x8F, 0x63, 0xF0, 0xFC, 0x3E, 0x0F, 0x83, 0x40, 0x80, 0x40,
+  0x58, 0x0F, 0x81, 0xF8, 0x3D, 0x87, 0xB0, 0xF3, 0x1E, 0x33, 0xC3, 0x78,
+  0x6F, 0x07, 0xFF, 0xF7, 0xFC, 0x40, 0xB0, 0x3C, 0x1B, 0x06, 0xC3, 0x30,
+  0xCC, 0x63, 0xFF, 0xFF, 0xF3, 0x0D, 0x83, 0x60, 0xF0, 0x3C, 0x0E, 0x03,
+  0xFF, 0x7F, 0x80, 0x7F, 0xDF, 0xFF, 0x80, 0x78, 0x0D, 0x81, 0xFF, 0xFF,
+  0xFE, 0x30, 0xC3, 0x18, 0x63, 0x06, 0x60, 0x64, 0x04, 0x7B, 0xFC, 0x30,
+  0xE3, 0x8E, 0x38, 0xF3, 0xCF, 0x3C, 0xDB, 0x6D, 0xBF, 0x78, 0x40, 0xB0,
+  0x3C, 0x0F, 0x06, 0xC1, 0xB0, 0xCC, 0x33, 0x18, 0xFF, 0xFF, 0xFC, 0xC3,
+  0x60, 0xD8, 0x3C, 0x0F, 0x03, 0x80, 0xFF, 0xDF, 0xE0, 0x40, 0x58, 0x0F,
+  0x03, 0xE0, 0x7C, 0x1F, 0x83, 0xF0, 0xDE, 0x1B, 0xC6, 0x79, 0x8F, 0x31,
+  0xEC, 0x3D, 0x87, 0xE0, 0xFC, 0x1F, 0x03, 0x40, 0x40, 0x5F, 0xFF, 0xFF,
+  0xFF, 0xF4, 0x46, 0x31, 0x8C, 0x63, 0x18, 0xFF, 0xF1, 0x8C, 0x63, 0x18,
+  0xC2, 0x00, 0x7F, 0xDF, 0xFF, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06,
+  0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00,
+  0x40, 0x00, 0x5F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0x40, 0x05, 0x80,
+  0x1F, 0x00, 0x7E, 0x01, 0xBC, 0x06, 0x7F, 0xFF, 0xFF, 0xFF, 0xE1, 0x83,
+  0xC6, 0x07, 0x98, 0x0F, 0x60, 0x1F, 0x80, 0x34, 0x00, 0x40, 0x7F, 0xBF,
+  0xFC, 0x1B, 0x0C, 0xC3, 0x3F, 0xFF, 0xFF, 0x30, 0xD8, 0x3C, 0x0F, 0x03,
+  0xFF, 0x7F, 0x80, 0x40, 0x18, 0x03, 0x80, 0x78, 0x0D, 0x81, 0xB0, 0x33,
+  0x06, 0x30, 0xC3, 0x18, 0x63, 0x06, 0x7F, 0xF7, 0xFC, 0x40, 0x18, 0x03,
+  0x80, 0x70, 0x0F, 0x01, 0xE0, 0x36, 0x06, 0xC0, 0xFF, 0xFF, 0xFF, 0x18,
+  0x63, 0x0C, 0x31, 0x86, 0x30, 0x66, 0x0C, 0xFF, 0xEF, 0xF8, 0x7F, 0xBF,
+  0xFC, 0x03, 0x80, 0xE0, 0x3C, 0x0F, 0x03, 0x60, 0xD8, 0x33, 0x0C, 0xC3,
+  0x18, 0xC6, 0x30, 0xCC, 0x33, 0x06, 0xC1, 0x90, 0x20, 0x4B, 0x3C, 0xF7,
+  0xDF, 0x7F, 0xFF, 0xFF, 0xBE, 0xFF, 0x78, 0x7F, 0xBF, 0xFE, 0x0F, 0xC3,
+  0xF0, 0xFF, 0xFF, 0xFF, 0x33, 0xC6, 0xF0, 0xFC, 0x3F, 0xFF, 0x7F, 0x80,
+  0x7B, 0xFC, 0xF3, 0xDB, 0x6D, 0xBF, 0xFF, 0xCF, 0x3C, 0xE3, 0x8E, 0x38,
+  0x40, 0x40, 0x58, 0x0F, 0x03, 0x60, 0xCC, 0x31, 0x86, 0x31, 0x86, 0x60,
+  0xD8, 0x1B, 0x03, 0xC0, 0x7F, 0xF7, 0xFC, 0x7F, 0xBF, 0xFC, 0x0F, 0x03,
+  0xC0, 0xF0, 0x3C, 0x0F, 0x03, 0xC0, 0xF0, 0x3C, 0x0F, 0x03, 0x40, 0x80,
+  0x40, 0x05, 0x80, 0x0F, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x7F, 0xFF, 0xFF,
+  0xFF, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x00, 0x1E, 0x00, 0x34, 0x00,
+  0x40, 0x40, 0xB0, 0x3C, 0x1B, 0x0C, 0xC3, 0x31, 0x8C, 0xC3, 0x30, 0xD8,
+  0x3C, 0x0F, 0x03, 0xFF, 0x7F, 0x80, 0x7F, 0xDF, 0xFF, 0x03, 0x60, 0x6C,
+  0x19, 0x83, 0x30, 0xC6, 0x18, 0xFF, 0xFF, 0xFF, 0x30, 0x66, 0x0D, 0x81,
+  0xB0, 0x3C, 0x07, 0x80, 0xE0, 0x08, 0x00, 0x7F, 0xDF, 0xFF, 0x03, 0x60,
+  0xCC, 0x31, 0x86, 0x31, 0x86, 0x60, 0xD8, 0x1B, 0x03, 0xC0, 0x70, 0x04,
+  0x00, 0x4B, 0x3C, 0xF3, 0xCF, 0x3D, 0xB6, 0xDB, 0x6D, 0xBC, 0xF3, 0xCF,
+  0x3C, 0xE3, 0x8E, 0x38, 0xFD, 0xE0, 0x5F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFE, 0x80, 0x7B, 0xFC, 0xF3, 0xCF, 0x3E, 0xFB, 0xEF, 0xBF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xDF, 0x7D, 0xF7, 0xFD, 0xE0, 0x40, 0x58, 0x63, 0xFF,
+  0xBF, 0xE0,
+};
+
+const GFXglyph FreeSans12pt7bGlyphs[] PROGMEM = {
+    {    0,   0,   0,   7,    0,    1}, // 0x20 ' '
+    {    0,  11,  17,  14,    1,  -17}, // 0x21 '!'
+    {   24,   6,   6,   9,    1,  -17}, // 0x22 '"'
+    {   29,  11,  17,  14,    1,  -17}, // 0x23 '#'
+    {   53,  11,  17,  14,    1,  -17}, // 0x24 '$'
+    {   77,  17,  17,  20,    1,  -17}, // 0x25 '%'
+    {  114,  11,  17,  14,    1,  -17}, // 0x26 '&'
+    {  138,   3,   6,   8,    2,  -17}, // 0x27 '''
+    {  141,   6,  22,   9,    1,  -17}, // 0x28 '('
+    {  158,   6,  22,   9,    1,  -17}, // 0x29 ')'
+    {  175,   7,   7,  10,    1,  -17}, // 0x2A '*'
+    {  182,  10,  10,  13,    1,  -12}, // 0x2B '+'
+    {  195,   3,   6,   8,    2,   -3}, // 0x2C ','
+    {  198,   6,   2,   9,    1,   -7}, // 0x2D '-'
+    {  200,   3,   3,   8,    2,   -3}, // 0x2E '.'
+    {  202,   6,  22,   9,    1,  -17}, // 0x2F '/'
+    {  219,  11,  17,  14,    1,  -17}, // 0x30 '0'
+    {  243,   6,  17,   9,    1,  -17}, // 0x31 '1'
+    {  256,  11,  17,  14,    1,  -17}, // 0x32 '2'
+    {  280,  11,  17,  14,    1,  -17}, // 0x33 '3'
+    {  304,  11,  17,  14,    1,  -17}, // 0x34 '4'
+    {  328,  11,  17,  14,    1,  -17}, // 0x35 '5'
+    {  352,  11,  17,  14,    1,  -17}, // 0x36 '6'
+    {  376,  11,  17,  14,    1,  -17}, // 0x37 '7'
+    {  400,  11,  17,  14,    1,  -17}, // 0x38 '8'
+    {  424,  11,  17,  14,    1,  -17}, // 0x39 '9'
+    {  448,   3,  12,   8,    2,  -12}, // 0x3A ':'
+    {  453,   3,  15,   8,    2,  -12}, // 0x3B ';'
+    {  459,  11,  17,  14,    1,  -17}, // 0x3C '<'
+    {  483,  10,   6,  13,    1,  -10}, // 0x3D '='
+    {  491,  11,  17,  14,    1,  -17}, // 0x3E '>'
+    {  515,  11,  17,  14,    1,  -17}, // 0x3F '?'
+    {  539,  20,  17,  23,    1,  -17}, // 0x40 '@'
+    {  582,  14,  17,  17,    1,  -17}, // 0x41 'A'
+    {  612,  12,  17,  15,    1,  -17}, // 0x42 'B'
+    {  638,  13,  17,  16,    1,  -17}, // 0x43 'C'
+    {  666,  14,  17,  17,    1,  -17}, // 0x44 'D'
+    {  696,  15,  17,  18,    1,  -17}, // 0x45 'E'
+    {  728,  12,  17,  15,    1,  -17}, // 0x46 'F'
+    {  754,  13,  17,  16,    1,  -17}, // 0x47 'G'
+    {  782,  13,  17,  16,    1,  -17}, // 0x48 'H'
+    {  810,   3,  17,   8,    2,  -17}, // 0x49 'I'
+    {  817,  15,  17,  18,    1,  -17}, // 0x4A 'J'
+    {  849,  14,  17,  17,    1,  -17}, // 0x4B 'K'
+    {  879,  13,  17,  16,    1,  -17}, // 0x4C 'L'
+    {  907,  17,  17,  20,    1,  -17}, // 0x4D 'M'
+    {  944,  14,  17,  17,    1,  -17}, // 0x4E 'N'
+    {  974,  15,  17,  18,    1,  -17}, // 0x4F 'O'
+    { 1006,  12,  17,  15,    1,  -17}, // 0x50 'P'
+    { 1032,  13,  17,  16,    1,  -17}, // 0x51 'Q'
+    { 1060,  13,  17,  16,    1,  -17}, // 0x52 'R'
+    { 1088,  12,  17,  15,    1,  -17}, // 0x53 'S'
+    { 1114,  15,  17,  18,    1,  -17}, // 0x54 'T'
+    { 1146,  14,  17,  17,    1,  -17}, // 0x55 'U'
+    { 1176,  13,  17,  16,    1,  -17}, // 0x56 'V'
+    { 1204,  20,  17,  23,    1,  -17}, // 0x57 'W'
+    { 1247,  14,  17,  17,    1,  -17}, // 0x58 'X'
+    { 1277,  15,  17,  18,    1,  -17}, // 0x59 'Y'
+    { 1309,  12,  17,  15,    1,  -17}, // 0x5A 'Z'
+    { 1335,   6,  22,   9,    1,  -17}, // 0x5B '['
+    { 1352,   6,  22,   9,    1,  -17}, // 0x5C
+    { 1369,   6,  22,   9,    1,  -17}, // 0x5D ']'
+    { 1386,   8,   7,  11,    1,  -17}, // 0x5E '^'
+    { 1393,  13,   2,  16,    1,    3}, // 0x5F '_'
+    { 1397,   4,   3,   9,    2,  -17}, // 0x60 '`'
+    { 1399,  11,  13,  14,    1,  -13}, // 0x61 'a'
+    { 1417,  10,  17,  13,    1,  -17}, // 0x62 'b'
+    { 1439,  11,  13,  14,    1,  -13}, // 0x63 'c'
+    { 1457,  10,  17,  13,    1,  -17}, // 0x64 'd'
+    { 1479,  11,  13,  14,    1,  -13}, // 0x65 'e'
+    { 1497,   6,  17,   9,    1,  -17}, // 0x66 'f'
+    { 1510,  10,  18,  13,    1,  -13}, // 0x67 'g'
+    { 1533,  11,  17,  14,    1,  -17}, // 0x68 'h'
+    { 1557,   3,  13,   8,    2,  -13}, // 0x69 'i'
+    { 1562,   5,  18,   8,    1,  -13}, // 0x6A 'j'
+    { 1574,  11,  17,  14,    1,  -17}, // 0x6B 'k'
+    { 1598,   3,  17,   8,    2,  -17}, // 0x6C 'l'
+    { 1605,  15,  13,  18,    1,  -13}, // 0x6D 'm'
+    { 1630,  10,  13,  13,    1,  -13}, // 0x6E 'n'
+    { 1647,  11,  13,  14,    1,  -13}, // 0x6F 'o'
+    { 1665,  11,  18,  14,    1,  -13}, // 0x70 'p'
+    { 1690,  10,  18,  13,    1,  -13}, // 0x71 'q'
+    { 1713,   6,  13,   9,    1,  -13}, // 0x72 'r'
+    { 1723,  10,  13,  13,    1,  -13}, // 0x73 's'
+    { 1740,   6,  17,   9,    1,  -17}, // 0x74 't'
+    { 1753,  11,  13,  14,    1,  -13}, // 0x75 'u'
+    { 1771,  10,  13,  13,    1,  -13}, // 0x76 'v'
+    { 1788,  15,  13,  18,    1,  -13}, // 0x77 'w'
+    { 1813,  10,  13,  13,    1,  -13}, // 0x78 'x'
+    { 1830,  11,  18,  14,    1,  -13}, // 0x79 'y'
+    { 1855,  11,  13,  14,    1,  -13}, // 0x7A 'z'
+    { 1873,   6,  22,   9,    1,  -17}, // 0x7B '{'
+    { 1890,   3,  22,   8,    2,  -17}, // 0x7C '|'
+    { 1899,   6,  22,   9,    1,  -17}, // 0x7D '}'
+    { 1916,  11,   4,  14,    1,   -8}, // 0x7E '~'
+};
+
+const GFXfont FreeSans12pt7b PROGMEM = {(uint8_t *)FreeSans12pt7bBitmaps, (GFXglyph *)FreeSans12pt7bGlyphs, 0x20, 0x7E, 29};
@@ -0,0 +1,464 @@
+// Stand-in for the Adafruit GFX FreeSans18pt7b, for host tests only.
+// Made by test/shim/make-fonts.py, don't edit it.
+
+#pragma once
+
+const uint8_t FreeSans18pt7bBitmaps[] PROGMEM = {
+  0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C,
+  0xE0, 0x38, 0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xE0, 0xE0,
+  0xE1, 0xC0, 0xE1, 0xC0, 0xE3, 0x80, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00,
+  0xEE, 0x00, 0xEE, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xF8, 0x00, 0xF8, 0x00,
+  0xF0, 0x00, 0x60, 0x00, 0x63, 0x71, 0xF9, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x7F, 0x00, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x07, 0xE0,
+  0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0,
+  0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x07, 0xE0, 0x07, 0xE0,
+  0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0,
+  0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0,
+  0x00, 0xE0, 0x00, 0xE0, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0,
+  0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0,
+  0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x60,
+  0x00, 0x01, 0xB8, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x3B, 0x80, 0x00, 0x1C,
+  0xE0, 0x00, 0x0E, 0x38, 0x00, 0x07, 0x0E, 0x00, 0x03, 0x83, 0x80, 0x01,
+  0xC0, 0xE0, 0x00, 0xE0, 0x38, 0x00, 0x70, 0x0E, 0x00, 0x38, 0x03, 0x80,
+  0x1C, 0x00, 0xE0, 0x0E, 0x00, 0x38, 0x03, 0x80, 0x0E, 0x01, 0xC0, 0x03,
+  0x80, 0xE0, 0x00, 0xE0, 0x70, 0x00, 0x38, 0x38, 0x00, 0x0E, 0x1C, 0x00,
+  0x03, 0x8E, 0x00, 0x00, 0xE7, 0x00, 0x00, 0x3B, 0x80, 0x00, 0x0F, 0xC0,
+  0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFF, 0xE0,
+  0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x0F, 0xE0, 0x1F, 0xE0, 0x1F,
+  0xE0, 0x3F, 0xE0, 0x3F, 0xE0, 0x77, 0xE0, 0x77, 0xE0, 0xE7, 0xE0, 0xE7,
+  0xE1, 0xC7, 0xE1, 0xC7, 0xE3, 0x87, 0xE3, 0x87, 0xE7, 0x07, 0xE7, 0x07,
+  0xEE, 0x07, 0xEE, 0x07, 0xFC, 0x07, 0xFC, 0x07, 0xF8, 0x07, 0xF8, 0x07,
+  0xF0, 0x07, 0x60, 0x06, 0x6F, 0xFF, 0xFF, 0xFF, 0x60, 0x63, 0x71, 0xF8,
+  0xFC, 0x7E, 0x3F, 0x1F, 0x9D, 0xCE, 0xE7, 0x73, 0xB9, 0xDD, 0xCE, 0xE7,
+  0x73, 0xB9, 0xDC, 0xFC, 0x7E, 0x3F, 0x1F, 0x8F, 0xC7, 0xE3, 0xE1, 0xF0,
+  0xF8, 0x7C, 0x3E, 0x1E, 0x0F, 0x07, 0x83, 0xFF, 0xFF, 0x7F, 0x00, 0x63,
+  0x71, 0xF8, 0xFC, 0x7E, 0x3F, 0x1F, 0xCF, 0xE7, 0xF3, 0xF9, 0xFC, 0xFF,
+  0x7F, 0xBF, 0xDF, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFC, 0xFE, 0x7F, 0x3F, 0x9F, 0xCF, 0x63,
+  0x00, 0x7F, 0xBF, 0xFF, 0xFF, 0xE0, 0xFC, 0x3F, 0x0E, 0xE3, 0x9C, 0xE3,
+  0x98, 0x60, 0x60, 0x0D, 0xC0, 0x1F, 0x80, 0x77, 0x01, 0xCE, 0x07, 0x1C,
+  0x1C, 0x38, 0x70, 0x71, 0xC0, 0xE3, 0x81, 0xCE, 0x03, 0xB8, 0x07, 0xE0,
+  0x0F, 0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0x00, 0x6F, 0xFF, 0xFF, 0xFF, 0x60,
+  0xFF, 0xFF, 0xFF, 0xE0, 0x6F, 0xF6, 0x7F, 0x7F, 0xFF, 0xFC, 0x0E, 0x07,
+  0x03, 0x81, 0xC0, 0xE0, 0x70, 0x38, 0x1C, 0x0E, 0x07, 0x03, 0x81, 0xC0,
+  0xE0, 0x70, 0x38, 0x1C, 0x0E, 0x07, 0x03, 0x81, 0xC0, 0xE0, 0x70, 0x38,
+  0x1C, 0x0E, 0x07, 0x03, 0x81, 0xC0, 0x60, 0x00, 0x7F, 0xFE, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07,
+  0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07,
+  0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07,
+  0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0x07, 0x60, 0x06,
+  0x63, 0x71, 0xF8, 0xFC, 0x7E, 0x3F, 0x1F, 0x8F, 0xC7, 0xE3, 0xF1, 0xF8,
+  0xFC, 0x7E, 0x3F, 0x1F, 0x8F, 0xC7, 0xE3, 0xF1, 0xF8, 0xFC, 0x7E, 0x3F,
+  0x1F, 0x8F, 0xFF, 0xFF, 0xBF, 0x80, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38, 0xE0, 0x38, 0xE0, 0x70,
+  0xE0, 0x70, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE3, 0x80,
+  0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00, 0xEE, 0x00, 0xFC, 0x00,
+  0xFC, 0x00, 0xF8, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x60, 0x06,
+  0xE0, 0x07, 0xE0, 0x0F, 0xE0, 0x0F, 0xE0, 0x1F, 0xE0, 0x1F, 0xE0, 0x3F,
+  0xE0, 0x3F, 0xE0, 0x77, 0xE0, 0x77, 0xE0, 0xE7, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xE3, 0x87, 0xE3, 0x87, 0xE7, 0x07, 0xE7, 0x07, 0xEE, 0x07,
+  0xEE, 0x07, 0xFC, 0x07, 0xFC, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xF0, 0x07,
+  0x60, 0x06, 0x60, 0x00, 0xE0, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xF8, 0x00,
+  0xF8, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xEE, 0x00, 0xEE, 0x00, 0xE7, 0x00,
+  0xE7, 0x00, 0xE3, 0x80, 0xE3, 0x80, 0xE1, 0xC0, 0xE1, 0xC0, 0xE0, 0xE0,
+  0xE0, 0xE0, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0x38, 0xE0, 0x38, 0xE0, 0x1C,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xF0, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xEE, 0x00,
+  0xEE, 0x00, 0xE7, 0x00, 0xE7, 0x00, 0xE3, 0x80, 0xE3, 0x80, 0xE1, 0xC0,
+  0xE1, 0xC0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0x38,
+  0xE0, 0x38, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x0E, 0x60, 0x06, 0x60, 0x06,
+  0xE0, 0x07, 0xF0, 0x07, 0xF0, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xFC, 0x07,
+  0xFC, 0x07, 0xEE, 0x07, 0xEE, 0x07, 0xE7, 0x07, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xE1, 0xC7, 0xE1, 0xC7, 0xE0, 0xE7, 0xE0, 0xE7, 0xE0, 0x77,
+  0xE0, 0x77, 0xE0, 0x3F, 0xE0, 0x3F, 0xE0, 0x1F, 0xE0, 0x1F, 0xE0, 0x0F,
+  0x60, 0x06, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0x07, 0xF8, 0x07,
+  0xF8, 0x07, 0xFC, 0x07, 0xFC, 0x07, 0xEE, 0x07, 0xEE, 0x07, 0xE7, 0x07,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE1, 0xC7, 0xE1, 0xC7, 0xE0, 0xE7,
+  0xE0, 0xE7, 0xE0, 0x77, 0xE0, 0x77, 0xE0, 0x3F, 0xE0, 0x3F, 0xE0, 0x1F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38, 0xE0, 0x38, 0xE0, 0x70,
+  0xE0, 0x70, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE3, 0x80,
+  0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00, 0xEE, 0x00, 0xFC, 0x00,
+  0xFC, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF0, 0x00, 0x60, 0x00, 0x60, 0x06,
+  0xE0, 0x07, 0xE0, 0x0E, 0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38,
+  0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xE3, 0x80, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00,
+  0xEE, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xF8, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x7F, 0xFE, 0x6F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF6, 0x6F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF6, 0x60, 0x06,
+  0xE0, 0x07, 0xE0, 0x0E, 0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38,
+  0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xE3, 0x80, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00,
+  0xEE, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xF8, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x7F, 0xFE, 0x60, 0x0D, 0xC0, 0x1F, 0x80, 0x3F, 0x00, 0x7E, 0x00, 0xFC,
+  0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFC, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38, 0xE0, 0x38, 0xE0,
+  0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xE0, 0xE0, 0xE1, 0xC0, 0xE1, 0xC0, 0xE3,
+  0x80, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00, 0xEE, 0x00, 0xFC,
+  0x00, 0xFC, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF0, 0x00, 0x60, 0x00, 0x60,
+  0x06, 0xE0, 0x07, 0xE0, 0x0E, 0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0,
+  0x38, 0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xE3, 0x80, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE,
+  0x00, 0xEE, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xF8, 0x00, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x7F, 0xFE, 0x60, 0x00, 0x00, 0x1B, 0x80, 0x00, 0x00, 0xFE, 0x00,
+  0x00, 0x07, 0xF8, 0x00, 0x00, 0x3F, 0xE0, 0x00, 0x01, 0xDF, 0x80, 0x00,
+  0x0E, 0x7E, 0x00, 0x00, 0x71, 0xF8, 0x00, 0x03, 0x87, 0xE0, 0x00, 0x1C,
+  0x1F, 0x80, 0x00, 0xE0, 0x7E, 0x00, 0x07, 0x01, 0xF8, 0x00, 0x38, 0x07,
+  0xE0, 0x01, 0xC0, 0x1F, 0x80, 0x1C, 0x00, 0x7E, 0x00, 0xE0, 0x01, 0xF8,
+  0x07, 0x00, 0x07, 0xE0, 0x38, 0x00, 0x1F, 0x81, 0xC0, 0x00, 0x7E, 0x0E,
+  0x00, 0x01, 0xF8, 0x70, 0x00, 0x07, 0xE3, 0x80, 0x00, 0x1F, 0x9C, 0x00,
+  0x00, 0x7E, 0xE0, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFD, 0xFF, 0xFF, 0xFF, 0xE0, 0x7F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF0, 0x00, 0x7F, 0x80, 0x03, 0xFE, 0x00, 0x1F, 0xB8, 0x00, 0xFC,
+  0xE0, 0x07, 0xE7, 0x00, 0x3F, 0x1C, 0x01, 0xF8, 0x70, 0x0F, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xE0, 0xFC, 0x07, 0x07, 0xE0,
+  0x1C, 0x3F, 0x00, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x0E, 0x7E, 0x00, 0x3B,
+  0xF0, 0x00, 0xFF, 0x80, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF,
+  0xFF, 0x80, 0x60, 0x00, 0x38, 0x00, 0x0F, 0x00, 0x03, 0xC0, 0x00, 0xF8,
+  0x00, 0x3F, 0x00, 0x0F, 0xC0, 0x03, 0xB8, 0x00, 0xEE, 0x00, 0x39, 0xC0,
+  0x0E, 0x38, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x0E, 0x03,
+  0x81, 0xC0, 0xE0, 0x70, 0x38, 0x0E, 0x0E, 0x03, 0x83, 0x80, 0x70, 0xE0,
+  0x0E, 0x38, 0x03, 0x8E, 0x00, 0x73, 0x80, 0x1C, 0xE0, 0x03, 0x98, 0x00,
+  0x60, 0x7F, 0xFF, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x1C, 0xE0,
+  0x01, 0xCE, 0x00, 0x38, 0xE0, 0x07, 0x0E, 0x00, 0x70, 0xE0, 0x0E, 0x0E,
+  0x01, 0xC0, 0xE0, 0x1C, 0x0E, 0x03, 0x80, 0xE0, 0x70, 0x0E, 0x07, 0x00,
+  0xE0, 0xE0, 0x0E, 0x1C, 0x00, 0xE1, 0xC0, 0x0E, 0x38, 0x00, 0xE7, 0x00,
+  0x0E, 0x70, 0x00, 0xEE, 0x00, 0x0F, 0xC0, 0x00, 0xFC, 0x00, 0x0F, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xF7, 0xFF, 0xFE, 0x7F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xC0, 0x01, 0xFE, 0x00, 0x0F, 0xF0, 0x00, 0xFF, 0x80, 0x0E,
+  0xFC, 0x00, 0xE7, 0xE0, 0x07, 0x3F, 0x00, 0x71, 0xF8, 0x07, 0x0F, 0xC0,
+  0x38, 0x7E, 0x03, 0x83, 0xF0, 0x38, 0x1F, 0x83, 0x80, 0xFC, 0x1C, 0x07,
+  0xE1, 0xC0, 0x3F, 0x1C, 0x01, 0xF8, 0xE0, 0x0F, 0xCE, 0x00, 0x7E, 0xE0,
+  0x03, 0xFE, 0x00, 0x1F, 0xF0, 0x00, 0xFF, 0x00, 0x07, 0xF0, 0x00, 0x3B,
+  0x00, 0x01, 0x80, 0x60, 0x00, 0x1B, 0x80, 0x00, 0x7E, 0x00, 0x03, 0xF8,
+  0x00, 0x1F, 0xE0, 0x00, 0xFF, 0x80, 0x03, 0xFE, 0x00, 0x1D, 0xF8, 0x00,
+  0xE7, 0xE0, 0x07, 0x1F, 0x80, 0x1C, 0x7E, 0x00, 0xE1, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x07, 0x01, 0xF8, 0x38, 0x07, 0xE1,
+  0xC0, 0x1F, 0x87, 0x00, 0x7E, 0x38, 0x01, 0xF9, 0xC0, 0x07, 0xEE, 0x00,
+  0x1F, 0xB8, 0x00, 0x7F, 0xC0, 0x01, 0xFE, 0x00, 0x07, 0xF0, 0x00, 0x1D,
+  0x80, 0x00, 0x60, 0x7F, 0xFF, 0xBF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x0E,
+  0xE0, 0x07, 0x38, 0x03, 0x8E, 0x00, 0xE3, 0x80, 0x70, 0xE0, 0x1C, 0x38,
+  0x0E, 0x0E, 0x07, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x1C,
+  0x03, 0x8E, 0x00, 0xE3, 0x80, 0x39, 0xC0, 0x0E, 0x70, 0x03, 0xB8, 0x00,
+  0xFC, 0x00, 0x3F, 0x00, 0x0F, 0x80, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xDF,
+  0xFF, 0xE0, 0x60, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00,
+  0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00,
+  0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00,
+  0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0,
+  0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E,
+  0x00, 0x00, 0xE0, 0x00, 0x06, 0x00, 0x00, 0x60, 0x00, 0x0E, 0x00, 0x00,
+  0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00,
+  0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0F, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0,
+  0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E,
+  0x00, 0x00, 0xE0, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF7, 0xFF, 0xFE,
+  0x6F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xF6, 0x60, 0x00, 0x1B, 0x80, 0x00, 0x7E, 0x00, 0x03, 0xF8, 0x00, 0x1F,
+  0xE0, 0x00, 0xFF, 0x80, 0x03, 0xFE, 0x00, 0x1D, 0xF8, 0x00, 0xE7, 0xE0,
+  0x07, 0x1F, 0x80, 0x1C, 0x7E, 0x00, 0xE1, 0xF8, 0x07, 0x07, 0xE0, 0x38,
+  0x1F, 0x80, 0xE0, 0x7E, 0x07, 0x01, 0xF8, 0x38, 0x07, 0xE1, 0xC0, 0x1F,
+  0x87, 0x00, 0x7E, 0x38, 0x01, 0xF9, 0xC0, 0x07, 0xEE, 0x00, 0x1F, 0xB8,
+  0x00, 0x7F, 0xC0, 0x01, 0xFE, 0x00, 0x07, 0xF0, 0x00, 0x1D, 0x80, 0x00,
+  0x60, 0x7F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x7F,
+  0x80, 0x03, 0xFE, 0x00, 0x1F, 0xB8, 0x00, 0xFC, 0xE0, 0x07, 0xE7, 0x00,
+  0x3F, 0x1C, 0x01, 0xF8, 0x70, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0x80, 0xE0, 0xFC, 0x07, 0x07, 0xE0, 0x1C, 0x3F, 0x00, 0x71,
+  0xF8, 0x03, 0x8F, 0xC0, 0x0E, 0x7E, 0x00, 0x3B, 0xF0, 0x00, 0xFF, 0x80,
+  0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0xFF, 0x80, 0x7F, 0xFF,
+  0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0xF8, 0x00, 0x0F, 0xC0,
+  0x00, 0xEE, 0x00, 0x0E, 0xE0, 0x00, 0xE7, 0x00, 0x0E, 0x38, 0x00, 0xE3,
+  0x80, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x70, 0x0E,
+  0x03, 0x80, 0xE0, 0x38, 0x0E, 0x01, 0xC0, 0xE0, 0x0E, 0x0E, 0x00, 0xE0,
+  0xE0, 0x07, 0x0E, 0x00, 0x38, 0xE0, 0x03, 0x8E, 0x00, 0x1C, 0xE0, 0x00,
+  0xE6, 0x00, 0x06, 0x60, 0x00, 0x00, 0x38, 0x00, 0x00, 0x0F, 0x00, 0x00,
+  0x03, 0xE0, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x3B, 0x80, 0x00, 0x0E, 0x70,
+  0x00, 0x03, 0x8E, 0x00, 0x00, 0xE1, 0xC0, 0x00, 0x38, 0x38, 0x00, 0x0E,
+  0x07, 0x00, 0x03, 0x80, 0xE0, 0x00, 0xE0, 0x1C, 0x00, 0x38, 0x07, 0x00,
+  0x0E, 0x00, 0xE0, 0x03, 0x80, 0x1C, 0x00, 0xE0, 0x03, 0x80, 0x38, 0x00,
+  0x70, 0x0E, 0x00, 0x0E, 0x03, 0x80, 0x01, 0xC0, 0xE0, 0x00, 0x38, 0x38,
+  0x00, 0x07, 0x0E, 0x00, 0x00, 0xE3, 0x80, 0x00, 0x1C, 0xE0, 0x00, 0x03,
+  0x98, 0x00, 0x00, 0x60, 0x7F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xF0, 0x00, 0x7F, 0x80, 0x03, 0xFE, 0x00, 0x1F, 0xB8, 0x00, 0xFC, 0xE0,
+  0x07, 0xE7, 0x00, 0x3F, 0x1C, 0x01, 0xF8, 0x70, 0x0F, 0xC3, 0x80, 0x7E,
+  0x0E, 0x03, 0xF0, 0x38, 0x1F, 0x80, 0xE0, 0xFC, 0x07, 0x07, 0xE0, 0x1C,
+  0x3F, 0x00, 0x71, 0xF8, 0x03, 0x8F, 0xC0, 0x0E, 0x7E, 0x00, 0x3B, 0xF0,
+  0x00, 0xFF, 0x80, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0xFF,
+  0x80, 0x60, 0x00, 0x1B, 0x80, 0x00, 0x7E, 0x00, 0x03, 0xF8, 0x00, 0x1F,
+  0xE0, 0x00, 0xFF, 0x80, 0x03, 0xFE, 0x00, 0x1D, 0xF8, 0x00, 0xE7, 0xE0,
+  0x07, 0x1F, 0x80, 0x1C, 0x7E, 0x00, 0xE1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFE, 0x07, 0x01, 0xF8, 0x38, 0x07, 0xE1, 0xC0, 0x1F,
+  0x87, 0x00, 0x7E, 0x38, 0x01, 0xF9, 0xC0, 0x07, 0xEE, 0x00, 0x1F, 0xB8,
+  0x00, 0x7F, 0xC0, 0x01, 0xFE, 0x00, 0x07, 0xF0, 0x00, 0x1D, 0x80, 0x00,
+  0x60, 0x60, 0x01, 0xB8, 0x00, 0x7E, 0x00, 0x3B, 0x80, 0x0E, 0xE0, 0x07,
+  0x38, 0x03, 0x8E, 0x00, 0xE3, 0x80, 0x70, 0xE0, 0x1C, 0x38, 0x0E, 0x0E,
+  0x07, 0x03, 0x81, 0xC0, 0xE0, 0xE0, 0x38, 0x38, 0x0E, 0x1C, 0x03, 0x8E,
+  0x00, 0xE3, 0x80, 0x39, 0xC0, 0x0E, 0x70, 0x03, 0xB8, 0x00, 0xFC, 0x00,
+  0x3F, 0x00, 0x0F, 0x80, 0x03, 0xE0, 0x00, 0xF0, 0x00, 0x18, 0x00, 0x00,
+  0x7F, 0xFF, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x1C, 0xE0, 0x01,
+  0xCE, 0x00, 0x38, 0xE0, 0x07, 0x0E, 0x00, 0x70, 0xE0, 0x0E, 0x0E, 0x01,
+  0xC0, 0xE0, 0x1C, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0,
+  0xE0, 0x0E, 0x1C, 0x00, 0xE1, 0xC0, 0x0E, 0x38, 0x00, 0xE7, 0x00, 0x0E,
+  0x70, 0x00, 0xEE, 0x00, 0x0F, 0xC0, 0x00, 0xFC, 0x00, 0x0F, 0x80, 0x00,
+  0xF0, 0x00, 0x06, 0x00, 0x00, 0x7F, 0xFF, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFE, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00,
+  0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0,
+  0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E,
+  0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00, 0xE0, 0x00, 0x0E, 0x00, 0x00,
+  0xE0, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF7, 0xFF, 0xFE, 0x60, 0x00,
+  0x38, 0x00, 0x0E, 0x00, 0x03, 0x80, 0x00, 0xE0, 0x00, 0x38, 0x00, 0x0E,
+  0x00, 0x03, 0x80, 0x00, 0xE0, 0x00, 0x38, 0x00, 0x0E, 0x00, 0x03, 0x80,
+  0x00, 0xE0, 0x00, 0x38, 0x00, 0x0E, 0x00, 0x03, 0x80, 0x00, 0xE0, 0x00,
+  0x38, 0x00, 0x0E, 0x00, 0x03, 0x80, 0x00, 0xE0, 0x00, 0x38, 0x00, 0x0E,
+  0x00, 0x03, 0x80, 0x00, 0xE0, 0x00, 0x18, 0x00, 0x00, 0x60, 0x00, 0x1B,
+  0x80, 0x00, 0x7E, 0x00, 0x01, 0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F, 0x80,
+  0x00, 0x7E, 0x00, 0x01, 0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F, 0x80, 0x00,
+  0x7E, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+  0x00, 0x01, 0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F, 0x80, 0x00, 0x7E, 0x00,
+  0x01, 0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F, 0x80, 0x00, 0x7E, 0x00, 0x01,
+  0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1D, 0x80, 0x00, 0x60, 0x7F, 0xFF, 0xF7,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x7E, 0x00, 0x03, 0xF0, 0x00,
+  0x1F, 0x80, 0x00, 0xFC, 0x00, 0x07, 0xE0, 0x00, 0x3F, 0x00, 0x01, 0xF8,
+  0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x00,
+  0xFC, 0x00, 0x07, 0xE0, 0x00, 0x3F, 0x00, 0x01, 0xF8, 0x00, 0x0F, 0xC0,
+  0x00, 0x7E, 0x00, 0x03, 0xF0, 0x00, 0x1F, 0x80, 0x00, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFB, 0xFF, 0xFF, 0x80, 0x60, 0x00, 0x6E, 0x00, 0x07, 0xE0,
+  0x00, 0xEE, 0x00, 0x1C, 0xE0, 0x01, 0xCE, 0x00, 0x38, 0xE0, 0x07, 0x0E,
+  0x00, 0x70, 0xE0, 0x0E, 0x0E, 0x01, 0xC0, 0xE0, 0x1C, 0x0E, 0x03, 0x80,
+  0xE0, 0x70, 0x0E, 0x07, 0x00, 0xE0, 0xE0, 0x0E, 0x1C, 0x00, 0xE1, 0xC0,
+  0x0E, 0x38, 0x00, 0xE7, 0x00, 0x0E, 0x70, 0x00, 0xEE, 0x00, 0x0F, 0xC0,
+  0x00, 0xFC, 0x00, 0x0F, 0x80, 0x00, 0xF0, 0x00, 0x06, 0x00, 0x00, 0x7F,
+  0xFF, 0xFF, 0xFB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00,
+  0x00, 0x38, 0xE0, 0x00, 0x01, 0xC3, 0x80, 0x00, 0x0E, 0x0E, 0x00, 0x00,
+  0x70, 0x38, 0x00, 0x03, 0x80, 0xE0, 0x00, 0x1C, 0x03, 0x80, 0x00, 0xE0,
+  0x0E, 0x00, 0x07, 0x00, 0x38, 0x00, 0x38, 0x00, 0xE0, 0x01, 0xC0, 0x03,
+  0x80, 0x1C, 0x00, 0x0E, 0x00, 0xE0, 0x00, 0x38, 0x07, 0x00, 0x00, 0xE0,
+  0x38, 0x00, 0x03, 0x81, 0xC0, 0x00, 0x0E, 0x0E, 0x00, 0x00, 0x38, 0x70,
+  0x00, 0x00, 0xE3, 0x80, 0x00, 0x03, 0x9C, 0x00, 0x00, 0x0E, 0xE0, 0x00,
+  0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0xFF,
+  0xE0, 0x7F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x7F,
+  0x80, 0x03, 0xFE, 0x00, 0x1F, 0xB8, 0x00, 0xFC, 0xE0, 0x07, 0xE7, 0x00,
+  0x3F, 0x1C, 0x01, 0xF8, 0x70, 0x0F, 0xC3, 0x80, 0x7E, 0x0E, 0x03, 0xF0,
+  0x38, 0x1F, 0x80, 0xE0, 0xFC, 0x07, 0x07, 0xE0, 0x1C, 0x3F, 0x00, 0x71,
+  0xF8, 0x03, 0x8F, 0xC0, 0x0E, 0x7E, 0x00, 0x3B, 0xF0, 0x00, 0xFF, 0x80,
+  0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0xFF, 0x80, 0x60, 0x00,
+  0x1B, 0x80, 0x00, 0x7F, 0x00, 0x01, 0xFE, 0x00, 0x07, 0xFC, 0x00, 0x1F,
+  0xF0, 0x00, 0x7E, 0xE0, 0x01, 0xF9, 0xC0, 0x07, 0xE3, 0x80, 0x1F, 0x8E,
+  0x00, 0x7E, 0x1C, 0x01, 0xF8, 0x38, 0x07, 0xE0, 0x70, 0x1F, 0x81, 0xC0,
+  0x7E, 0x03, 0x81, 0xF8, 0x07, 0x07, 0xE0, 0x0E, 0x1F, 0x80, 0x38, 0x7E,
+  0x00, 0x71, 0xF8, 0x00, 0xE7, 0xE0, 0x01, 0xDF, 0x80, 0x07, 0x7E, 0x00,
+  0x0F, 0xF8, 0x00, 0x1F, 0xE0, 0x00, 0x3D, 0x80, 0x00, 0x60, 0x7F, 0xFF,
+  0xBF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x0E, 0xE0, 0x07, 0x38, 0x03, 0x8E,
+  0x00, 0xE3, 0x80, 0x70, 0xE0, 0x1C, 0x38, 0x0E, 0x0E, 0x07, 0x03, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x1C, 0x03, 0x8E, 0x00, 0xE3, 0x80,
+  0x39, 0xC0, 0x0E, 0x70, 0x03, 0xB8, 0x00, 0xFC, 0x00, 0x3F, 0x00, 0x0F,
+  0x80, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xE0, 0x63, 0x71, 0xF8,
+  0xFC, 0x7E, 0x3F, 0x1F, 0x9D, 0xCE, 0xE7, 0x73, 0xB9, 0xDD, 0xCE, 0xE7,
+  0x73, 0xB9, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x8F, 0xC7, 0xE3, 0xE1, 0xF0,
+  0xF8, 0x7C, 0x3E, 0x1E, 0x0F, 0x07, 0x83, 0xC1, 0xE0, 0x60, 0x00, 0x63,
+  0x71, 0xF8, 0xFC, 0x7E, 0x3F, 0x1F, 0x9D, 0xCE, 0xE7, 0x73, 0xB9, 0xDD,
+  0xCE, 0xE7, 0x73, 0xB9, 0xDC, 0xFC, 0x7E, 0x3F, 0x1F, 0x8F, 0xC7, 0xE3,
+  0xE1, 0xF0, 0xF8, 0x7C, 0x3E, 0x1E, 0x0F, 0x07, 0x83, 0xC1, 0xE0, 0x60,
+  0x00, 0x7F, 0x7F, 0xFF, 0xFC, 0x7E, 0x3F, 0x1F, 0x9D, 0xCE, 0xE7, 0x73,
+  0xB9, 0xDD, 0xCE, 0xE7, 0x73, 0xB9, 0xDC, 0xFC, 0x7E, 0x3F, 0x1F, 0x8F,
+  0xC7, 0xE3, 0xE1, 0xF0, 0xF8, 0x7C, 0x3E, 0x1E, 0x0F, 0x07, 0x83, 0xFF,
+  0xFF, 0x7F, 0x00, 0x60, 0x6E, 0x07, 0xE0, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xE0, 0x7E, 0x07, 0xE0, 0x76, 0x06, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF0, 0x7B, 0xFF, 0xD8, 0x60, 0x06, 0xE0, 0x07, 0xE0, 0x0E, 0xE0,
+  0x1C, 0xE0, 0x1C, 0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00, 0xFC,
+  0x00, 0xFC, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x7F, 0xFD, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x00, 0xFE, 0x01, 0xFC, 0x07, 0xF8, 0x0F, 0xF0, 0x3F,
+  0xE0, 0x7F, 0xC1, 0xDF, 0x83, 0xBF, 0x0E, 0x7E, 0x1C, 0xFC, 0x71, 0xF8,
+  0xE3, 0xF3, 0x87, 0xE7, 0x0F, 0xDC, 0x1F, 0xB8, 0x3F, 0xE0, 0x7F, 0xC0,
+  0xFF, 0x01, 0xFE, 0x03, 0xF8, 0x07, 0xF0, 0x0E, 0xC0, 0x18, 0x60, 0x06,
+  0xE0, 0x07, 0xF0, 0x07, 0xF8, 0x07, 0xF8, 0x07, 0xFC, 0x07, 0xEE, 0x07,
+  0xEE, 0x07, 0xE7, 0x07, 0xE3, 0x87, 0xE3, 0x87, 0xE1, 0xC7, 0xE0, 0xE7,
+  0xE0, 0xE7, 0xE0, 0x77, 0xE0, 0x3F, 0xE0, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x7F, 0xFE, 0x60, 0x0D, 0xC0, 0x1F, 0x80, 0x3F, 0x00, 0xEE, 0x01, 0xDC,
+  0x07, 0x38, 0x0E, 0x70, 0x38, 0xE0, 0x71, 0xC1, 0xC3, 0x83, 0x87, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0xE0, 0x73, 0x80, 0xE7, 0x01, 0xDC, 0x03,
+  0xB8, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x00, 0x3E, 0x00, 0x7F, 0xFF, 0xFF,
+  0xFE, 0xFF, 0xF8, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0xF8,
+  0x00, 0xFC, 0x00, 0xEE, 0x00, 0xEE, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xE1, 0xC0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0x70, 0xE0, 0x38, 0xE0,
+  0x38, 0xE0, 0x1C, 0xE0, 0x0E, 0x60, 0x06, 0x7F, 0x7F, 0xFF, 0xFC, 0x0E,
+  0x07, 0x83, 0xC1, 0xE0, 0xF0, 0x7C, 0x3E, 0x1F, 0x0F, 0x87, 0xE3, 0xF1,
+  0xF8, 0xFC, 0x77, 0x3B, 0x9D, 0xCE, 0xE7, 0x3B, 0x9D, 0xFF, 0xFF, 0xBF,
+  0x80, 0x60, 0x0D, 0xC0, 0x1F, 0x80, 0x3F, 0x00, 0xEE, 0x01, 0xDC, 0x07,
+  0x38, 0x0E, 0x70, 0x38, 0xE0, 0x71, 0xC1, 0xC3, 0x83, 0x87, 0x0E, 0x0F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF1, 0xC0, 0xE7, 0x01, 0xCE, 0x03, 0xB8,
+  0x07, 0x70, 0x0F, 0xC0, 0x1F, 0x80, 0x3E, 0x00, 0x7C, 0x00, 0xFF, 0xFF,
+  0xFF, 0xFD, 0xFF, 0xF0, 0x60, 0x06, 0xE0, 0x07, 0xE0, 0x0F, 0xE0, 0x0F,
+  0xE0, 0x1F, 0xE0, 0x1F, 0xE0, 0x3F, 0xE0, 0x3F, 0xE0, 0x77, 0xE0, 0x77,
+  0xE0, 0xE7, 0xE0, 0xE7, 0xE1, 0xC7, 0xE1, 0xC7, 0xE3, 0x87, 0xE3, 0x87,
+  0xE7, 0x07, 0xE7, 0x07, 0xEE, 0x07, 0xEE, 0x07, 0xFC, 0x07, 0xFC, 0x07,
+  0xF8, 0x07, 0xF8, 0x07, 0xF0, 0x07, 0x60, 0x06, 0x6F, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF6, 0x60, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+  0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xE0, 0xE0, 0xE0,
+  0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0x60, 0x7F, 0xFE, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0,
+  0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0,
+  0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0,
+  0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0x60,
+  0x00, 0x6F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF6, 0x60, 0x00, 0x1B, 0x80, 0x00, 0xFE, 0x00, 0x07, 0xF8, 0x00,
+  0x3F, 0xE0, 0x01, 0xDF, 0x80, 0x0E, 0x7E, 0x00, 0x71, 0xF8, 0x03, 0x87,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x38, 0x07, 0xE1,
+  0xC0, 0x1F, 0x8E, 0x00, 0x7E, 0x70, 0x01, 0xFB, 0x80, 0x07, 0xFC, 0x00,
+  0x1F, 0xE0, 0x00, 0x7F, 0x00, 0x01, 0xD8, 0x00, 0x06, 0x7F, 0xFD, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x00, 0xEE, 0x03, 0x9C, 0x0E, 0x38, 0x1C, 0x70, 0x70,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1C, 0x0E, 0x70, 0x1D, 0xC0, 0x3B,
+  0x80, 0x7E, 0x00, 0xF8, 0x01, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0xE0, 0x60,
+  0x00, 0xE0, 0x00, 0xF0, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xFC, 0x00, 0xEE,
+  0x00, 0xEE, 0x00, 0xE7, 0x00, 0xE3, 0x80, 0xE3, 0x80, 0xE1, 0xC0, 0xE0,
+  0xE0, 0xE0, 0xE0, 0xE0, 0x70, 0xE0, 0x38, 0xE0, 0x38, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x7F, 0xFE, 0x60, 0x00, 0xE0, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xF8,
+  0x00, 0xF8, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xEE, 0x00, 0xEE, 0x00, 0xE7,
+  0x00, 0xE7, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE1, 0xC0, 0xE0,
+  0xE0, 0xE0, 0xE0, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0x38, 0xE0, 0x38, 0xE0,
+  0x1C, 0xE0, 0x1C, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x7F, 0xFD, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x80, 0x0F, 0x00, 0x1F, 0x00, 0x3E, 0x00, 0x7E, 0x00,
+  0xFC, 0x01, 0xDC, 0x03, 0xB8, 0x07, 0x38, 0x0E, 0x70, 0x1C, 0x70, 0x38,
+  0xE0, 0x71, 0xC0, 0xE1, 0xC1, 0xC3, 0x83, 0x83, 0x87, 0x07, 0x0E, 0x07,
+  0x1C, 0x0E, 0x38, 0x0E, 0x70, 0x1C, 0xE0, 0x1D, 0xC0, 0x39, 0x80, 0x30,
+  0x63, 0x71, 0xF8, 0xFC, 0x7E, 0x7F, 0x3F, 0x9F, 0xDF, 0xEF, 0xF7, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xDF, 0xEF, 0xF7, 0xF3, 0xFF, 0xFF, 0xEF, 0xE0, 0x7F,
+  0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x7F, 0x80, 0xFF, 0x81, 0xFF, 0x03,
+  0xF7, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1C, 0x7E, 0x1C, 0xFC,
+  0x1D, 0xF8, 0x3B, 0xF0, 0x3F, 0xE0, 0x3F, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF,
+  0xE0, 0x7F, 0x7F, 0xFF, 0xFC, 0x7E, 0x3F, 0x3B, 0x9D, 0xCE, 0xE7, 0x77,
+  0x3B, 0x9F, 0xFF, 0xFF, 0xFF, 0xF1, 0xF8, 0xFC, 0x7C, 0x3E, 0x1F, 0x0F,
+  0x87, 0x83, 0xC1, 0xE0, 0xF0, 0x30, 0x00, 0x60, 0x06, 0xE0, 0x07, 0xE0,
+  0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0,
+  0xE0, 0xE1, 0xC0, 0xE1, 0xC0, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE,
+  0x00, 0xFC, 0x00, 0xFC, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x7F,
+  0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x7E, 0x00, 0xFC, 0x01, 0xF8, 0x03,
+  0xF0, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x80, 0x3F, 0x00, 0x7E, 0x00, 0xFC,
+  0x01, 0xF8, 0x03, 0xF0, 0x07, 0xE0, 0x0F, 0xC0, 0x1F, 0x80, 0x3B, 0x00,
+  0x60, 0x60, 0x00, 0x1B, 0x80, 0x00, 0x7E, 0x00, 0x01, 0xF8, 0x00, 0x07,
+  0xE0, 0x00, 0x1F, 0x80, 0x00, 0x7E, 0x00, 0x01, 0xF8, 0x00, 0x07, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x07, 0xE0, 0x00,
+  0x1F, 0x80, 0x00, 0x7E, 0x00, 0x01, 0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F,
+  0x80, 0x00, 0x7E, 0x00, 0x01, 0xD8, 0x00, 0x06, 0x60, 0x0D, 0xC0, 0x1F,
+  0x80, 0x77, 0x00, 0xEE, 0x03, 0x9C, 0x0E, 0x38, 0x1C, 0x70, 0x70, 0xE1,
+  0xC1, 0xC3, 0x83, 0x8E, 0x07, 0x1C, 0x0E, 0x70, 0x1D, 0xC0, 0x3B, 0x80,
+  0x7E, 0x00, 0xF8, 0x01, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0xE0, 0x7F, 0xFE,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x0E, 0xE0, 0x1C, 0xE0, 0x1C, 0xE0, 0x38,
+  0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00,
+  0xEE, 0x00, 0xFC, 0x00, 0xFC, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0xF0, 0x00,
+  0xF0, 0x00, 0x60, 0x00, 0x7F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x1C,
+  0xE0, 0x1C, 0xE0, 0x38, 0xE0, 0x70, 0xE0, 0x70, 0xE0, 0xE0, 0xE1, 0xC0,
+  0xE1, 0xC0, 0xE3, 0x80, 0xE7, 0x00, 0xE7, 0x00, 0xEE, 0x00, 0xFC, 0x00,
+  0xFC, 0x00, 0xF8, 0x00, 0xF0, 0x00, 0x60, 0x00, 0x63, 0x71, 0xF8, 0xFC,
+  0x7E, 0x3F, 0x1F, 0x9D, 0xCE, 0xE7, 0x73, 0xB9, 0xDD, 0xCE, 0xE7, 0x73,
+  0xB9, 0xDC, 0xFC, 0x7E, 0x3F, 0x1F, 0x8F, 0xC7, 0xE3, 0xE1, 0xF0, 0xF8,
+  0x7C, 0x3E, 0x1E, 0x0F, 0x07, 0x83, 0xFF, 0xFF, 0x7F, 0x00, 0x6F, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0x60, 0x7F, 0x7F, 0xFF, 0xFC, 0x7E, 0x3F, 0x1F, 0xCF, 0xE7,
+  0xF3, 0xF9, 0xFC, 0xFF, 0x7F, 0xBF, 0xDF, 0xEF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFC, 0xFE, 0x7F,
+  0x3F, 0xFF, 0xFF, 0x7F, 0x00, 0x60, 0x06, 0xE0, 0x1C, 0xE0, 0xE0, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x7F, 0xFE,
+};
+
+const GFXglyph FreeSans18pt7bGlyphs[] PROGMEM = {
+    {    0,   0,   0,   9,    0,    1}, // 0x20 ' '
+    {    0,  16,  26,  21,    1,  -26}, // 0x21 '!'
+    {   52,   9,   9,  14,    1,  -26}, // 0x22 '"'
+    {   63,  16,  26,  21,    1,  -26}, // 0x23 '#'
+    {  115,  16,  26,  21,    1,  -26}, // 0x24 '$'
+    {  167,  26,  26,  30,    1,  -26}, // 0x25 '%'
+    {  252,  16,  26,  21,    1,  -26}, // 0x26 '&'
+    {  304,   4,   9,  12,    2,  -26}, // 0x27 '''
+    {  309,   9,  33,  14,    1,  -26}, // 0x28 '('
+    {  347,   9,  33,  14,    1,  -26}, // 0x29 ')'
+    {  385,  10,  10,  15,    1,  -26}, // 0x2A '*'
+    {  398,  15,  15,  20,    1,  -18}, // 0x2B '+'
+    {  427,   4,   9,  12,    2,   -4}, // 0x2C ','
+    {  432,   9,   3,  14,    1,  -10}, // 0x2D '-'
+    {  436,   4,   4,  12,    2,   -4}, // 0x2E '.'
+    {  438,   9,  33,  14,    1,  -26}, // 0x2F '/'
+    {  476,  16,  26,  21,    1,  -26}, // 0x30 '0'
+    {  528,   9,  26,  14,    1,  -26}, // 0x31 '1'
+    {  558,  16,  26,  21,    1,  -26}, // 0x32 '2'
+    {  610,  16,  26,  21,    1,  -26}, // 0x33 '3'
+    {  662,  16,  26,  21,    1,  -26}, // 0x34 '4'
+    {  714,  16,  26,  21,    1,  -26}, // 0x35 '5'
+    {  766,  16,  26,  21,    1,  -26}, // 0x36 '6'
+    {  818,  16,  26,  21,    1,  -26}, // 0x37 '7'
+    {  870,  16,  26,  21,    1,  -26}, // 0x38 '8'
+    {  922,  16,  26,  21,    1,  -26}, // 0x39 '9'
+    {  974,   4,  18,  12,    2,  -18}, // 0x3A ':'
+    {  983,   4,  22,  12,    2,  -18}, // 0x3B ';'
+    {  994,  16,  26,  21,    1,  -26}, // 0x3C '<'
+    { 1046,  15,   9,  20,    1,  -15}, // 0x3D '='
+    { 1063,  16,  26,  21,    1,  -26}, // 0x3E '>'
+    { 1115,  16,  26,  21,    1,  -26}, // 0x3F '?'
+    { 1167,  30,  26,  34,    1,  -26}, // 0x40 '@'
+    { 1265,  21,  26,  26,    1,  -26}, // 0x41 'A'
+    { 1334,  18,  26,  22,    1,  -26}, // 0x42 'B'
+    { 1393,  20,  26,  24,    1,  -26}, // 0x43 'C'
+    { 1458,  21,  26,  26,    1,  -26}, // 0x44 'D'
+    { 1527,  22,  26,  27,    1,  -26}, // 0x45 'E'
+    { 1599,  18,  26,  22,    1,  -26}, // 0x46 'F'
+    { 1658,  20,  26,  24,    1,  -26}, // 0x47 'G'
+    { 1723,  20,  26,  24,    1,  -26}, // 0x48 'H'
+    { 1788,   4,  26,  12,    2,  -26}, // 0x49 'I'
+    { 1801,  22,  26,  27,    1,  -26}, // 0x4A 'J'
+    { 1873,  21,  26,  26,    1,  -26}, // 0x4B 'K'
+    { 1942,  20,  26,  24,    1,  -26}, // 0x4C 'L'
+    { 2007,  26,  26,  30,    1,  -26}, // 0x4D 'M'
+    { 2092,  21,  26,  26,    1,  -26}, // 0x4E 'N'
+    { 2161,  22,  26,  27,    1,  -26}, // 0x4F 'O'
+    { 2233,  18,  26,  22,    1,  -26}, // 0x50 'P'
+    { 2292,  20,  26,  24,    1,  -26}, // 0x51 'Q'
+    { 2357,  20,  26,  24,    1,  -26}, // 0x52 'R'
+    { 2422,  18,  26,  22,    1,  -26}, // 0x53 'S'
+    { 2481,  22,  26,  27,    1,  -26}, // 0x54 'T'
+    { 2553,  21,  26,  26,    1,  -26}, // 0x55 'U'
+    { 2622,  20,  26,  24,    1,  -26}, // 0x56 'V'
+    { 2687,  30,  26,  34,    1,  -26}, // 0x57 'W'
+    { 2785,  21,  26,  26,    1,  -26}, // 0x58 'X'
+    { 2854,  22,  26,  27,    1,  -26}, // 0x59 'Y'
+    { 2926,  18,  26,  22,    1,  -26}, // 0x5A 'Z'
+    { 2985,   9,  33,  14,    1,  -26}, // 0x5B '['
+    { 3023,   9,  33,  14,    1,  -26}, // 0x5C
+    { 3061,   9,  33,  14,    1,  -26}, // 0x5D ']'
+    { 3099,  12,  10,  16,    1,  -26}, // 0x5E '^'
+    { 3114,  20,   3,  24,    1,    4}, // 0x5F '_'
+    { 3122,   6,   4,  14,    2,  -26}, // 0x60 '`'
+    { 3125,  16,  20,  21,    1,  -20}, // 0x61 'a'
+    { 3165,  15,  26,  20,    1,  -26}, // 0x62 'b'
+    { 3214,  16,  20,  21,    1,  -20}, // 0x63 'c'
+    { 3254,  15,  26,  20,    1,  -26}, // 0x64 'd'
+    { 3303,  16,  20,  21,    1,  -20}, // 0x65 'e'
+    { 3343,   9,  26,  14,    1,  -26}, // 0x66 'f'
+    { 3373,  15,  27,  20,    1,  -20}, // 0x67 'g'
+    { 3424,  16,  26,  21,    1,  -26}, // 0x68 'h'
+    { 3476,   4,  20,  12,    2,  -20}, // 0x69 'i'
+    { 3486,   8,  27,  12,    1,  -20}, // 0x6A 'j'
+    { 3513,  16,  26,  21,    1,  -26}, // 0x6B 'k'
+    { 3565,   4,  26,  12,    2,  -26}, // 0x6C 'l'
+    { 3578,  22,  20,  27,    1,  -20}, // 0x6D 'm'
+    { 3633,  15,  20,  20,    1,  -20}, // 0x6E 'n'
+    { 3671,  16,  20,  21,    1,  -20}, // 0x6F 'o'
+    { 3711,  16,  27,  21,    1,  -20}, // 0x70 'p'
+    { 3765,  15,  27,  20,    1,  -20}, // 0x71 'q'
+    { 3816,   9,  20,  14,    1,  -20}, // 0x72 'r'
+    { 3839,  15,  20,  20,    1,  -20}, // 0x73 's'
+    { 3877,   9,  26,  14,    1,  -26}, // 0x74 't'
+    { 3907,  16,  20,  21,    1,  -20}, // 0x75 'u'
+    { 3947,  15,  20,  20,    1,  -20}, // 0x76 'v'
+    { 3985,  22,  20,  27,    1,  -20}, // 0x77 'w'
+    { 4040,  15,  20,  20,    1,  -20}, // 0x78 'x'
+    { 4078,  16,  27,  21,    1,  -20}, // 0x79 'y'
+    { 4132,  16,  20,  21,    1,  -20}, // 0x7A 'z'
+    { 4172,   9,  33,  14,    1,  -26}, // 0x7B '{'
+    { 4210,   4,  33,  12,    2,  -26}, // 0x7C '|'
+    { 4227,   9,  33,  14,    1,  -26}, // 0x7D '}'
+    { 4265,  16,   6,  21,    1,  -12}, // 0x7E '~'
+};
+
+const GFXfont FreeSans18pt7b PROGMEM = {(uint8_t *)FreeSans18pt7bBitmaps, (GFXglyph *)FreeSans18pt7bGlyphs, 0x20, 0x7E, 42};
@@ -0,0 +1,39 @@
+#pragma once
+
+/*
+    The bits of FreeRTOS the portable code uses. The host tests are single
+    threaded, so nothing here ever blocks. A task that's created runs to
+    its end the next time its creator waits in vTaskDelay(), which is as
+    close to "on another core" as one thread gets.
+*/
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stackDepth, void *parameter, UBaseType_t priority, TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t task);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+#include <vector>
+
+#include "Arduino.h"
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+struct ShimSemaphore
+{
+    bool mutex;
+    int count;
+};
+
+TickType_t xTaskGetTickCount()
+{
+    return (TickType_t)millis();
+}
+
+struct ShimTask
+{
+    TaskFunction_t function;
+    void *parameter;
+};
+
+static std::vector<ShimTask> pendingTasks;
+
+// The caller's waiting, so anything it started gets its turn
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks);
+
+    std::vector<ShimTask> running;
+    running.swap(pendingTasks);
+    for (ShimTask &task : running)
+        task.function(task.parameter);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stackDepth, void *parameter, UBaseType_t priority, TaskHandle_t *handle)
+{
+    pendingTasks.push_back({task, parameter});
+    if (handle != NULL)
+        *handle = NULL;
+    return pdPASS;
+}
+
+// Tasks here return once they've deleted themselves
+void vTaskDelete(TaskHandle_t task)
+{
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    return new ShimSemaphore{true, 1};
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+    return new ShimSemaphore{false, 0};
+}
+
+// With one thread a mutex is always free, and a binary semaphore that's
+// empty would never be given while we waited on it
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    if (semaphore->mutex)
+        return pdTRUE;
+    if (semaphore->count == 0)
+        return pdFALSE;
+    semaphore->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    if (!semaphore->mutex)
+        semaphore->count = 1;
+    return pdTRUE;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+/*
+    Stands in for the creatures logger. Info and up goes to stderr so a
+    failing test shows what the firmware said about it, debug and verbose
+    are dropped.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace creatures
+{
+    class Logger
+    {
+    public:
+        void verbose(const char *message, ...) {}
+        void debug(const char *message, ...) {}
+
+        void info(const char *message, ...)
+        {
+            va_list args;
+            va_start(args, message);
+            log("info", message, args);
+            va_end(args);
+        }
+
+        void warning(const char *message, ...)
+        {
+            va_list args;
+            va_start(args, message);
+            log("warning", message, args);
+            va_end(args);
+        }
+
+        void error(const char *message, ...)
+        {
+            va_list args;
+            va_start(args, message);
+            log("error", message, args);
+            va_end(args);
+        }
+
+    private:
+        void log(const char *level, const char *message, va_list args)
+        {
+            fprintf(stderr, "[%s] ", level);
+            vfprintf(stderr, message, args);
+            fputc('\n', stderr);
+        }
+    };
+}
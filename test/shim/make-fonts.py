@@ -0,0 +1,203 @@
+"""
+Stand-ins for the Adafruit GFX FreeSans fonts, for the host tests
+
+The real fonts come with the GFX library, which the host tests don't have.
+These have the same names, the same header layout fontconvert writes, and
+roughly FreeSans' metrics, so text wraps, fits and gets cut short about
+where it does on the display. The glyphs themselves are made up: stems,
+bars and a diagonal picked from the character, with the corners knocked
+off so there are curves and stair steps for the smoothing to work on.
+
+Nothing on the display uses these. Rerun it only if the stand-ins have to
+change, and re-record the goldens in test/render-test.cpp after:
+
+    python3 test/shim/make-fonts.py test/shim/Fonts/
+"""
+
+import os
+import sys
+
+# name, scale from 12pt, yAdvance and space advance of the real font
+FONTS = [
+    ("FreeSans12pt7b", 1.0, 29, 7),
+    ("FreeSans18pt7b", 1.5, 42, 9),
+]
+
+FIRST = 0x20
+LAST = 0x7E
+
+# 12pt heights: capitals, x-height, descenders
+CAP = 17
+X_HEIGHT = 13
+DESCENDER = 5
+
+# 12pt widths that aren't the usual for their class
+NARROW = {"I": 3, "i": 3, "l": 3, "j": 5, "f": 6, "t": 6, "r": 6, "1": 6}
+WIDE = {"M": 17, "W": 20, "m": 15, "w": 15, "%": 17, "@": 20}
+ASCENDERS = "bdfhklt"
+DESCENDERS = "gjpqy"
+
+# Punctuation: 12pt width, height, y offset (from the baseline)
+PUNCTUATION = {
+    ".": (3, 3, -3),
+    ",": (3, 6, -3),
+    ":": (3, 12, -12),
+    ";": (3, 15, -12),
+    "'": (3, 6, -CAP),
+    '"': (6, 6, -CAP),
+    "`": (4, 3, -CAP),
+    "-": (6, 2, -7),
+    "_": (13, 2, 3),
+    "=": (10, 6, -10),
+    "+": (10, 10, -12),
+    "*": (7, 7, -CAP),
+    "^": (8, 7, -CAP),
+    "~": (11, 4, -8),
+}
+
+
+def scaled(n, scale):
+    return max(1, int(round(n * scale)))
+
+
+def mix(c):
+    """A few stable bits from a character, to pick its strokes."""
+    n = (ord(c) * 2654435761) & 0xFFFFFFFF
+    return (n ^ (n >> 13)) & 0xFF
+
+
+def metrics(c, scale):
+    """width, height, x advance, x offset, y offset"""
+    if c in PUNCTUATION:
+        w, h, yo = PUNCTUATION[c]
+    elif c.isdigit():
+        w, h, yo = 11, CAP, -CAP
+    elif c.isupper():
+        w, h, yo = 12 + mix(c) % 4, CAP, -CAP
+    elif c.islower():
+        w = 10 + mix(c) % 2
+        h, yo = X_HEIGHT, -X_HEIGHT
+        if c in ASCENDERS:
+            h, yo = CAP, -CAP
+        if c in DESCENDERS:
+            h += DESCENDER
+    elif c in "()[]{}|/\\":
+        w, h, yo = 6 if c != "|" else 3, CAP + DESCENDER, -CAP
+    else:
+        w, h, yo = 11, CAP, -CAP
+
+    w = NARROW.get(c, WIDE.get(c, w))
+    x_offset = 1 if w > 4 else 2
+    advance = w + x_offset + (2 if w > 4 else 3)
+    return scaled(w, scale), scaled(h, scale), scaled(advance, scale), x_offset, int(round(yo * scale))
+
+
+def draw(c, w, h, thickness):
+    """The glyph's pixels, as rows of 0 and 1."""
+    pixels = [[0] * w for _ in range(h)]
+
+    def fill(x0, y0, x1, y1):
+        for y in range(max(0, y0), min(h, y1)):
+            for x in range(max(0, x0), min(w, x1)):
+                pixels[y][x] = 1
+
+    t = min(thickness, w, h)
+    if w <= t or h <= t:
+        fill(0, 0, w, h)
+        return pixels
+
+    bits = mix(c) | 0x01
+    if bits & 0x01:
+        fill(0, 0, t, h)  # left stem
+    if bits & 0x02:
+        fill(w - t, 0, w, h)  # right stem
+    if bits & 0x04:
+        fill(0, 0, w, t)  # top bar
+    if bits & 0x08:
+        fill(0, (h - t) // 2, w, (h + t) // 2)  # middle bar
+    if bits & 0x10:
+        fill(0, h - t, w, h)  # bottom bar
+    if bits & 0x60:
+        # A diagonal, one way or the other
+        for y in range(h):
+            x = y * (w - t) // max(1, h - 1)
+            if bits & 0x20:
+                x = w - t - x
+            fill(x, y, x + t, y + 1)
+
+    # Round the corners off
+    for x, y in ((0, 0), (w - 1, 0), (0, h - 1), (w - 1, h - 1)):
+        pixels[y][x] = 0
+    return pixels
+
+
+def pack(pixels):
+    """Bit after bit, rows not padded, the way fontconvert does it."""
+    out = []
+    byte = 0
+    bit = 0
+    for row in pixels:
+        for lit in row:
+            if lit:
+                byte |= 0x80 >> bit
+            bit += 1
+            if bit == 8:
+                out.append(byte)
+                byte = 0
+                bit = 0
+    if bit:
+        out.append(byte)
+    return out
+
+
+def render(name, scale, y_advance, space):
+    bitmaps = []
+    glyphs = []
+    thickness = scaled(2, scale)
+
+    for code in range(FIRST, LAST + 1):
+        c = chr(code)
+        if c == " ":
+            glyphs.append((0, 0, 0, space, 0, 1))
+            continue
+        w, h, advance, x_offset, y_offset = metrics(c, scale)
+        glyphs.append((len(bitmaps), w, h, advance, x_offset, y_offset))
+        bitmaps.extend(pack(draw(c, w, h, thickness)))
+
+    lines = [
+        "// Stand-in for the Adafruit GFX %s, for host tests only." % name,
+        "// Made by test/shim/make-fonts.py, don't edit it.",
+        "",
+        "#pragma once",
+        "",
+        "const uint8_t %sBitmaps[] PROGMEM = {" % name,
+    ]
+    for i in range(0, len(bitmaps), 12):
+        lines.append("  " + ", ".join("0x%02X" % b for b in bitmaps[i : i + 12]) + ",")
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const GFXglyph %sGlyphs[] PROGMEM = {" % name)
+    for code, glyph in zip(range(FIRST, LAST + 1), glyphs):
+        # A backslash at the end of a comment would run into the next line
+        shown = " '%s'" % chr(code) if chr(code) != "\\" else ""
+        lines.append("    {%5d, %3d, %3d, %3d, %4d, %4d}, // 0x%02X%s" % (glyph + (code, shown)))
+    lines.append("};")
+    lines.append("")
+
+    lines.append(
+        "const GFXfont %s PROGMEM = {(uint8_t *)%sBitmaps, (GFXglyph *)%sGlyphs, 0x%02X, 0x%02X, %d};"
+        % (name, name, name, FIRST, LAST, y_advance)
+    )
+    lines.append("")
+    return "\n".join(lines)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        print("usage: make-fonts.py <output dir>", file=sys.stderr)
+        sys.exit(2)
+    os.makedirs(sys.argv[1], exist_ok=True)
+    for name, scale, y_advance, space in FONTS:
+        with open(os.path.join(sys.argv[1], name + ".h"), "w", encoding="utf-8") as f:
+            f.write(render(name, scale, y_advance, space))
@@ -0,0 +1,187 @@
+/*
+    Host test for binary snapshots
+
+    Sends snapshots through the same C string handling MQTT gives the
+    display, and checks that what comes out the other side decodes to what
+    went in. Snapshots that were cut short, or have junk after them, have
+    to be turned away whole rather than decoding as zeros.
+
+    Usage:
+        snapshot-test
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "snapshot.h"
+
+using creatures::SnapshotReader;
+using Bytes = std::vector<uint8_t>;
+
+// About as big as the MQTT library's payload buffer
+#define PAYLOAD_SIZE 128
+
+static void packFloat(Bytes &out, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    out.push_back(0xCA);
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back((bits >> shift) & 0xFF);
+}
+
+// Every kind of field, with plenty of 0x00 in it
+static Bytes sampleSnapshot(bool extraField)
+{
+    static_assert(SNAPSHOT_FIELD_COUNT + 1 < 16, "the sample snapshots are fixarrays");
+
+    Bytes out;
+    out.push_back(0x90 | (SNAPSHOT_FIELD_COUNT + (extraField ? 1 : 0)));
+    out.push_back(SNAPSHOT_VERSION);
+    packFloat(out, 68.5f);                     // outside temperature, 0x42890000
+    out.push_back(0x00);                       // wind speed, fixint 0
+    out.insert(out.end(), {0xCD, 0x10, 0x00}); // power use, 4096
+    packFloat(out, 2.0f);                      // half bathroom, 0x40000000
+    out.push_back(0xC0);                       // bunny's room, no news
+    packFloat(out, 71.25f);
+    out.insert(out.end(), {0xD1, 0xFF, 0x00}); // family room, -256
+    packFloat(out, 64.0f);
+    out.push_back(0xC0);
+    out.push_back(0x45);
+    out.push_back(0xC3);
+    out.push_back(0xC2);
+    if (extraField)
+        out.push_back(0x00);
+    return out;
+}
+
+static const float expectedNumbers[] = {68.5f, 0.0f, 4096.0f, 2.0f, 0.0f, 71.25f, -256.0f, 64.0f, 0.0f, 69.0f};
+
+// What the display gets from MQTT: a zero filled buffer, copied as a string
+static void deliver(const Bytes &wire, char *payload)
+{
+    memset(payload, '\0', PAYLOAD_SIZE);
+    std::string text(wire.begin(), wire.end());
+    strncpy(payload, text.c_str(), PAYLOAD_SIZE - 1);
+}
+
+// What the reader stage does with it
+static size_t receive(char *payload)
+{
+    size_t stuffed = strnlen(payload, PAYLOAD_SIZE);
+    return creatures::snapshotUnstuff((uint8_t *)payload, stuffed);
+}
+
+static Bytes stuff(const Bytes &snapshot)
+{
+    Bytes wire(SNAPSHOT_STUFFED_SIZE(snapshot.size()));
+    wire.resize(creatures::snapshotStuff(snapshot.data(), snapshot.size(), wire.data()));
+    return wire;
+}
+
+static bool decodesRight(const char *name, bool extraField)
+{
+    Bytes snapshot = sampleSnapshot(extraField);
+    Bytes wire = stuff(snapshot);
+    if (memchr(wire.data(), 0, wire.size()) != NULL)
+    {
+        printf("%s: there's a 0x00 on the wire\n", name);
+        return false;
+    }
+
+    char payload[PAYLOAD_SIZE];
+    deliver(wire, payload);
+    size_t length = receive(payload);
+    if (length != snapshot.size() || memcmp(payload, snapshot.data(), length) != 0)
+    {
+        printf("%s: got %zu bytes back, sent %zu\n", name, length, snapshot.size());
+        return false;
+    }
+
+    SnapshotReader reader((const uint8_t *)payload, length);
+    if (!reader.complete() || !reader.begin())
+    {
+        printf("%s: a good snapshot was turned away\n", name);
+        return false;
+    }
+
+    float number;
+    bool flag;
+    for (int field = snapshot_outside_temperature; field < SNAPSHOT_FIELD_COUNT; field++)
+    {
+        number = 0.0f;
+        SnapshotValueType type = reader.next(&number, &flag);
+        bool ok;
+        if (field == snapshot_family_room_flamethrower || field == snapshot_office_flamethrower)
+            ok = type == snapshot_bool && flag == (field == snapshot_family_room_flamethrower);
+        else if (field == snapshot_bunnys_room_temperature || field == snapshot_guest_room_temperature)
+            ok = type == snapshot_nil;
+        else
+            ok = type == snapshot_number && number == expectedNumbers[field - 1];
+        if (!ok)
+        {
+            printf("%s: field %d came back as type %d, %g\n", name, field, type, number);
+            return false;
+        }
+    }
+
+    printf("%s: %zu bytes, %zu on the wire\n", name, snapshot.size(), wire.size());
+    return true;
+}
+
+// Every way of cutting the payload short has to be turned away
+static bool truncationsRejected()
+{
+    Bytes snapshot = sampleSnapshot(false);
+    Bytes wire = stuff(snapshot);
+
+    for (size_t cut = 0; cut < wire.size(); cut++)
+    {
+        char payload[PAYLOAD_SIZE];
+        deliver(Bytes(wire.begin(), wire.begin() + cut), payload);
+        size_t length = receive(payload);
+
+        SnapshotReader reader((const uint8_t *)payload, length);
+        if (reader.complete())
+        {
+            printf("a snapshot cut to %zu of %zu bytes was accepted\n", cut, wire.size());
+            return false;
+        }
+    }
+
+    // Unstuffed, MQTT stops at the first zero, which is inside the first float
+    char payload[PAYLOAD_SIZE];
+    deliver(snapshot, payload);
+    SnapshotReader raw((const uint8_t *)payload, strnlen(payload, PAYLOAD_SIZE));
+    if (raw.complete())
+    {
+        printf("an unstuffed snapshot cut short by MQTT was accepted\n");
+        return false;
+    }
+
+    // Nor should anything after the array slip through
+    Bytes padded = snapshot;
+    padded.push_back(0x01);
+    SnapshotReader junk(padded.data(), padded.size());
+    if (junk.complete())
+    {
+        printf("a snapshot with junk after it was accepted\n");
+        return false;
+    }
+
+    return true;
+}
+
+int main()
+{
+    bool ok = true;
+
+    ok &= decodesRight("snapshot", false);
+    ok &= decodesRight("snapshot with a field from the future", true);
+    ok &= truncationsRejected();
+
+    printf("snapshot test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file mirror-view.cpp
+ * @brief Grabs the screen from a display, once or continuously
+ *
+ * Connects to the display's mirror port and decodes what it sends with the
+ * same RLE code the display encodes with. The screen goes to a PPM file,
+ * which is rewritten after every update in --mirror mode, so any image
+ * viewer that reloads files can follow along.
+ *
+ *   mirror-view [--mirror] [-o screen.ppm] host[:port]
+ *   mirror-view --self-test
+ */
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mirror-rle.h"
+#include "mirror-stream.h"
+
+using creatures::RleDecoder;
+using creatures::RleEncoder;
+using Pixels = std::vector<uint16_t>;
+
+// Where decoded pixels go, a region at a time
+struct Screen
+{
+    int width = 0;
+    int height = 0;
+    Pixels pixels;
+
+    // The region being decoded, and how far into it we are
+    MirrorRegion region = {};
+    size_t position = 0;
+};
+
+static bool putPixels(void *context, uint16_t pixel, size_t count)
+{
+    Screen *screen = (Screen *)context;
+    size_t area = (size_t)screen->region.width * screen->region.height;
+
+    for (size_t i = 0; i < count; i++, screen->position++)
+    {
+        if (screen->position >= area)
+            return false;
+
+        int x = screen->region.x + screen->position % screen->region.width;
+        int y = screen->region.y + screen->position / screen->region.width;
+        if (x < screen->width && y < screen->height)
+            screen->pixels[y * screen->width + x] = pixel;
+    }
+    return true;
+}
+
+static int connectTo(const std::string &host, int port)
+{
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *found = NULL;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found) != 0)
+        return -1;
+
+    int sock = socket(found->ai_family, found->ai_socktype, found->ai_protocol);
+    if (sock >= 0 && connect(sock, found->ai_addr, found->ai_addrlen) != 0)
+    {
+        close(sock);
+        sock = -1;
+    }
+    freeaddrinfo(found);
+    return sock;
+}
+
+static bool readAll(int sock, void *buffer, size_t length)
+{
+    uint8_t *data = (uint8_t *)buffer;
+    while (length > 0)
+    {
+        ssize_t got = recv(sock, data, length, 0);
+        if (got <= 0)
+            return false;
+        data += got;
+        length -= got;
+    }
+    return true;
+}
+
+// Write the screen out as a binary PPM, swapping it in whole
+static bool writePpm(const Screen &screen, const std::string &path)
+{
+    std::string temporary = path + ".tmp";
+    FILE *out = fopen(temporary.c_str(), "wb");
+    if (out == NULL)
+        return false;
+
+    fprintf(out, "P6\n%d %d\n255\n", screen.width, screen.height);
+    for (uint16_t pixel : screen.pixels)
+    {
+        uint8_t r = (pixel >> 11) & 0x1F, g = (pixel >> 5) & 0x3F, b = pixel & 0x1F;
+        uint8_t rgb[3] = {(uint8_t)(r << 3 | r >> 2), (uint8_t)(g << 2 | g >> 4), (uint8_t)(b << 3 | b >> 2)};
+        fwrite(rgb, 1, 3, out);
+    }
+
+    bool ok = fclose(out) == 0;
+    return ok && rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @brief Read one region off the wire into the screen
+ *
+ * @param encoded set to how many bytes of pixels it took
+ */
+static bool receiveRegion(int sock, Screen *screen, size_t *encoded)
+{
+    if (!readAll(sock, &screen->region, sizeof(MirrorRegion)))
+        return false;
+    if (memcmp(screen->region.magic, MIRROR_MAGIC, 4) != 0)
+    {
+        fprintf(stderr, "that doesn't look like a screen region\n");
+        return false;
+    }
+
+    if (screen->region.flags & MIRROR_FULL_FRAME)
+    {
+        screen->width = screen->region.width;
+        screen->height = screen->region.height;
+        screen->pixels.assign((size_t)screen->width * screen->height, 0);
+    }
+
+    screen->position = 0;
+    RleDecoder decoder(putPixels, screen);
+    std::vector<uint8_t> chunk;
+    *encoded = 0;
+
+    for (;;)
+    {
+        uint8_t length[2];
+        if (!readAll(sock, length, 2))
+            return false;
+
+        size_t size = length[0] | (length[1] << 8);
+        if (size == 0)
+            break;
+
+        chunk.resize(size);
+        if (!readAll(sock, chunk.data(), size) || !decoder.feed(chunk.data(), size))
+            return false;
+        *encoded += size;
+    }
+
+    size_t area = (size_t)screen->region.width * screen->region.height;
+    if (decoder.decodedPixels() != area)
+    {
+        fprintf(stderr, "region decoded to %u pixels, expected %zu\n", decoder.decodedPixels(), area);
+        return false;
+    }
+    return true;
+}
+
+// Collects encoder output the way the wire would carry it
+static bool collect(void *context, const uint8_t *data, size_t length)
+{
+    std::vector<uint8_t> *out = (std::vector<uint8_t> *)context;
+    out->insert(out->end(), data, data + length);
+    return true;
+}
+
+static bool roundTrip(const char *name, const Pixels &pixels, bool report)
+{
+    std::vector<uint8_t> encoded;
+    uint8_t buffer[MIRROR_CHUNK_SIZE];
+    RleEncoder encoder(collect, &encoded, buffer, sizeof(buffer));
+
+    // A row at a time, like the display does it
+    for (size_t i = 0; i < pixels.size(); i += 480)
+        encoder.add(pixels.data() + i, std::min((size_t)480, pixels.size() - i));
+    encoder.finish();
+
+    // Region sizes are 16 bit, so anything bigger than a row gets rows
+    Screen screen;
+    screen.width = pixels.size() > 480 ? 480 : pixels.size();
+    screen.height = screen.width == 0 ? 0 : (pixels.size() + 479) / 480;
+    screen.pixels.assign(pixels.size(), 0);
+    screen.region.width = screen.width;
+    screen.region.height = screen.height;
+
+    // Feed it back in awkward sized pieces to shake out any state bugs
+    RleDecoder decoder(putPixels, &screen);
+    size_t offset = 0;
+    for (size_t piece = 1; offset < encoded.size(); piece = piece % 7 + 1)
+    {
+        size_t take = std::min(piece, encoded.size() - offset);
+        decoder.feed(encoded.data() + offset, take);
+        offset += take;
+    }
+
+    bool ok = screen.pixels == pixels && encoded.size() == encoder.encodedBytes();
+    if (report || !ok)
+    {
+        printf("%-20s %7zu bytes raw, %6zu encoded (%.1f%%) %s\n",
+               name,
+               pixels.size() * 2,
+               encoded.size(),
+               pixels.empty() ? 0.0 : 100.0 * encoded.size() / (pixels.size() * 2),
+               ok ? "ok" : "MISMATCH");
+    }
+    return ok;
+}
+
+/**
+ * @brief Check the codec without a display
+ *
+ * The dashboard frame is made up, but it's the same shape as the real
+ * thing: black background, a few lines of text, and a sparkline.
+ */
+static int selfTest()
+{
+    bool ok = true;
+
+    ok &= roundTrip("empty", Pixels(), false);
+    ok &= roundTrip("one pixel", Pixels(1, 0x1234), false);
+    ok &= roundTrip("run of 129", Pixels(129, 0xF800), false);
+    ok &= roundTrip("run of 130", Pixels(130, 0xF800), false);
+    ok &= roundTrip("run of 258", Pixels(258, 0xF800), false);
+
+    Pixels noise(1000);
+    uint32_t seed = 1;
+    for (uint16_t &pixel : noise)
+    {
+        seed = seed * 1103515245 + 12345;
+        pixel = seed >> 16;
+    }
+    ok &= roundTrip("noise", noise, true);
+
+    Pixels pairs;
+    for (int i = 0; i < 500; i++)
+    {
+        pairs.push_back(i);
+        pairs.push_back(i);
+    }
+    ok &= roundTrip("pairs", pairs, false);
+
+    Pixels dashboard(480 * 320, 0x0000);
+    for (int line = 0; line < 8; line++)
+    {
+        // Glyph-ish strokes on a text line
+        int top = 10 + line * 38;
+        for (int y = top; y < top + 24; y++)
+        {
+            for (int x = 10; x < 10 + 30 * (line + 5); x++)
+            {
+                seed = seed * 1103515245 + 12345;
+                if ((seed >> 16) % 5 == 0)
+                    dashboard[y * 480 + x] = line % 2 ? 0x07FF : 0xFFFF;
+            }
+        }
+    }
+    for (int x = 0; x < 460; x++)
+    {
+        int height = 20 + (x * 37) % 120;
+        for (int y = 300 - height; y < 300; y++)
+            dashboard[y * 480 + 10 + x] = 0xF800;
+    }
+    ok &= roundTrip("dashboard", dashboard, true);
+
+    printf("self-test %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: mirror-view [--mirror] [-o screen.ppm] host[:port]\n"
+                    "       mirror-view --self-test\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    bool live = false;
+    std::string output = "screen.ppm";
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--self-test")
+            return selfTest();
+        else if (arg == "--mirror")
+            live = true;
+        else if (arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if (arg.rfind("-", 0) == 0)
+            usage();
+        else
+            args.push_back(arg);
+    }
+    if (args.size() != 1)
+        usage();
+
+    std::string host = args[0];
+    int port = MIRROR_PORT;
+    size_t colon = host.find(':');
+    if (colon != std::string::npos)
+    {
+        port = atoi(host.c_str() + colon + 1);
+        host = host.substr(0, colon);
+    }
+
+    int sock = connectTo(host, port);
+    if (sock < 0)
+    {
+        fprintf(stderr, "unable to connect to %s:%d\n", host.c_str(), port);
+        return 1;
+    }
+
+    uint8_t command = live ? MIRROR_COMMAND_MIRROR : MIRROR_COMMAND_SCREENSHOT;
+    if (send(sock, &command, 1, 0) != 1)
+    {
+        fprintf(stderr, "lost the connection while asking for the screen\n");
+        return 1;
+    }
+
+    Screen screen;
+    size_t encoded;
+    while (receiveRegion(sock, &screen, &encoded))
+    {
+        if (screen.width == 0)
+        {
+            fprintf(stderr, "got an update before the first full frame\n");
+            return 1;
+        }
+
+        size_t raw = (size_t)screen.region.width * screen.region.height * 2;
+        printf("page %d, %dx%d at %d,%d: %zu bytes for %zu raw (%.1f%%)\n",
+               screen.region.page,
+               screen.region.width,
+               screen.region.height,
+               screen.region.x,
+               screen.region.y,
+               encoded,
+               raw,
+               100.0 * encoded / raw);
+        fflush(stdout);
+
+        if (!writePpm(screen, output))
+        {
+            fprintf(stderr, "unable to write %s\n", output.c_str());
+            return 1;
+        }
+
+        if (!live)
+            break;
+    }
+
+    close(sock);
+    return screen.width > 0 ? 0 : 1;
+}
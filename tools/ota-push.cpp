@@ -0,0 +1,441 @@
+/**
+ * @file ota-push.cpp
+ * @brief Pushes a firmware update to a display over the streaming OTA port
+ *
+ * Builds the update (raw, compressed, or a compressed delta against the
+ * firmware that's on the display now), checks that it unpacks back to the
+ * exact firmware using the same DeltaPatcher the display runs, and sends it.
+ * The header is signed for the connection with OTA_SECRET from the
+ * environment, which has to match what the display was built with.
+ *
+ *   OTA_SECRET=... ota-push [--raw] [--delta running.bin] [--dry-run] host[:port] firmware.bin
+ */
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <zlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ota-delta.h"
+#include "ota-stream.h"
+
+using creatures::DeltaPatcher;
+using Bytes = std::vector<uint8_t>;
+
+// Shortest match worth a copy operation. A copy costs 9 bytes.
+static const size_t MATCH_LENGTH = 16;
+
+static Bytes readFile(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        fprintf(stderr, "unable to read %s\n", path.c_str());
+        exit(1);
+    }
+    return Bytes(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void putLittleEndian(Bytes &out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out.push_back((value >> (8 * i)) & 0xFF);
+}
+
+static uint64_t hashBlock(const uint8_t *data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < MATCH_LENGTH; i++)
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    return hash;
+}
+
+static void flushAdd(Bytes &patch, const Bytes &target, size_t start, size_t end)
+{
+    if (end == start)
+        return;
+    patch.push_back(OTA_DELTA_ADD);
+    putLittleEndian(patch, end - start);
+    patch.insert(patch.end(), target.begin() + start, target.begin() + end);
+}
+
+/**
+ * @brief Make a delta patch that turns source into target
+ *
+ * Greedy: index every MATCH_LENGTH window of the source, then walk the
+ * target taking the longest extension of any hit. Firmware images mostly
+ * shift around between builds, so this finds nearly everything.
+ */
+static Bytes makeDelta(const Bytes &source, const Bytes &target)
+{
+    Bytes patch(OTA_DELTA_MAGIC, OTA_DELTA_MAGIC + 4);
+    putLittleEndian(patch, source.size());
+    putLittleEndian(patch, target.size());
+    putLittleEndian(patch, creatures::deltaHash(OTA_DELTA_HASH_START, source.data(), source.size()));
+
+    std::unordered_map<uint64_t, uint32_t> index;
+    if (source.size() >= MATCH_LENGTH)
+    {
+        index.reserve(source.size());
+        for (size_t i = 0; i + MATCH_LENGTH <= source.size(); i++)
+            index.emplace(hashBlock(&source[i]), i);
+    }
+
+    // Where the next copy would come from if the files line up
+    size_t expected = 0;
+    size_t pending = 0;
+    size_t pos = 0;
+
+    while (pos + MATCH_LENGTH <= target.size())
+    {
+        size_t bestOffset = 0;
+        size_t bestLength = 0;
+
+        size_t candidates[2] = {expected, SIZE_MAX};
+        auto hit = index.find(hashBlock(&target[pos]));
+        if (hit != index.end())
+            candidates[1] = hit->second;
+
+        for (size_t offset : candidates)
+        {
+            if (offset >= source.size())
+                continue;
+            size_t length = 0;
+            while (offset + length < source.size() &&
+                   pos + length < target.size() &&
+                   source[offset + length] == target[pos + length])
+                length++;
+            if (length > bestLength)
+            {
+                bestOffset = offset;
+                bestLength = length;
+            }
+        }
+
+        if (bestLength < MATCH_LENGTH)
+        {
+            pos++;
+            continue;
+        }
+
+        flushAdd(patch, target, pending, pos);
+        patch.push_back(OTA_DELTA_COPY);
+        putLittleEndian(patch, bestOffset);
+        putLittleEndian(patch, bestLength);
+
+        pos += bestLength;
+        pending = pos;
+        expected = bestOffset + bestLength;
+    }
+
+    flushAdd(patch, target, pending, target.size());
+    return patch;
+}
+
+struct VerifyContext
+{
+    const Bytes *source;
+    Bytes output;
+};
+
+static bool verifyRead(void *context, uint32_t offset, uint8_t *buffer, size_t length)
+{
+    VerifyContext *verify = (VerifyContext *)context;
+    if (offset + length > verify->source->size())
+        return false;
+    memcpy(buffer, verify->source->data() + offset, length);
+    return true;
+}
+
+static bool verifyWrite(void *context, const uint8_t *data, size_t length)
+{
+    VerifyContext *verify = (VerifyContext *)context;
+    verify->output.insert(verify->output.end(), data, data + length);
+    return true;
+}
+
+// Run the patch through the device's applier in awkward sized pieces
+static bool applyDelta(const Bytes &source, const Bytes &patch, Bytes &target)
+{
+    VerifyContext verify = {&source, {}};
+    DeltaPatcher patcher(verifyRead, verifyWrite, &verify);
+    patcher.expectSource(source.size(), creatures::deltaHash(OTA_DELTA_HASH_START, source.data(), source.size()));
+
+    size_t pos = 0;
+    size_t piece = 1;
+    while (pos < patch.size())
+    {
+        size_t length = std::min(piece, patch.size() - pos);
+        if (!patcher.feed(&patch[pos], length))
+        {
+            fprintf(stderr, "delta didn't apply: %s\n", patcher.error());
+            return false;
+        }
+        pos += length;
+        piece = piece * 3 % (OTA_CHUNK_SIZE + 7) + 1;
+    }
+
+    if (!patcher.finished())
+    {
+        fprintf(stderr, "delta ended early\n");
+        return false;
+    }
+
+    target = verify.output;
+    return true;
+}
+
+static Bytes deflate(const Bytes &data)
+{
+    uLongf size = compressBound(data.size());
+    Bytes out(size);
+    if (compress2(out.data(), &size, data.data(), data.size(), 9) != Z_OK)
+    {
+        fprintf(stderr, "unable to compress the update\n");
+        exit(1);
+    }
+    out.resize(size);
+    return out;
+}
+
+static Bytes inflate(const Bytes &data, size_t expected)
+{
+    Bytes out(expected);
+    uLongf size = expected;
+    if (uncompress(out.data(), &size, data.data(), data.size()) != Z_OK || size != expected)
+        out.clear();
+    return out;
+}
+
+static std::string md5Hex(const Bytes &data)
+{
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    EVP_Digest(data.data(), data.size(), digest, &length, EVP_md5(), NULL);
+
+    char hex[3];
+    std::string out;
+    for (unsigned int i = 0; i < length; i++)
+    {
+        snprintf(hex, sizeof(hex), "%02x", digest[i]);
+        out += hex;
+    }
+    return out;
+}
+
+static int connectTo(const std::string &host, int port)
+{
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *found = NULL;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found) != 0)
+        return -1;
+
+    int sock = socket(found->ai_family, found->ai_socktype, found->ai_protocol);
+    if (sock >= 0 && connect(sock, found->ai_addr, found->ai_addrlen) != 0)
+    {
+        close(sock);
+        sock = -1;
+    }
+    freeaddrinfo(found);
+    return sock;
+}
+
+static bool sendAll(int sock, const uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t sent = send(sock, data, length, 0);
+        if (sent <= 0)
+            return false;
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+static bool receiveAll(int sock, uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t got = recv(sock, data, length, 0);
+        if (got <= 0)
+            return false;
+        data += got;
+        length -= got;
+    }
+    return true;
+}
+
+// HMAC-SHA256 over the display's nonce and the header, see ota-stream.h
+static void sign(OtaHeader &header, const uint8_t *nonce, const std::string &secret)
+{
+    memset(header.auth, 0, OTA_AUTH_SIZE);
+
+    Bytes message(nonce, nonce + OTA_NONCE_SIZE);
+    message.insert(message.end(), (const uint8_t *)&header, (const uint8_t *)&header + sizeof(header));
+
+    unsigned int length = OTA_AUTH_SIZE;
+    HMAC(EVP_sha256(), secret.data(), secret.size(), message.data(), message.size(), header.auth, &length);
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: OTA_SECRET=... ota-push [--raw] [--delta running.bin] [--dry-run] host[:port] firmware.bin\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    bool raw = false;
+    bool dryRun = false;
+    std::string running;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--raw")
+            raw = true;
+        else if (arg == "--dry-run")
+            dryRun = true;
+        else if (arg == "--delta" && i + 1 < argc)
+            running = argv[++i];
+        else if (arg.rfind("--", 0) == 0)
+            usage();
+        else
+            args.push_back(arg);
+    }
+    if (args.size() != 2 || (raw && !running.empty()))
+        usage();
+
+    std::string host = args[0];
+    int port = OTA_PORT;
+    size_t colon = host.find(':');
+    if (colon != std::string::npos)
+    {
+        port = atoi(host.c_str() + colon + 1);
+        host = host.substr(0, colon);
+    }
+
+    const char *secret = getenv("OTA_SECRET");
+    if (!dryRun && (secret == NULL || *secret == '\0'))
+    {
+        fprintf(stderr, "set OTA_SECRET to the secret the display was built with\n");
+        return 2;
+    }
+
+    Bytes firmware = readFile(args[1]);
+
+    OtaHeader header = {};
+    memcpy(header.magic, OTA_MAGIC, 4);
+    header.imageSize = firmware.size();
+    memcpy(header.md5, md5Hex(firmware).c_str(), 32);
+
+    Bytes payload;
+    if (raw)
+    {
+        header.format = ota_format_raw;
+        payload = firmware;
+    }
+    else if (running.empty())
+    {
+        header.format = ota_format_deflate;
+        payload = deflate(firmware);
+        if (inflate(payload, firmware.size()) != firmware)
+        {
+            fprintf(stderr, "compressed image doesn't round trip\n");
+            return 1;
+        }
+    }
+    else
+    {
+        header.format = ota_format_delta;
+        Bytes source = readFile(running);
+        header.sourceSize = source.size();
+        header.sourceHash = creatures::deltaHash(OTA_DELTA_HASH_START, source.data(), source.size());
+
+        auto started = std::chrono::steady_clock::now();
+        Bytes patch = makeDelta(source, firmware);
+        auto made = std::chrono::steady_clock::now();
+
+        Bytes rebuilt;
+        if (!applyDelta(source, patch, rebuilt) || rebuilt != firmware)
+        {
+            fprintf(stderr, "delta doesn't rebuild the firmware\n");
+            return 1;
+        }
+        auto applied = std::chrono::steady_clock::now();
+
+        payload = deflate(patch);
+        if (inflate(payload, patch.size()) != patch)
+        {
+            fprintf(stderr, "compressed delta doesn't round trip\n");
+            return 1;
+        }
+
+        printf("delta: %zu bytes (made in %lld ms, applied in %lld ms)\n",
+               patch.size(),
+               (long long)std::chrono::duration_cast<std::chrono::milliseconds>(made - started).count(),
+               (long long)std::chrono::duration_cast<std::chrono::milliseconds>(applied - made).count());
+    }
+    header.payloadSize = payload.size();
+
+    printf("firmware: %zu bytes, sending %u bytes (%.1f%%)\n",
+           firmware.size(), header.payloadSize, 100.0 * payload.size() / firmware.size());
+
+    if (dryRun)
+        return 0;
+
+    int sock = connectTo(host, port);
+    if (sock < 0)
+    {
+        fprintf(stderr, "unable to connect to %s:%d\n", host.c_str(), port);
+        return 1;
+    }
+
+    uint8_t nonce[OTA_NONCE_SIZE];
+    if (!receiveAll(sock, nonce, OTA_NONCE_SIZE))
+    {
+        fprintf(stderr, "the display hung up before saying hello\n");
+        close(sock);
+        return 1;
+    }
+    sign(header, nonce, secret);
+
+    if (!sendAll(sock, (const uint8_t *)&header, sizeof(header)) ||
+        !sendAll(sock, payload.data(), payload.size()))
+    {
+        fprintf(stderr, "lost the connection while sending\n");
+        close(sock);
+        return 1;
+    }
+
+    char reply[16] = {};
+    recv(sock, reply, sizeof(reply) - 1, 0);
+    close(sock);
+
+    if (strncmp(reply, "OK", 2) != 0)
+    {
+        fprintf(stderr, "the display didn't take the update\n");
+        return 1;
+    }
+
+    printf("update sent, the display is restarting\n");
+    return 0;
+}
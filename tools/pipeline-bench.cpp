@@ -0,0 +1,380 @@
+/**
+ * @file pipeline-bench.cpp
+ * @brief Times the display pipeline as three tasks and as three stages
+ *
+ * The display used to read MQTT, tick the clock and draw on three tasks of
+ * their own, handing messages along through queues. Now they're stages on
+ * one executor (src/stages.h). This runs a stand-in for both shapes on the
+ * host, with threads playing the tasks, and reports how long a message
+ * takes from arriving to being drawn, one at a time and in a flood.
+ *
+ * The drawing is a no-op, so what's left is the cost of getting a message
+ * to it. Threads on a desktop switch faster than FreeRTOS on the S2, so
+ * the gap on the display is bigger than the one here.
+ *
+ *   pipeline-bench [messages]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "stages.h"
+
+using creatures::StageExecutor;
+using Clock = std::chrono::steady_clock;
+
+// What the device's task stacks were, and what the executor's is
+#define READER_STACK 10240
+#define DISPLAY_STACK 10240
+#define CLOCK_STACK 4096
+#define PIPELINE_STACK 10240
+#define READER_BATCH 4
+
+// About the size of the device's MqttMessage and DisplayMessage
+struct Incoming
+{
+    Clock::time_point arrived;
+    char topic[64];
+    char payload[128];
+};
+
+struct Outgoing
+{
+    Clock::time_point arrived;
+    char text[31];
+    char timestamp[9];
+    float value;
+};
+
+// How the executor finds out something was sent, like a queue set
+struct Wakeup
+{
+    std::mutex mutex;
+    std::condition_variable signal;
+    uint64_t events = 0;
+};
+
+// A bounded queue that wakes whoever's watching it
+template <typename T>
+class Queue
+{
+public:
+    Queue(size_t length, Wakeup *watcher = nullptr) : length(length), watcher(watcher)
+    {
+    }
+
+    void push(const T &item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        hasRoom.wait(lock, [&] { return items.size() < length; });
+        items.push_back(item);
+        lock.unlock();
+
+        hasItems.notify_one();
+        if (watcher != nullptr)
+        {
+            std::lock_guard<std::mutex> guard(watcher->mutex);
+            watcher->events++;
+            watcher->signal.notify_one();
+        }
+    }
+
+    bool tryPop(T *item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty())
+            return false;
+        *item = items.front();
+        items.pop_front();
+        hasRoom.notify_one();
+        return true;
+    }
+
+    bool pop(T *item, std::chrono::milliseconds wait)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!hasItems.wait_for(lock, wait, [&] { return !items.empty(); }))
+            return false;
+        *item = items.front();
+        items.pop_front();
+        hasRoom.notify_one();
+        return true;
+    }
+
+    bool empty()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.empty();
+    }
+
+private:
+    size_t length;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable hasItems;
+    std::condition_variable hasRoom;
+    Wakeup *watcher;
+};
+
+// Where drawn messages get timed
+struct Results
+{
+    std::mutex mutex;
+    std::condition_variable drawnOne;
+    std::vector<double> latencies; // Microseconds
+
+    void drawn(const Outgoing &message)
+    {
+        double took = std::chrono::duration<double, std::micro>(Clock::now() - message.arrived).count();
+        std::lock_guard<std::mutex> lock(mutex);
+        latencies.push_back(took);
+        drawnOne.notify_all();
+    }
+
+    void waitFor(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        drawnOne.wait(lock, [&] { return latencies.size() >= count; });
+    }
+};
+
+static Outgoing translate(const Incoming &message)
+{
+    Outgoing out;
+    out.arrived = message.arrived;
+    // Too long for a line, so it ends in "..." like the display would
+    if (snprintf(out.text, sizeof(out.text), "%s: %s", message.topic, message.payload) >= (int)sizeof(out.text))
+        memcpy(out.text + sizeof(out.text) - 4, "...", 4);
+    strcpy(out.timestamp, "12:00 PM");
+    out.value = (float)atof(message.payload);
+    return out;
+}
+
+static Incoming makeIncoming(int i)
+{
+    Incoming message;
+    snprintf(message.topic, sizeof(message.topic), "home/office/temperature");
+    snprintf(message.payload, sizeof(message.payload), "%d.5", 60 + i % 20);
+    message.arrived = Clock::now();
+    return message;
+}
+
+/**
+ * @brief Send messages one at a time, then all at once
+ *
+ * @return microseconds the flood took to drain
+ */
+static double drive(std::function<void(const Incoming &)> send, Results *results, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        send(makeIncoming(i));
+        results->waitFor(i + 1);
+    }
+
+    Clock::time_point started = Clock::now();
+    for (int i = 0; i < count; i++)
+        send(makeIncoming(i));
+    results->waitFor(2 * count);
+    return std::chrono::duration<double, std::micro>(Clock::now() - started).count();
+}
+
+// The old shape: a task per stage, a queue between each
+static double runTasks(Results *results, int count)
+{
+    Queue<Incoming> incoming(16);
+    Queue<Outgoing> displayQueue(16);
+    std::atomic<bool> stop(false);
+
+    std::thread reader([&] {
+        Incoming message;
+        while (!stop)
+        {
+            if (incoming.pop(&message, std::chrono::milliseconds(100)))
+                displayQueue.push(translate(message));
+        }
+    });
+
+    std::thread display([&] {
+        Outgoing message;
+        while (!stop)
+        {
+            if (displayQueue.pop(&message, std::chrono::milliseconds(100)))
+                results->drawn(message);
+        }
+    });
+
+    std::thread clock([&] {
+        while (!stop)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    });
+
+    double flood = drive([&](const Incoming &message) { incoming.push(message); }, results, count);
+
+    stop = true;
+    reader.join();
+    display.join();
+    clock.join();
+    return flood;
+}
+
+// The new shape, with the same stages the display runs
+struct BenchState
+{
+    Queue<Incoming> *incoming;
+    Queue<Outgoing> *displayQueue;
+    Results *results;
+    Incoming message;
+    uint8_t taken;
+    Outgoing drawing;
+    uint8_t drawn;
+};
+
+static StageState readerStep(Stage *stage)
+{
+    BenchState *s = (BenchState *)stage->context;
+
+    STAGE_BEGIN(stage);
+    for (;;)
+    {
+        STAGE_AWAIT(stage, s->incoming->tryPop(&s->message));
+        s->displayQueue->push(translate(s->message));
+
+        if (++s->taken == READER_BATCH)
+        {
+            s->taken = 0;
+            STAGE_YIELD(stage);
+        }
+    }
+    STAGE_END(stage);
+}
+
+static StageState clockStep(Stage *stage)
+{
+    STAGE_BEGIN(stage);
+    for (;;)
+        STAGE_SLEEP(stage, 1000);
+    STAGE_END(stage);
+}
+
+static StageState displayStep(Stage *stage)
+{
+    BenchState *s = (BenchState *)stage->context;
+
+    STAGE_BEGIN(stage);
+    for (;;)
+    {
+        s->drawn = 0;
+        while (s->drawn < 16 && s->displayQueue->tryPop(&s->drawing))
+        {
+            s->drawn++;
+            s->results->drawn(s->drawing);
+        }
+
+        if (s->drawn == 16)
+            STAGE_YIELD(stage);
+        else
+            STAGE_AWAIT_FOR(stage, !s->displayQueue->empty(), 100);
+    }
+    STAGE_END(stage);
+}
+
+static Clock::time_point benchStarted = Clock::now();
+
+static uint32_t benchMicros()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - benchStarted).count();
+}
+
+static double runStages(Results *results, int count, StageExecutor *executor, size_t *stateBytes)
+{
+    Wakeup wakeup;
+    Queue<Incoming> incoming(16, &wakeup);
+    Queue<Outgoing> displayQueue(16);
+    std::atomic<bool> stop(false);
+
+    static Stage readerStage, clockStage, displayStage;
+    BenchState state = {&incoming, &displayQueue, results, {}, 0, {}, 0};
+    executor->add(&readerStage, "reader", readerStep, &state);
+    executor->add(&clockStage, "clock", clockStep, NULL);
+    executor->add(&displayStage, "display", displayStep, &state);
+    *stateBytes = 3 * sizeof(Stage) + sizeof(Incoming) + sizeof(Outgoing) + 2 * sizeof(uint8_t);
+
+    std::thread pipeline([&] {
+        uint64_t seen = 0;
+        while (!stop)
+        {
+            uint32_t wait = executor->runOnce(benchMicros() / 1000);
+            wait = std::min(wait, (uint32_t)100);
+
+            std::unique_lock<std::mutex> lock(wakeup.mutex);
+            wakeup.signal.wait_for(lock, std::chrono::milliseconds(wait), [&] {
+                return wakeup.events != seen || stop;
+            });
+            seen = wakeup.events;
+        }
+    });
+
+    double flood = drive([&](const Incoming &message) { incoming.push(message); }, results, count);
+
+    stop = true;
+    {
+        std::lock_guard<std::mutex> lock(wakeup.mutex);
+        wakeup.signal.notify_one();
+    }
+    pipeline.join();
+    return flood;
+}
+
+static void report(const char *name, Results *results, int count, double flood)
+{
+    std::vector<double> single(results->latencies.begin(), results->latencies.begin() + count);
+    std::sort(single.begin(), single.end());
+
+    printf("%-8s one at a time: median %6.1fus, p99 %7.1fus   flood of %d: %8.0fus\n",
+           name,
+           single[single.size() / 2],
+           single[single.size() * 99 / 100],
+           count,
+           flood);
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 2000;
+    if (count < 1)
+    {
+        fprintf(stderr, "usage: pipeline-bench [messages]\n");
+        return 2;
+    }
+
+    Results tasks;
+    double tasksFlood = runTasks(&tasks, count);
+    report("tasks", &tasks, count, tasksFlood);
+
+    Results stages;
+    StageExecutor executor(benchMicros);
+    size_t stateBytes;
+    double stagesFlood = runStages(&stages, count, &executor, &stateBytes);
+    report("stages", &stages, count, stagesFlood);
+
+    char stats[256];
+    executor.describeStats(stats, sizeof(stats));
+    printf("%s\n", stats);
+
+    printf("stacks: %d bytes for three tasks, %d for the executor, plus %zu bytes of stage state\n",
+           READER_STACK + DISPLAY_STACK + CLOCK_STACK,
+           PIPELINE_STACK,
+           stateBytes);
+    return 0;
+}
@@ -0,0 +1,727 @@
+/**
+ * @file state-aggregator.cpp
+ * @brief Coalesces the raw home topics into one snapshot topic for the displays
+ *
+ * Every display used to subscribe to a dozen topics and handle each update
+ * on its own. This runs once on a host instead. It keeps the current state,
+ * ignores changes smaller than each field's threshold, rate limits, and
+ * publishes one retained MessagePack snapshot (see src/snapshot.h) that all
+ * of the displays read.
+ *
+ *   state-aggregator [--broker host[:port]] [--namespace prefix]
+ *                    [--publish-topic topic] [--min-interval ms]
+ *                    [--refresh ms] topics.conf
+ *
+ *   state-aggregator --load-test
+ *
+ * The display subscribes to everything with subscribeGlobalNamespace(),
+ * which puts the creatures library's global namespace in front of the
+ * topic. --namespace is that same prefix, trailing / and all. It goes in
+ * front of the raw topics and of the snapshot topic (DISPLAY_SNAPSHOT_TOPIC
+ * unless --publish-topic says otherwise), and the full topic is printed on
+ * connect.
+ *
+ * Topics in topics.conf can be the names home/data-feed.h gives them, like
+ * OFFICE_TEMPERATURE_TOPIC, so they're the same strings the firmware uses.
+ * That needs lib/creatures checked out when this is built.
+ *
+ * The load test runs the aggregator against an in-process fake broker and
+ * reports how many raw messages a second it keeps up with, and what the
+ * fan-out to a growing number of displays costs compared to sending them
+ * every raw topic.
+ */
+
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "snapshot.h"
+
+#if __has_include("home/data-feed.h")
+#include "home/data-feed.h"
+#define HAVE_DATA_FEED
+#endif
+
+using Bytes = std::vector<uint8_t>;
+using MessageHandler = std::function<void(const std::string &topic, const Bytes &payload)>;
+
+static uint64_t nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// The names used in topics.conf, indexed by SnapshotField
+static const char *fieldNames[SNAPSHOT_FIELD_COUNT] = {
+    "version",
+    "outside_temperature",
+    "outside_wind_speed",
+    "home_power_use",
+    "half_bathroom_temperature",
+    "bunnys_room_temperature",
+    "office_temperature",
+    "family_room_temperature",
+    "workshop_temperature",
+    "guest_room_temperature",
+    "kitchen_temperature",
+    "family_room_flamethrower",
+    "office_flamethrower",
+};
+
+static bool isFlag(int field)
+{
+    return field >= snapshot_family_room_flamethrower;
+}
+
+// The topics the display subscribes to, by their names in home/data-feed.h
+struct TopicName
+{
+    const char *name;
+    const char *topic;
+};
+
+#define TOPIC_NAME(name) {#name, name}
+
+static const TopicName dataFeedTopics[] = {
+#ifdef HAVE_DATA_FEED
+    TOPIC_NAME(OUTSIDE_TEMPERATURE_TOPIC),
+    TOPIC_NAME(OUTSIDE_WIND_SPEED_TOPIC),
+    TOPIC_NAME(HOME_POWER_USE_WATTS),
+    TOPIC_NAME(HALF_BATHROOM_TEMPERATURE_TOPIC),
+    TOPIC_NAME(BUNNYS_ROOM_TEMPERATURE_TOPIC),
+    TOPIC_NAME(OFFICE_TEMPERATURE_TOPIC),
+    TOPIC_NAME(FAMILY_ROOM_TEMPERATURE_TOPIC),
+    TOPIC_NAME(WORKSHOP_TEMPERATURE_TOPIC),
+    TOPIC_NAME(GUEST_ROOM_TEMPERATURE_TOPIC),
+    TOPIC_NAME(KITCHEN_TEMPERATURE_TOPIC),
+    TOPIC_NAME(FAMILY_ROOM_FLAMETHROWER_TOPIC),
+    TOPIC_NAME(OFFICE_FLAMETHROWER_TOPIC),
+#endif
+    {NULL, NULL}};
+
+// Anything in capitals is a name from home/data-feed.h, not a topic
+static bool isTopicName(const std::string &topic)
+{
+    return topic.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_") == std::string::npos;
+}
+
+/*
+    Brokers
+*/
+
+class Broker
+{
+public:
+    virtual ~Broker() {}
+    virtual bool subscribe(const std::string &topic) = 0;
+    virtual bool publish(const std::string &topic, const Bytes &payload) = 0;
+
+    MessageHandler onMessage;
+};
+
+/**
+ * @brief Just enough MQTT 3.1.1 to subscribe and publish at QoS 0
+ */
+class MqttBroker : public Broker
+{
+public:
+    ~MqttBroker()
+    {
+        if (sock >= 0)
+            close(sock);
+    }
+
+    bool connect(const std::string &host, int port, const std::string &clientId)
+    {
+        if (sock >= 0)
+            close(sock);
+        sock = -1;
+
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo *found = NULL;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found) != 0)
+            return false;
+
+        sock = socket(found->ai_family, found->ai_socktype, found->ai_protocol);
+        if (sock >= 0 && ::connect(sock, found->ai_addr, found->ai_addrlen) != 0)
+        {
+            close(sock);
+            sock = -1;
+        }
+        freeaddrinfo(found);
+        if (sock < 0)
+            return false;
+
+        Bytes body;
+        putString(body, "MQTT");
+        body.push_back(4);    // 3.1.1
+        body.push_back(0x02); // Clean session
+        body.push_back(0);
+        body.push_back(KEEPALIVE_SECONDS);
+        putString(body, clientId);
+        if (!sendPacket(0x10, body))
+            return false;
+
+        uint8_t type;
+        Bytes reply;
+        return readPacket(&type, reply) && type == 0x20 && reply.size() == 2 && reply[1] == 0;
+    }
+
+    bool subscribe(const std::string &topic) override
+    {
+        Bytes body;
+        body.push_back(nextPacketId >> 8);
+        body.push_back(nextPacketId & 0xFF);
+        nextPacketId++;
+        putString(body, topic);
+        body.push_back(0); // QoS 0
+        return sendPacket(0x82, body);
+    }
+
+    // Always retained, so a display that just booted gets the latest
+    bool publish(const std::string &topic, const Bytes &payload) override
+    {
+        Bytes body;
+        putString(body, topic);
+        body.insert(body.end(), payload.begin(), payload.end());
+        return sendPacket(0x31, body);
+    }
+
+    /**
+     * @brief Handle whatever the broker sends for up to timeout ms
+     *
+     * @return false if we lost the connection
+     */
+    bool loop(int timeout)
+    {
+        if (nowMs() - lastSent > KEEPALIVE_SECONDS * 1000 / 2 && !sendPacket(0xC0, Bytes()))
+            return false;
+
+        pollfd waiting = {sock, POLLIN, 0};
+        int ready = poll(&waiting, 1, timeout);
+        if (ready < 0)
+            return false;
+        if (ready == 0)
+            return true;
+
+        uint8_t type;
+        Bytes body;
+        if (!readPacket(&type, body))
+            return false;
+
+        if ((type & 0xF0) == 0x30 && body.size() >= 2)
+        {
+            size_t topicLength = (body[0] << 8) | body[1];
+            size_t payloadStart = 2 + topicLength;
+            if ((type & 0x06) != 0)
+                payloadStart += 2; // Packet id on QoS 1 and 2
+            if (payloadStart <= body.size() && onMessage)
+            {
+                onMessage(std::string(body.begin() + 2, body.begin() + 2 + topicLength),
+                          Bytes(body.begin() + payloadStart, body.end()));
+            }
+        }
+        return true;
+    }
+
+private:
+    static const int KEEPALIVE_SECONDS = 60;
+
+    static void putString(Bytes &out, const std::string &text)
+    {
+        out.push_back(text.size() >> 8);
+        out.push_back(text.size() & 0xFF);
+        out.insert(out.end(), text.begin(), text.end());
+    }
+
+    bool sendPacket(uint8_t type, const Bytes &body)
+    {
+        Bytes packet;
+        packet.push_back(type);
+        size_t remaining = body.size();
+        do
+        {
+            uint8_t digit = remaining % 128;
+            remaining /= 128;
+            packet.push_back(remaining > 0 ? digit | 0x80 : digit);
+        } while (remaining > 0);
+        packet.insert(packet.end(), body.begin(), body.end());
+
+        size_t sent = 0;
+        while (sent < packet.size())
+        {
+            ssize_t chunk = send(sock, packet.data() + sent, packet.size() - sent, 0);
+            if (chunk <= 0)
+                return false;
+            sent += chunk;
+        }
+        lastSent = nowMs();
+        return true;
+    }
+
+    bool readFully(uint8_t *buffer, size_t length)
+    {
+        while (length > 0)
+        {
+            ssize_t chunk = recv(sock, buffer, length, 0);
+            if (chunk <= 0)
+                return false;
+            buffer += chunk;
+            length -= chunk;
+        }
+        return true;
+    }
+
+    bool readPacket(uint8_t *type, Bytes &body)
+    {
+        if (!readFully(type, 1))
+            return false;
+
+        size_t remaining = 0;
+        for (int shift = 0; shift < 28; shift += 7)
+        {
+            uint8_t digit;
+            if (!readFully(&digit, 1))
+                return false;
+            remaining |= (size_t)(digit & 0x7F) << shift;
+            if ((digit & 0x80) == 0)
+                break;
+        }
+
+        body.resize(remaining);
+        return remaining == 0 || readFully(body.data(), remaining);
+    }
+
+    int sock = -1;
+    uint16_t nextPacketId = 1;
+    uint64_t lastSent = 0;
+};
+
+/**
+ * @brief An in-process broker for the load test
+ *
+ * Delivers synchronously to whoever subscribed, and counts what it sent.
+ */
+class FakeBroker : public Broker
+{
+public:
+    bool subscribe(const std::string &topic) override
+    {
+        subscriptions.push_back(topic);
+        return true;
+    }
+
+    bool publish(const std::string &topic, const Bytes &payload) override
+    {
+        published++;
+        publishedBytes += payload.size();
+        for (auto &display : displays)
+            display(topic, payload);
+        return true;
+    }
+
+    std::vector<std::string> subscriptions;
+    std::vector<MessageHandler> displays;
+    uint64_t published = 0;
+    uint64_t publishedBytes = 0;
+};
+
+/*
+    The aggregator itself
+*/
+
+struct FieldState
+{
+    std::string topic;
+    float threshold = 0.0f;
+
+    bool known = false;
+    float value = 0.0f;
+    float published = NAN; // What the displays have seen
+};
+
+class Aggregator
+{
+public:
+    Aggregator(Broker &broker, const std::string &publishTopic, uint64_t minInterval, uint64_t refresh)
+        : broker(broker), publishTopic(publishTopic), minInterval(minInterval), refresh(refresh)
+    {
+    }
+
+    FieldState &field(int index)
+    {
+        return fields[index];
+    }
+
+    void start()
+    {
+        for (int i = 1; i < SNAPSHOT_FIELD_COUNT; i++)
+        {
+            if (fields[i].topic.empty())
+                continue;
+            byTopic[fields[i].topic] = i;
+            broker.subscribe(fields[i].topic);
+        }
+    }
+
+    void handle(const std::string &topic, const Bytes &payload)
+    {
+        received++;
+
+        auto found = byTopic.find(topic);
+        if (found == byTopic.end())
+            return;
+
+        FieldState &state = fields[found->second];
+        std::string text(payload.begin(), payload.end());
+        if (isFlag(found->second))
+            state.value = !(text == "false" || text == "off" || text == "0");
+        else
+            state.value = atof(text.c_str());
+        state.known = true;
+    }
+
+    /**
+     * @brief Publish a snapshot if anything moved past its threshold
+     *
+     * Never more than once per minInterval, and at least once per refresh
+     * so a display that missed the retained message catches up.
+     */
+    void tick(uint64_t now)
+    {
+        if (now - lastPublish < minInterval)
+            return;
+
+        bool dirty = now - lastPublish >= refresh;
+        for (int i = 1; i < SNAPSHOT_FIELD_COUNT && !dirty; i++)
+        {
+            FieldState &state = fields[i];
+            if (state.known && (std::isnan(state.published) || fabsf(state.value - state.published) > state.threshold))
+                dirty = true;
+        }
+        if (!dirty)
+            return;
+
+        broker.publish(publishTopic, encode());
+        lastPublish = now;
+        snapshots++;
+    }
+
+    // The whole state, so a display that just booted gets everything. Also
+    // notes what the displays will have seen once it's sent.
+    Bytes encode()
+    {
+        Bytes packed = pack();
+        Bytes out(SNAPSHOT_STUFFED_SIZE(packed.size()));
+        out.resize(creatures::snapshotStuff(packed.data(), packed.size(), out.data()));
+        return out;
+    }
+
+    uint64_t received = 0;
+    uint64_t snapshots = 0;
+
+private:
+    // The MessagePack array itself, before it's stuffed for the wire
+    Bytes pack()
+    {
+        Bytes out;
+        if (SNAPSHOT_FIELD_COUNT < 16)
+        {
+            out.push_back(0x90 | SNAPSHOT_FIELD_COUNT);
+        }
+        else
+        {
+            out.push_back(0xDC);
+            out.push_back(SNAPSHOT_FIELD_COUNT >> 8);
+            out.push_back(SNAPSHOT_FIELD_COUNT & 0xFF);
+        }
+        out.push_back(SNAPSHOT_VERSION);
+
+        for (int i = 1; i < SNAPSHOT_FIELD_COUNT; i++)
+        {
+            FieldState &state = fields[i];
+            if (!state.known)
+            {
+                out.push_back(0xC0);
+                continue;
+            }
+
+            state.published = state.value;
+            if (isFlag(i))
+            {
+                out.push_back(state.value != 0.0f ? 0xC3 : 0xC2);
+                continue;
+            }
+
+            uint32_t bits;
+            memcpy(&bits, &state.value, 4);
+            out.push_back(0xCA);
+            for (int shift = 24; shift >= 0; shift -= 8)
+                out.push_back((bits >> shift) & 0xFF);
+        }
+        return out;
+    }
+
+    Broker &broker;
+    std::string publishTopic;
+    uint64_t minInterval;
+    uint64_t refresh;
+    uint64_t lastPublish = 0;
+
+    FieldState fields[SNAPSHOT_FIELD_COUNT];
+    std::unordered_map<std::string, int> byTopic;
+};
+
+/**
+ * @brief Read the topic mapping
+ *
+ * One field per line: the field name, the raw topic, and optionally the
+ * smallest change worth publishing. # starts a comment.
+ */
+static bool loadConfig(const std::string &path, const std::string &prefix, Aggregator &aggregator)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        fprintf(stderr, "unable to read %s\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream words(line);
+        std::string name, topic;
+        float threshold = 0.0f;
+        if (!(words >> name))
+            continue;
+        if (!(words >> topic))
+        {
+            fprintf(stderr, "%s:%d: missing a topic for %s\n", path.c_str(), lineNumber, name.c_str());
+            return false;
+        }
+        words >> threshold;
+
+        int index = -1;
+        for (int i = 1; i < SNAPSHOT_FIELD_COUNT; i++)
+            if (name == fieldNames[i])
+                index = i;
+        if (index < 0)
+        {
+            fprintf(stderr, "%s:%d: unknown field %s\n", path.c_str(), lineNumber, name.c_str());
+            return false;
+        }
+
+        if (isTopicName(topic))
+        {
+            const TopicName *found = dataFeedTopics;
+            while (found->name != NULL && topic != found->name)
+                found++;
+            if (found->name == NULL)
+            {
+                fprintf(stderr, "%s:%d: %s isn't a topic from home/data-feed.h%s\n",
+                        path.c_str(), lineNumber, topic.c_str(),
+#ifdef HAVE_DATA_FEED
+                        ""
+#else
+                        " (lib/creatures wasn't there when this was built, write the topic out instead)"
+#endif
+                );
+                return false;
+            }
+            topic = found->topic;
+        }
+
+        aggregator.field(index).topic = prefix + topic;
+        aggregator.field(index).threshold = threshold;
+    }
+    return true;
+}
+
+/*
+    Load test
+*/
+
+static double secondsSince(std::chrono::steady_clock::time_point started)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+static void loadTest()
+{
+    const uint64_t rawMessages = 2000000;
+    const uint64_t simulatedRate = 200; // Raw messages a second from the house
+    const int displayCounts[] = {1, 4, 16, 64};
+
+    printf("%8s %14s %12s %14s %14s %14s\n",
+           "displays", "raw msg/s", "snapshots", "per-topic out", "snapshot out", "decode us/snap");
+
+    for (int displays : displayCounts)
+    {
+        FakeBroker broker;
+        Aggregator aggregator(broker, DISPLAY_SNAPSHOT_TOPIC, 1000, 60000);
+
+        std::vector<std::string> topics;
+        for (int i = 1; i < SNAPSHOT_FIELD_COUNT; i++)
+        {
+            aggregator.field(i).topic = std::string("home/") + fieldNames[i];
+            aggregator.field(i).threshold = i == snapshot_home_power_use ? 25.0f : 0.2f;
+            topics.push_back(aggregator.field(i).topic);
+        }
+        aggregator.start();
+
+        // Each display runs the same decoder the firmware does, and unstuffs
+        // in place like it does too
+        Bytes scratch;
+        uint64_t decoded = 0;
+        std::chrono::steady_clock::duration decodeTime{};
+        for (int d = 0; d < displays; d++)
+        {
+            broker.displays.push_back([&](const std::string &, const Bytes &payload) {
+                auto started = std::chrono::steady_clock::now();
+                scratch.assign(payload.begin(), payload.end());
+                size_t length = creatures::snapshotUnstuff(scratch.data(), scratch.size());
+                creatures::SnapshotReader reader(scratch.data(), length);
+                float number;
+                bool flag;
+                if (reader.begin())
+                    while (reader.next(&number, &flag) < snapshot_end)
+                        ;
+                decodeTime += std::chrono::steady_clock::now() - started;
+                decoded++;
+            });
+        }
+
+        // Values wander the way the house does: mostly noise, now and then a real change
+        srand(42);
+        std::vector<Bytes> payloads;
+        for (int i = 0; i < 4096; i++)
+        {
+            float value = 60.0f + (rand() % 200) / 10.0f;
+            std::string text = std::to_string(value);
+            payloads.push_back(Bytes(text.begin(), text.end()));
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < rawMessages; i++)
+        {
+            aggregator.handle(topics[i % topics.size()], payloads[(i * 7) % payloads.size()]);
+            aggregator.tick(1 + i * 1000 / simulatedRate);
+        }
+        double elapsed = secondsSince(started);
+
+        printf("%8d %14.0f %12llu %14llu %14llu %14.2f\n",
+               displays,
+               rawMessages / elapsed,
+               (unsigned long long)aggregator.snapshots,
+               (unsigned long long)(rawMessages * displays),
+               (unsigned long long)(broker.published * displays),
+               decoded ? std::chrono::duration<double, std::micro>(decodeTime).count() / decoded : 0.0);
+    }
+
+    printf("\n%llu raw messages at %llu/s of simulated time. \"out\" is messages delivered to displays.\n",
+           (unsigned long long)rawMessages, (unsigned long long)simulatedRate);
+}
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: state-aggregator [--broker host[:port]] [--namespace prefix]\n"
+            "                        [--publish-topic topic] [--min-interval ms]\n"
+            "                        [--refresh ms] topics.conf\n"
+            "       state-aggregator --load-test\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    std::string host = "localhost";
+    int port = 1883;
+    std::string prefix;
+    std::string publishTopic = DISPLAY_SNAPSHOT_TOPIC;
+    uint64_t minInterval = 1000;
+    uint64_t refresh = 60000;
+    std::string config;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--load-test")
+        {
+            loadTest();
+            return 0;
+        }
+        else if (arg == "--broker" && hasValue)
+            host = argv[++i];
+        else if (arg == "--namespace" && hasValue)
+            prefix = argv[++i];
+        else if (arg == "--publish-topic" && hasValue)
+            publishTopic = argv[++i];
+        else if (arg == "--min-interval" && hasValue)
+            minInterval = strtoull(argv[++i], NULL, 10);
+        else if (arg == "--refresh" && hasValue)
+            refresh = strtoull(argv[++i], NULL, 10);
+        else if (arg.rfind("--", 0) == 0 || !config.empty())
+            usage();
+        else
+            config = arg;
+    }
+    if (config.empty())
+        usage();
+
+    size_t colon = host.find(':');
+    if (colon != std::string::npos)
+    {
+        port = atoi(host.c_str() + colon + 1);
+        host = host.substr(0, colon);
+    }
+
+    MqttBroker broker;
+    publishTopic = prefix + publishTopic;
+    Aggregator aggregator(broker, publishTopic, minInterval, refresh);
+    if (!loadConfig(config, prefix, aggregator))
+        return 1;
+
+    broker.onMessage = [&](const std::string &topic, const Bytes &payload) {
+        aggregator.handle(topic, payload);
+    };
+
+    for (;;)
+    {
+        if (!broker.connect(host, port, "state-aggregator"))
+        {
+            fprintf(stderr, "unable to connect to %s:%d, trying again\n", host.c_str(), port);
+            sleep(5);
+            continue;
+        }
+        printf("connected to %s:%d, publishing to %s\n", host.c_str(), port, publishTopic.c_str());
+        aggregator.start();
+
+        while (broker.loop(100))
+            aggregator.tick(nowMs());
+
+        fprintf(stderr, "lost the broker, reconnecting\n");
+    }
+}
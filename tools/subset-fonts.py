@@ -0,0 +1,242 @@
+"""
+Build-time font subsetting for the display
+
+Runs before every PlatformIO build (extra_scripts in platformio.ini). It
+copies FreeSans12pt7b and FreeSans18pt7b out of the Adafruit GFX library
+with only the glyphs the dashboard can draw, and writes them to
+subset-fonts.h in the build directory under the same names, so nothing
+that uses them has to change. Only src/fonts.cpp includes it, so each font
+is in flash once and what this reports saving is what the image saves. SUBSET_FONTS is defined when it worked. If
+it didn't, the build goes ahead with the full fonts.
+
+What "can draw" means: every character in a string literal under src/,
+except for the ones SKIPPED_LINE rules out, plus EXTRA_CHARACTERS
+for what gets printed at runtime (numbers and the clock's AM/PM).
+Anything else is drawn as '?'.
+
+The glyphs that are kept are copied as they are, bit packed the way GFX
+packs them and the same size, so text lays out and draws exactly as it
+does with the full fonts.
+
+Can also be run by hand to see what it would do:
+
+    python3 tools/subset-fonts.py path/to/Adafruit_GFX/Fonts out/
+"""
+
+import glob
+import os
+import re
+import sys
+
+FONTS = ["FreeSans12pt7b", "FreeSans18pt7b"]
+
+# Printed at runtime, so they're not in any string literal
+EXTRA_CHARACTERS = "0123456789 .,:;-+%/()'!?AMP"
+
+FALLBACK = "?"
+
+# Literals on these lines never reach the screen: preprocessor lines, log
+# messages, things compared against, and what goes back out over MQTT
+SKIPPED_LINE = re.compile(r"^\s*#|\bl\.(debug|info|warning|error|verbose)\s*\(|\bstrn?cmp\s*\(|\bmqtt->")
+
+
+def string_literals(path):
+    """Every string literal in a C++ file, skipping comments."""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        source = f.read()
+
+    literals = []
+    i = 0
+    line_start = 0
+    while i < len(source):
+        c = source[i]
+        if c == "\n":
+            line_start = i + 1
+            i += 1
+        elif source.startswith("//", i):
+            i = source.find("\n", i)
+            if i < 0:
+                break
+        elif source.startswith("/*", i):
+            end = source.find("*/", i + 2)
+            i = len(source) if end < 0 else end + 2
+        elif c == "'":
+            i += 3 if source[i + 1] != "\\" else 4
+        elif c == '"':
+            i += 1
+            text = []
+            while i < len(source) and source[i] != '"':
+                if source[i] == "\\":
+                    text.append(unescape(source[i + 1]))
+                    i += 2
+                else:
+                    text.append(source[i])
+                    i += 1
+            i += 1
+
+            line_end = source.find("\n", line_start)
+            line = source[line_start : line_end if line_end >= 0 else len(source)]
+            if not SKIPPED_LINE.search(line):
+                literals.append("".join(text))
+        else:
+            i += 1
+
+    return literals
+
+
+def unescape(c):
+    return {"n": "\n", "t": "\t", "0": "\0"}.get(c, c)
+
+
+def wanted_characters(source_dir):
+    wanted = set(EXTRA_CHARACTERS) | {FALLBACK}
+    for path in sorted(glob.glob(os.path.join(source_dir, "*.cpp")) + glob.glob(os.path.join(source_dir, "*.h"))):
+        for literal in string_literals(path):
+            wanted.update(literal)
+    return wanted
+
+
+def parse_font(path, name):
+    """Pull the bitmap bytes, glyphs and range out of a GFX font header."""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        source = f.read()
+
+    bitmaps = re.search(r"%sBitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\};" % name, source, re.S)
+    glyphs = re.search(r"%sGlyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\};" % name, source, re.S)
+    font = re.search(r"GFXfont\s+%s\s*PROGMEM\s*=\s*\{(.*?)\};" % name, source, re.S)
+    if not (bitmaps and glyphs and font):
+        raise ValueError("%s doesn't look like a GFX font" % path)
+
+    data = [int(x, 16) for x in re.findall(r"0x[0-9A-Fa-f]+", bitmaps.group(1))]
+    table = [
+        tuple(int(n) for n in entry)
+        for entry in re.findall(r"\{\s*(-?\d+),\s*(-?\d+),\s*(-?\d+),\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)\s*\}", glyphs.group(1))
+    ]
+    numbers = re.findall(r"0x[0-9A-Fa-f]+|\b\d+\b", font.group(1).split(")", 2)[-1])
+    first, last, y_advance = (int(n, 0) for n in numbers[-3:])
+
+    if len(table) != last - first + 1:
+        raise ValueError("%s has %d glyphs for %d characters" % (path, len(table), last - first + 1))
+    return data, table, first, last, y_advance
+
+
+def subset_font(data, table, first, last, wanted):
+    """New bitmaps and glyph table, plus what was kept."""
+    bitmaps = []
+    glyphs = [None] * len(table)
+    kept = []
+
+    for index, (offset, width, height, advance, x_offset, y_offset) in enumerate(table):
+        c = chr(first + index)
+        if c not in wanted:
+            continue
+        kept.append(c)
+        new_offset = len(bitmaps)
+        bitmaps.extend(data[offset : offset + (width * height + 7) // 8])
+        glyphs[index] = (new_offset, width, height, advance, x_offset, y_offset)
+
+    # Everything we dropped draws as the fallback
+    fallback = glyphs[ord(FALLBACK) - first]
+    glyphs = [g if g is not None else fallback for g in glyphs]
+
+    if len(bitmaps) > 0xFFFF:
+        raise ValueError("subset bitmaps don't fit 16 bit offsets")
+    return bitmaps, glyphs, kept
+
+
+def render_font(name, bitmaps, glyphs, first, last, y_advance, kept, total):
+    lines = ["// %s: %d of %d glyphs" % (name, len(kept), total)]
+
+    lines.append("const uint8_t %sBitmaps[] PROGMEM = {" % name)
+    for i in range(0, len(bitmaps), 12):
+        lines.append("    " + ", ".join("0x%02X" % b for b in bitmaps[i : i + 12]) + ",")
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const GFXglyph %sGlyphs[] PROGMEM = {" % name)
+    for index, glyph in enumerate(glyphs):
+        lines.append("    {%5d, %3d, %3d, %3d, %4d, %4d}, // %r" % (glyph + (chr(first + index),)))
+    lines.append("};")
+    lines.append("")
+
+    lines.append(
+        "const GFXfont %s PROGMEM = {(uint8_t *)%sBitmaps, (GFXglyph *)%sGlyphs, 0x%02X, 0x%02X, %d};"
+        % (name, name, name, first, last, y_advance)
+    )
+    lines.append("")
+    return lines
+
+
+def generate(font_dir, source_dir, out_dir):
+    """Write subset-fonts.h, and return a line per font for the build log."""
+    wanted = wanted_characters(source_dir)
+    header = [
+        "// Generated by tools/subset-fonts.py before each build. Don't edit it,",
+        "// and don't commit it. Only src/fonts.cpp should include it.",
+        "",
+        "#pragma once",
+        "",
+        "#include <Adafruit_GFX.h>",
+        "",
+    ]
+    report = []
+    saved = 0
+
+    for name in FONTS:
+        data, table, first, last, y_advance = parse_font(os.path.join(font_dir, name + ".h"), name)
+        bitmaps, glyphs, kept = subset_font(data, table, first, last, wanted)
+        header.extend(render_font(name, bitmaps, glyphs, first, last, y_advance, kept, len(table)))
+
+        saved += len(data) - len(bitmaps)
+        report.append(
+            "%s: kept %d of %d glyphs, bitmaps %d -> %d bytes" % (name, len(kept), len(table), len(data), len(bitmaps))
+        )
+
+    report.append("font subsetting saved %d bytes of flash" % saved)
+
+    # Only touch it if it changed, so it doesn't set off a rebuild
+    text = "\n".join(header)
+    path = os.path.join(out_dir, "subset-fonts.h")
+    os.makedirs(out_dir, exist_ok=True)
+    if not os.path.exists(path) or open(path, encoding="utf-8").read() != text:
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(text)
+    return report
+
+
+def find_font_dir(libdeps_dir):
+    for path in glob.glob(os.path.join(libdeps_dir, "*", "Fonts", FONTS[0] + ".h")):
+        return os.path.dirname(path)
+    return None
+
+
+try:
+    Import("env")  # noqa: F821 (SCons provides it)
+except NameError:
+    env = None
+
+if env is not None:
+    import time
+
+    started = time.time()
+    font_dir = find_font_dir(os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV")))
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "fonts")
+
+    if font_dir is None:
+        print("subset-fonts: can't find the GFX fonts, building with the full ones")
+    else:
+        try:
+            for line in generate(font_dir, env.subst("$PROJECT_SRC_DIR"), out_dir):
+                print("subset-fonts: " + line)
+            print("subset-fonts: took %.0fms" % ((time.time() - started) * 1000))
+            env.Append(CPPPATH=[out_dir], CPPDEFINES=["SUBSET_FONTS"])
+        except (OSError, ValueError) as e:
+            print("subset-fonts: %s, building with the full fonts" % e)
+
+elif __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("usage: subset-fonts.py <GFX Fonts dir> <output dir>", file=sys.stderr)
+        sys.exit(2)
+    source = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+    for line in generate(sys.argv[1], source, sys.argv[2]):
+        print(line)